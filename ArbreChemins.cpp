@@ -0,0 +1,264 @@
+/**
+ * \file ArbreChemins.cpp
+ * \brief Implémentation de l'arbre des plus courts chemins et du cache des arbres.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "ArbreChemins.h"
+#include "DeltaStepping.h"
+#include "ReseauInterurbain.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace TP2
+{
+    namespace
+    {
+        const std::uint32_t SANS_PREDECESSEUR = 0xFFFFFFFFu;
+    }
+
+    /**
+    * \fn ArbreChemins::ArbreChemins(const GrapheCompact& graphe, size_t origine, bool dureeCout)
+    * \brief Dijkstra complet depuis origine (tas binaire, suppression paresseuse).  Les égalités sont brisées par le plus
+    * petit numéro de sommet et chaque distance est la somme des arcs dans l'ordre du chemin, comme dans dijkstraTas:
+    * chaque chemin extrait de l'arbre et son total sont ceux que donnerait rechercheCheminDijkstra.
+    * \param[in] graphe l'instantané du réseau
+    * \param[in] origine le sommet de départ
+    * \param[in] dureeCout le critère: la durée si true, le coût sinon
+    * \exception logic_error si origine n'est pas un sommet du graphe
+    */
+    ArbreChemins::ArbreChemins(const GrapheCompact& graphe, size_t origine, bool dureeCout)
+        : graphe(graphe), origine(origine), dureeCout(dureeCout),
+          distances(graphe.taille(), std::numeric_limits<float>::infinity()), predecesseurs(graphe.taille(), SANS_PREDECESSEUR) {
+        if (origine >= graphe.taille()) throw std::logic_error("ArbreChemins::ArbreChemins : origine invalide");
+
+        using Entree = std::pair<float, std::uint32_t>;
+        const std::greater<Entree> priorite;
+        std::vector<Entree> tas;
+        std::vector<bool> resolus(graphe.taille(), false);
+
+        distances[origine] = 0;
+        tas.emplace_back(0.f, static_cast<std::uint32_t>(origine));
+        while (!tas.empty()) {
+            std::pop_heap(tas.begin(), tas.end(), priorite);
+            auto courant = tas.back().second;
+            tas.pop_back();
+            if (resolus[courant]) continue;
+            resolus[courant] = true;
+
+            for (auto arc = graphe.debutArcs(courant); arc < graphe.finArcs(courant); ++arc) {
+                auto voisin = graphe.destination(arc);
+                if (resolus[voisin]) continue;
+                float distance = distances[courant] + graphe.poids(arc, dureeCout);
+                if (distance < distances[voisin]) {
+                    distances[voisin] = distance;
+                    predecesseurs[voisin] = courant;
+                    tas.emplace_back(distance, static_cast<std::uint32_t>(voisin));
+                    std::push_heap(tas.begin(), tas.end(), priorite);
+                }
+            }
+        }
+    }
+
+    /**
+    * \fn ArbreChemins::ArbreChemins(const GrapheCompact& graphe, size_t origine, bool dureeCout, unsigned nbFils)
+    * \brief Le même arbre calculé par delta-stepping, avec le delta de choisirDelta: les distances sont identiques à
+    * celles du Dijkstra complet, les prédécesseurs peuvent différer entre chemins de même total
+    * \param[in] graphe l'instantané du réseau
+    * \param[in] origine le sommet de départ
+    * \param[in] dureeCout le critère: la durée si true, le coût sinon
+    * \param[in] nbFils le nombre de fils d'exécution, 0 pour autant que de coeurs
+    * \exception logic_error si origine n'est pas un sommet du graphe
+    * \exception logic_error si une pondération du critère est négative
+    */
+    ArbreChemins::ArbreChemins(const GrapheCompact& graphe, size_t origine, bool dureeCout, unsigned nbFils)
+        : graphe(graphe), origine(origine), dureeCout(dureeCout) {
+        if (origine >= graphe.taille()) throw std::logic_error("ArbreChemins::ArbreChemins : origine invalide");
+
+        auto chemins = deltaStepping(graphe, origine, dureeCout, nbFils);
+        distances = std::move(chemins.distances);
+        predecesseurs = std::move(chemins.predecesseurs);
+    }
+
+    /**
+    * \fn ArbreChemins::ArbreChemins(const GrapheCompact& graphe, size_t origine, bool dureeCout, std::vector<float> distances, std::vector<std::uint32_t> predecesseurs)
+    * \brief Reprend les distances et les prédécesseurs d'un arbre calculé ailleurs, sur le même instantané
+    * \param[in] graphe l'instantané du réseau
+    * \param[in] origine le sommet de départ
+    * \param[in] dureeCout le critère: la durée si true, le coût sinon
+    * \param[in] distances la distance de chaque sommet, infinie s'il n'est pas atteint
+    * \param[in] predecesseurs le prédécesseur de chaque sommet, 0xFFFFFFFF pour aucun
+    * \exception logic_error si origine n'est pas un sommet du graphe
+    * \exception logic_error si distances ou predecesseurs n'a pas la taille du graphe
+    */
+    ArbreChemins::ArbreChemins(const GrapheCompact& graphe, size_t origine, bool dureeCout, std::vector<float> distances,
+                               std::vector<std::uint32_t> predecesseurs)
+        : graphe(graphe), origine(origine), dureeCout(dureeCout), distances(std::move(distances)), predecesseurs(std::move(predecesseurs)) {
+        if (origine >= graphe.taille()) throw std::logic_error("ArbreChemins::ArbreChemins : origine invalide");
+        if (this->distances.size() != graphe.taille() || this->predecesseurs.size() != graphe.taille())
+            throw std::logic_error("ArbreChemins::ArbreChemins : taille invalide");
+    }
+
+    /**
+    * \fn size_t ArbreChemins::predecesseur(size_t sommet) const
+    * \brief Donne le prédécesseur d'un sommet dans l'arbre
+    * \param[in] sommet le sommet
+    * \return size_t le prédécesseur, AUCUN pour l'origine et les sommets non atteints
+    */
+    size_t ArbreChemins::predecesseur(size_t sommet) const {
+        return predecesseurs[sommet] == SANS_PREDECESSEUR ? AUCUN : predecesseurs[sommet];
+    }
+
+    /**
+    * \fn std::vector<size_t> ArbreChemins::trajet(size_t sommet) const
+    * \brief Remonte les prédécesseurs de sommet jusqu'à l'origine
+    * \param[in] sommet la destination
+    * \return std::vector<size_t> les sommets de l'origine à sommet; {origine} si sommet est l'origine, vide s'il n'est pas atteint
+    */
+    std::vector<size_t> ArbreChemins::trajet(size_t sommet) const {
+        std::vector<size_t> sommets;
+        if (!atteint(sommet)) return sommets;
+        for (auto courant = sommet; courant != AUCUN; courant = predecesseur(courant)) sommets.push_back(courant);
+        std::reverse(sommets.begin(), sommets.end());
+        return sommets;
+    }
+
+    /**
+    * \fn Chemin ArbreChemins::chemin(const std::string& destination) const
+    * \brief Construit le chemin vers une ville à partir de l'arbre: même liste de villes, même booléen reussi et même
+    * total (celui du critère de l'arbre, l'autre restant à 0) que rechercheCheminDijkstra
+    * \param[in] destination le nom de la ville de destination
+    * \exception logic_error si destination est absente du réseau
+    * \return Chemin le chemin; reussi vaut false si destination n'est pas atteignable ou est l'origine
+    */
+    Chemin ArbreChemins::chemin(const std::string& destination) const {
+        auto cible = graphe.chercherSommet(destination);
+        if (cible == graphe.taille()) throw std::logic_error("ArbreChemins::chemin : le sommet destination est invalide");
+
+        Chemin cheminTrouve;
+        cheminTrouve.dureeTotale = 0;
+        cheminTrouve.coutTotal = 0;
+        cheminTrouve.reussi = cible != origine && atteint(cible);
+        if (!cheminTrouve.reussi) return cheminTrouve;
+
+        for (auto sommet: trajet(cible)) cheminTrouve.listeVilles.emplace_back(graphe.nom(sommet));
+        if (dureeCout) cheminTrouve.dureeTotale = distances[cible];
+        else cheminTrouve.coutTotal = distances[cible];
+        return cheminTrouve;
+    }
+
+    /**
+    * \fn CacheArbres::CacheArbres(size_t capacite)
+    * \brief Constructeur: un cache vide
+    * \param[in] capacite le nombre maximal d'arbres gardés
+    */
+    CacheArbres::CacheArbres(size_t capacite) : capacite(capacite) {
+    }
+
+    /**
+    * \fn CacheArbres::CacheArbres(const CacheArbres& autre)
+    * \brief Constructeur de copie: les arbres sont partagés avec autre
+    */
+    CacheArbres::CacheArbres(const CacheArbres& autre) {
+        std::lock_guard<std::mutex> garde(autre.verrou);
+        capacite = autre.capacite;
+        arbres = autre.arbres;
+    }
+
+    /**
+    * \fn CacheArbres& CacheArbres::operator=(const CacheArbres& autre)
+    * \brief Affectation: les arbres sont partagés avec autre
+    */
+    CacheArbres& CacheArbres::operator=(const CacheArbres& autre) {
+        if (this == &autre) return *this;
+        std::scoped_lock garde(verrou, autre.verrou);
+        capacite = autre.capacite;
+        arbres = autre.arbres;
+        return *this;
+    }
+
+    /**
+    * \fn std::shared_ptr<const ArbreChemins> CacheArbres::trouver(size_t origine, bool dureeCout)
+    * \brief Cherche l'arbre d'une origine et d'un critère; s'il est présent, il passe en tête (le plus récent)
+    * \param[in] origine le sommet d'origine
+    * \param[in] dureeCout le critère
+    * \return std::shared_ptr<const ArbreChemins> l'arbre, nullptr s'il n'est pas en cache
+    */
+    std::shared_ptr<const ArbreChemins> CacheArbres::trouver(size_t origine, bool dureeCout) {
+        std::lock_guard<std::mutex> garde(verrou);
+        auto it = std::find_if(arbres.begin(), arbres.end(), [&](const std::shared_ptr<const ArbreChemins>& arbre) {
+            return arbre->getOrigine() == origine && arbre->getDureeCout() == dureeCout;
+        });
+        if (it == arbres.end()) return nullptr;
+        arbres.splice(arbres.begin(), arbres, it);
+        return arbres.front();
+    }
+
+    /**
+    * \fn void CacheArbres::ajouter(std::shared_ptr<const ArbreChemins> arbre)
+    * \brief Ajoute un arbre en tête; un arbre de même origine et de même critère est remplacé
+    * \param[in] arbre l'arbre
+    */
+    void CacheArbres::ajouter(std::shared_ptr<const ArbreChemins> arbre) {
+        std::lock_guard<std::mutex> garde(verrou);
+        arbres.remove_if([&](const std::shared_ptr<const ArbreChemins>& autre) {
+            return autre->getOrigine() == arbre->getOrigine() && autre->getDureeCout() == arbre->getDureeCout();
+        });
+        arbres.push_front(std::move(arbre));
+        evincer();
+    }
+
+    /**
+    * \fn void CacheArbres::vider()
+    * \brief Oublie tous les arbres
+    */
+    void CacheArbres::vider() {
+        std::lock_guard<std::mutex> garde(verrou);
+        arbres.clear();
+    }
+
+    /**
+    * \fn void CacheArbres::dimensionner(size_t capacite)
+    * \brief Change la capacité du cache
+    * \param[in] capacite le nombre maximal d'arbres gardés
+    */
+    void CacheArbres::dimensionner(size_t capacite) {
+        std::lock_guard<std::mutex> garde(verrou);
+        this->capacite = capacite;
+        evincer();
+    }
+
+    /**
+    * \fn size_t CacheArbres::getCapacite() const
+    * \return size_t le nombre maximal d'arbres gardés
+    */
+    size_t CacheArbres::getCapacite() const {
+        std::lock_guard<std::mutex> garde(verrou);
+        return capacite;
+    }
+
+    /**
+    * \fn size_t CacheArbres::taille() const
+    * \return size_t le nombre d'arbres en cache
+    */
+    size_t CacheArbres::taille() const {
+        std::lock_guard<std::mutex> garde(verrou);
+        return arbres.size();
+    }
+
+    /**
+    * \fn void CacheArbres::evincer()
+    * \brief Retire les arbres les moins récents au-delà de la capacité (verrou déjà pris)
+    */
+    void CacheArbres::evincer() {
+        while (arbres.size() > capacite) arbres.pop_back();
+    }
+
+}//Fin du namespace
@@ -0,0 +1,127 @@
+/**
+ * \file ArbreChemins.h
+ * \brief Arbre des plus courts chemins depuis une origine, et cache des arbres récents.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "GrapheCompact.h"
+
+#ifndef _ARBRECHEMINS__H
+#define _ARBRECHEMINS__H
+
+namespace TP2
+{
+
+struct Chemin;
+
+/**
+ * \class ArbreChemins
+ * \brief Les plus courts chemins d'une origine vers toutes les villes, pour un critère: la distance et le prédécesseur
+ *  de chaque sommet.  Le chemin vers une destination se remonte par les prédécesseurs, sans nouvelle recherche.
+ *
+ *  L'arbre garde une copie (partagée, O(1)) de l'instantané sur lequel il a été calculé, pour nommer les villes: il
+ *  reste valide même si le réseau change ensuite.  Les chemins sont ceux du moteur Tas de ReseauInterurbain.
+ */
+class ArbreChemins
+{
+public:
+
+	static constexpr size_t AUCUN = std::numeric_limits<size_t>::max();
+
+	// Calcule l'arbre des plus courts chemins depuis origine (Dijkstra complet)
+	// Exception logic_error si origine n'est pas un sommet du graphe
+	ArbreChemins(const GrapheCompact& graphe, size_t origine, bool dureeCout);
+
+	// Calcule l'arbre par delta-stepping sur nbFils fils d'exécution (0: autant que de coeurs), voir deltaStepping.
+	// Mêmes distances, bit pour bit; les prédécesseurs peuvent différer en cas d'égalité.
+	// Exception logic_error si origine n'est pas un sommet du graphe, ou si une pondération du critère est négative
+	ArbreChemins(const GrapheCompact& graphe, size_t origine, bool dureeCout, unsigned nbFils);
+
+	// Reprend un arbre déjà calculé, par exemple tenu à jour par ArbresDynamiques (0xFFFFFFFF: aucun prédécesseur)
+	// Exception logic_error si origine n'est pas un sommet du graphe, ou si les tableaux n'ont pas la taille du graphe
+	ArbreChemins(const GrapheCompact& graphe, size_t origine, bool dureeCout, std::vector<float> distances,
+	             std::vector<std::uint32_t> predecesseurs);
+
+	// Retourne l'origine, le critère (true: durée, false: coût) et le nombre de sommets
+	size_t getOrigine() const { return origine; }
+	bool getDureeCout() const { return dureeCout; }
+	size_t taille() const { return distances.size(); }
+
+	// Retourne true si sommet est atteignable depuis l'origine
+	bool atteint(size_t sommet) const { return distances[sommet] != std::numeric_limits<float>::infinity(); }
+
+	// Retourne la pondération du plus court chemin de l'origine à sommet, infinie si sommet n'est pas atteignable
+	float distance(size_t sommet) const { return distances[sommet]; }
+
+	// Retourne le prédécesseur de sommet sur son plus court chemin, AUCUN pour l'origine et les sommets non atteints
+	size_t predecesseur(size_t sommet) const;
+
+	// Retourne les sommets du plus court chemin de l'origine à sommet, origine comprise; vide si sommet n'est pas atteint
+	std::vector<size_t> trajet(size_t sommet) const;
+
+	// Retourne le chemin vers une ville, comme ReseauInterurbain::rechercheCheminDijkstra avec le critère de l'arbre
+	// Exception logic_error si destination est absente du réseau
+	Chemin chemin(const std::string& destination) const;
+
+private:
+
+	GrapheCompact graphe;
+	size_t origine;
+	bool dureeCout;
+	std::vector<float> distances;
+	std::vector<std::uint32_t> predecesseurs;	// 0xFFFFFFFF: aucun
+};
+
+/**
+ * \class CacheArbres
+ * \brief Les arbres de chemins les plus récemment demandés, jusqu'à une capacité donnée, retrouvés par (origine,
+ *  critère).  Le moins récemment utilisé est évincé.  Les arbres sont partagés: un arbre évincé reste valide pour qui le
+ *  tient encore.  Les opérations sont protégées par un verrou, pour les recherches concurrentes.
+ */
+class CacheArbres
+{
+public:
+
+	explicit CacheArbres(size_t capacite = 8);
+	CacheArbres(const CacheArbres& autre);
+	CacheArbres& operator=(const CacheArbres& autre);
+
+	// Retourne l'arbre de (origine, dureeCout) et le marque le plus récent, nullptr s'il n'est pas en cache
+	std::shared_ptr<const ArbreChemins> trouver(size_t origine, bool dureeCout);
+
+	// Ajoute un arbre comme le plus récent (remplace celui de même clé), en évinçant au besoin le moins récent
+	void ajouter(std::shared_ptr<const ArbreChemins> arbre);
+
+	// Vide le cache
+	void vider();
+
+	// Change la capacité (0: aucun arbre n'est gardé), en évinçant au besoin les moins récents
+	void dimensionner(size_t capacite);
+
+	// Retourne la capacité et le nombre d'arbres en cache
+	size_t getCapacite() const;
+	size_t taille() const;
+
+private:
+	mutable std::mutex verrou;
+	size_t capacite;
+	std::list<std::shared_ptr<const ArbreChemins> > arbres;	// du plus récent au moins récent
+
+	void evincer();
+};
+
+}//Fin du namespace
+
+#endif
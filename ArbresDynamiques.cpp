@@ -0,0 +1,271 @@
+/**
+ * \file ArbresDynamiques.cpp
+ * \brief Implémentation des arbres de plus courts chemins dynamiques.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "ArbresDynamiques.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace TP2
+{
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+    }
+
+    /**
+    * \fn ArbresDynamiques::ArbresDynamiques()
+    * \brief Constructeur par défaut: aucun sommet, aucun arbre
+    */
+    ArbresDynamiques::ArbresDynamiques() : sommetsRepares(0), generation(0) {
+    }
+
+    /**
+    * \fn ArbresDynamiques::ArbresDynamiques(const GrapheCompact& graphe)
+    * \brief Constructeur: copie les arcs sortants et entrants du graphe avec leurs pondérations
+    * \param[in] graphe l'instantané du graphe
+    */
+    ArbresDynamiques::ArbresDynamiques(const GrapheCompact& graphe)
+        : sortants(graphe.taille()), entrants(graphe.taille()), sommetsRepares(0), marques(graphe.taille(), 0), generation(0) {
+        for (size_t sommet = 0; sommet < graphe.taille(); ++sommet) {
+            sortants[sommet].reserve(graphe.finArcs(sommet) - graphe.debutArcs(sommet));
+            entrants[sommet].reserve(graphe.finArcsEntrants(sommet) - graphe.debutArcsEntrants(sommet));
+            for (auto arc = graphe.debutArcs(sommet); arc < graphe.finArcs(sommet); ++arc)
+                sortants[sommet].push_back({static_cast<std::uint32_t>(graphe.destination(arc)), graphe.poids(arc, true), graphe.poids(arc, false)});
+            for (auto arc = graphe.debutArcsEntrants(sommet); arc < graphe.finArcsEntrants(sommet); ++arc)
+                entrants[sommet].push_back({static_cast<std::uint32_t>(graphe.source(arc)), graphe.poidsEntrant(arc, true), graphe.poidsEntrant(arc, false)});
+        }
+    }
+
+    /**
+    * \fn size_t ArbresDynamiques::suivre(size_t origine, bool dureeCout)
+    * \brief Suit l'arbre de (origine, dureeCout).  Un nouvel arbre est calculé par un Dijkstra complet depuis origine.
+    * \param[in] origine le sommet de départ
+    * \param[in] dureeCout le critère: la durée si true, le coût sinon
+    * \exception logic_error si origine n'est pas un sommet
+    * \return size_t le numéro de l'arbre
+    */
+    size_t ArbresDynamiques::suivre(size_t origine, bool dureeCout) {
+        if (origine >= taille()) throw std::logic_error("ArbresDynamiques::suivre : l'origine est invalide");
+        auto numero = trouver(origine, dureeCout);
+        if (numero != AUCUN) return numero;
+
+        Arbre arbre;
+        arbre.origine = static_cast<std::uint32_t>(origine);
+        arbre.dureeCout = dureeCout;
+        arbre.distances.assign(taille(), INFINI);
+        arbre.predecesseurs.assign(taille(), SANS_PREDECESSEUR);
+        arbre.distances[origine] = 0;
+        tas.assign(1, {0.f, arbre.origine});
+        propager(arbre);
+        arbres.push_back(std::move(arbre));
+        return arbres.size() - 1;
+    }
+
+    /**
+    * \fn size_t ArbresDynamiques::trouver(size_t origine, bool dureeCout) const
+    * \brief Cherche l'arbre de (origine, dureeCout) parmi les arbres suivis
+    * \param[in] origine le sommet de départ
+    * \param[in] dureeCout le critère
+    * \return size_t le numéro de l'arbre, AUCUN s'il n'est pas suivi
+    */
+    size_t ArbresDynamiques::trouver(size_t origine, bool dureeCout) const {
+        for (size_t i = 0; i < arbres.size(); ++i)
+            if (arbres[i].origine == origine && arbres[i].dureeCout == dureeCout) return i;
+        return AUCUN;
+    }
+
+    /**
+    * \fn void ArbresDynamiques::modifierPonderations(size_t source, size_t destination, float duree, float cout)
+    * \brief Change les pondérations d'un arc, puis répare chaque arbre selon que la pondération de son critère baisse
+    * ou monte (un arbre dont la pondération ne change pas n'est pas touché)
+    * \param[in] source le sommet source de l'arc
+    * \param[in] destination le sommet destination de l'arc
+    * \param[in] duree la nouvelle durée
+    * \param[in] cout le nouveau coût
+    * \exception logic_error si source ou destination n'est pas un sommet
+    * \exception logic_error si l'arc n'existe pas
+    */
+    void ArbresDynamiques::modifierPonderations(size_t source, size_t destination, float duree, float cout) {
+        if (source >= taille()) throw std::logic_error("ArbresDynamiques::modifierPonderations : la source est invalide");
+        if (destination >= taille()) throw std::logic_error("ArbresDynamiques::modifierPonderations : la destination est invalide");
+        auto sortant = chercher(sortants[source], destination);
+        if (!sortant) throw std::logic_error("ArbresDynamiques::modifierPonderations : l'arc n'existe pas");
+        auto entrant = chercher(entrants[destination], source);
+
+        const ArcPondere ancien = *sortant;
+        sortant->duree = entrant->duree = duree;
+        sortant->cout = entrant->cout = cout;
+        auto u = static_cast<std::uint32_t>(source), v = static_cast<std::uint32_t>(destination);
+        for (auto& arbre: arbres) {
+            float avant = ancien.poids(arbre.dureeCout), apres = sortant->poids(arbre.dureeCout);
+            if (apres < avant) abaisser(arbre, u, v, apres);
+            else if (apres > avant) relever(arbre, u, v);
+        }
+    }
+
+    /**
+    * \fn void ArbresDynamiques::ajouterArc(size_t source, size_t destination, float duree, float cout)
+    * \brief Ajoute un arc, qui ne peut que raccourcir des chemins: une baisse depuis une pondération infinie
+    * \param[in] source le sommet source de l'arc
+    * \param[in] destination le sommet destination de l'arc
+    * \param[in] duree la durée de l'arc
+    * \param[in] cout le coût de l'arc
+    * \exception logic_error si source ou destination n'est pas un sommet
+    * \exception logic_error si l'arc existe déjà
+    */
+    void ArbresDynamiques::ajouterArc(size_t source, size_t destination, float duree, float cout) {
+        if (source >= taille()) throw std::logic_error("ArbresDynamiques::ajouterArc : la source est invalide");
+        if (destination >= taille()) throw std::logic_error("ArbresDynamiques::ajouterArc : la destination est invalide");
+        if (chercher(sortants[source], destination)) throw std::logic_error("ArbresDynamiques::ajouterArc : l'arc existe déjà");
+
+        auto u = static_cast<std::uint32_t>(source), v = static_cast<std::uint32_t>(destination);
+        sortants[source].push_back({v, duree, cout});
+        entrants[destination].push_back({u, duree, cout});
+        for (auto& arbre: arbres) abaisser(arbre, u, v, sortants[source].back().poids(arbre.dureeCout));
+    }
+
+    /**
+    * \fn void ArbresDynamiques::enleverArc(size_t source, size_t destination)
+    * \brief Retire un arc, qui ne peut qu'allonger des chemins: une hausse vers une pondération infinie
+    * \param[in] source le sommet source de l'arc
+    * \param[in] destination le sommet destination de l'arc
+    * \exception logic_error si source ou destination n'est pas un sommet
+    * \exception logic_error si l'arc n'existe pas
+    */
+    void ArbresDynamiques::enleverArc(size_t source, size_t destination) {
+        if (source >= taille()) throw std::logic_error("ArbresDynamiques::enleverArc : la source est invalide");
+        if (destination >= taille()) throw std::logic_error("ArbresDynamiques::enleverArc : la destination est invalide");
+        auto sortant = chercher(sortants[source], destination);
+        if (!sortant) throw std::logic_error("ArbresDynamiques::enleverArc : l'arc n'existe pas");
+
+        *sortant = sortants[source].back();
+        sortants[source].pop_back();
+        auto entrant = chercher(entrants[destination], source);
+        *entrant = entrants[destination].back();
+        entrants[destination].pop_back();
+        for (auto& arbre: arbres) relever(arbre, static_cast<std::uint32_t>(source), static_cast<std::uint32_t>(destination));
+    }
+
+    /**
+    * \fn std::uint32_t ArbresDynamiques::nouvelleGeneration()
+    * \brief Commence un nouveau marquage: les marques des réparations précédentes deviennent caduques
+    * \return std::uint32_t l'estampille du marquage
+    */
+    std::uint32_t ArbresDynamiques::nouvelleGeneration() {
+        if (++generation == 0) {
+            std::fill(marques.begin(), marques.end(), 0);
+            generation = 1;
+        }
+        return generation;
+    }
+
+    /**
+    * \fn ArbresDynamiques::ArcPondere* ArbresDynamiques::chercher(std::vector<ArcPondere>& arcs, size_t voisin)
+    * \brief Cherche dans une liste d'arcs celui dont l'autre extrémité est voisin
+    * \return ArcPondere* l'arc, nullptr s'il n'y est pas
+    */
+    ArbresDynamiques::ArcPondere* ArbresDynamiques::chercher(std::vector<ArcPondere>& arcs, size_t voisin) {
+        for (auto& arc: arcs)
+            if (arc.voisin == voisin) return &arc;
+        return nullptr;
+    }
+
+    /**
+    * \fn size_t ArbresDynamiques::propager(Arbre& arbre)
+    * \brief Dijkstra depuis les sommets du tas (suppression paresseuse): chaque sommet sorti à sa distance courante
+    * relâche ses arcs, et un voisin n'est abaissé que si sa distance baisse strictement.  Sur un arbre complet, c'est le
+    * Dijkstra de ArbreChemins.
+    * \return size_t le nombre de sommets sortis du tas
+    */
+    size_t ArbresDynamiques::propager(Arbre& arbre) {
+        size_t resolus = 0;
+        const std::greater<std::pair<float, std::uint32_t> > priorite;
+        std::make_heap(tas.begin(), tas.end(), priorite);
+        while (!tas.empty()) {
+            std::pop_heap(tas.begin(), tas.end(), priorite);
+            auto entree = tas.back();
+            tas.pop_back();
+            auto courant = entree.second;
+            if (entree.first > arbre.distances[courant]) continue;
+            ++resolus;
+
+            for (const auto& arc: sortants[courant]) {
+                float distance = arbre.distances[courant] + arc.poids(arbre.dureeCout);
+                if (distance < arbre.distances[arc.voisin]) {
+                    arbre.distances[arc.voisin] = distance;
+                    arbre.predecesseurs[arc.voisin] = courant;
+                    tas.emplace_back(distance, arc.voisin);
+                    std::push_heap(tas.begin(), tas.end(), priorite);
+                }
+            }
+        }
+        return resolus;
+    }
+
+    /**
+    * \fn void ArbresDynamiques::abaisser(Arbre& arbre, std::uint32_t source, std::uint32_t destination, float poids)
+    * \brief Répare un arbre après la baisse de l'arc source -> destination à poids: destination est abaissée si l'arc
+    * la rapproche, puis la baisse est propagée
+    */
+    void ArbresDynamiques::abaisser(Arbre& arbre, std::uint32_t source, std::uint32_t destination, float poids) {
+        float distance = arbre.distances[source] + poids;
+        if (!(distance < arbre.distances[destination])) return;
+        arbre.distances[destination] = distance;
+        arbre.predecesseurs[destination] = source;
+        tas.assign(1, {distance, destination});
+        sommetsRepares += propager(arbre);
+    }
+
+    /**
+    * \fn void ArbresDynamiques::relever(Arbre& arbre, std::uint32_t source, std::uint32_t destination)
+    * \brief Répare un arbre après la hausse (ou le retrait) de l'arc source -> destination, déjà appliquée aux listes.
+    * Le sous-arbre de destination est trouvé par un parcours de ses arcs sortants qui ne garde que les voisins dont il
+    * est le prédécesseur; ses distances sont oubliées, puis chacun de ses sommets prend la meilleure distance offerte
+    * par ses arcs entrants venant d'ailleurs, et Dijkstra repart de tous ceux qui en ont une.
+    */
+    void ArbresDynamiques::relever(Arbre& arbre, std::uint32_t source, std::uint32_t destination) {
+        if (arbre.predecesseurs[destination] != source) return;
+
+        auto gen = nouvelleGeneration();
+        touches.assign(1, destination);
+        marques[destination] = gen;
+        for (size_t i = 0; i < touches.size(); ++i) {
+            auto courant = touches[i];
+            for (const auto& arc: sortants[courant]) {
+                if (marques[arc.voisin] == gen || arbre.predecesseurs[arc.voisin] != courant) continue;
+                marques[arc.voisin] = gen;
+                touches.push_back(arc.voisin);
+            }
+        }
+        for (auto sommet: touches) {
+            arbre.distances[sommet] = INFINI;
+            arbre.predecesseurs[sommet] = SANS_PREDECESSEUR;
+        }
+
+        tas.clear();
+        for (auto sommet: touches) {
+            for (const auto& arc: entrants[sommet]) {
+                if (marques[arc.voisin] == gen) continue;
+                float distance = arbre.distances[arc.voisin] + arc.poids(arbre.dureeCout);
+                if (distance < arbre.distances[sommet]) {
+                    arbre.distances[sommet] = distance;
+                    arbre.predecesseurs[sommet] = arc.voisin;
+                }
+            }
+            if (arbre.distances[sommet] != INFINI) tas.emplace_back(arbre.distances[sommet], sommet);
+        }
+        propager(arbre);
+        sommetsRepares += touches.size();
+    }
+
+}//Fin du namespace
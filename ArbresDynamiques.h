@@ -0,0 +1,142 @@
+/**
+ * \file ArbresDynamiques.h
+ * \brief Arbres de plus courts chemins tenus à jour sous la modification des pondérations et des arcs.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "GrapheCompact.h"
+
+#ifndef _ARBRESDYNAMIQUES__H
+#define _ARBRESDYNAMIQUES__H
+
+namespace TP2
+{
+
+/**
+ * \class ArbresDynamiques
+ * \brief Les arbres de plus courts chemins de quelques origines (chacune pour un critère), sur une copie des arcs et
+ *  de leurs pondérations, réparés à la Ramalingam-Reps quand un arc change au lieu d'être recalculés.
+ *
+ *  Baisse de la pondération de u -> v (ou ajout de l'arc): si distance(u) + poids < distance(v), v est abaissé, puis
+ *  Dijkstra repart de v seul; seuls les sommets dont la distance baisse sont visités.
+ *
+ *  Hausse de la pondération de u -> v (ou retrait de l'arc): rien ne change si u n'est pas le prédécesseur de v dans
+ *  l'arbre, aucun chemin de l'arbre n'empruntant l'arc.  Sinon, les sommets touchés sont exactement le sous-arbre de
+ *  v.  Leurs distances sont oubliées, chacun reçoit la meilleure distance offerte par ses arcs entrants venant de
+ *  l'extérieur du sous-arbre, puis Dijkstra est relancé depuis ces sommets; les distances hors du sous-arbre sont
+ *  inchangées et servent de bornes.
+ *
+ *  Les distances obtenues sont celles d'un Dijkstra complet (voir ArbreChemins) sur le graphe modifié, bit pour bit:
+ *  chacune reste la somme des arcs dans l'ordre du chemin.  Les prédécesseurs peuvent différer en cas d'égalité.  Les
+ *  pondérations doivent être positives ou nulles, comme pour Dijkstra.
+ */
+class ArbresDynamiques
+{
+public:
+
+	static constexpr size_t AUCUN = std::numeric_limits<size_t>::max();
+
+	// Construit une structure vide (taille() == 0)
+	ArbresDynamiques();
+
+	// Copie les arcs du graphe et leurs deux pondérations, sans suivre aucun arbre. O(V + E).
+	explicit ArbresDynamiques(const GrapheCompact& graphe);
+
+	// Retourne le nombre de sommets et le nombre d'arbres suivis
+	size_t taille() const { return sortants.size(); }
+	size_t nombre() const { return arbres.size(); }
+
+	// Suit l'arbre de (origine, dureeCout), calculé par un Dijkstra complet s'il n'est pas déjà suivi.
+	// Retourne le numéro de l'arbre, stable tant que la structure existe.
+	// Exception logic_error si origine supérieur à taille()
+	size_t suivre(size_t origine, bool dureeCout);
+
+	// Retourne le numéro de l'arbre de (origine, dureeCout), AUCUN s'il n'est pas suivi
+	size_t trouver(size_t origine, bool dureeCout) const;
+
+	// Retourne l'origine et le critère d'un arbre (arbre < nombre())
+	size_t getOrigine(size_t arbre) const { return arbres[arbre].origine; }
+	bool getDureeCout(size_t arbre) const { return arbres[arbre].dureeCout; }
+
+	// Retourne les distances (infinies pour les sommets non atteints) et les prédécesseurs (0xFFFFFFFF: aucun) d'un arbre
+	const std::vector<float>& distances(size_t arbre) const { return arbres[arbre].distances; }
+	const std::vector<std::uint32_t>& predecesseurs(size_t arbre) const { return arbres[arbre].predecesseurs; }
+
+	// Change les pondérations de l'arc source -> destination et répare chaque arbre suivi
+	// Exception logic_error si source ou destination supérieur à taille()
+	// Exception logic_error si l'arc n'existe pas
+	void modifierPonderations(size_t source, size_t destination, float duree, float cout);
+
+	// Ajoute l'arc source -> destination et répare chaque arbre suivi
+	// Exception logic_error si source ou destination supérieur à taille()
+	// Exception logic_error si l'arc existe déjà
+	void ajouterArc(size_t source, size_t destination, float duree, float cout);
+
+	// Retire l'arc source -> destination et répare chaque arbre suivi
+	// Exception logic_error si source ou destination supérieur à taille()
+	// Exception logic_error si l'arc n'existe pas
+	void enleverArc(size_t source, size_t destination);
+
+	// Retourne le nombre cumulé de sommets dont la distance a été revue par les réparations (sous-arbres touchés et
+	// sommets abaissés), tous arbres confondus
+	size_t getSommetsRepares() const { return sommetsRepares; }
+
+private:
+
+	static constexpr std::uint32_t SANS_PREDECESSEUR = 0xFFFFFFFFu;
+
+	/**
+	 * \struct ArcPondere
+	 * \brief Un arc copié: son autre extrémité (destination des arcs sortants, source des arcs entrants) et ses
+	 *  pondérations
+	 */
+	struct ArcPondere
+	{
+		std::uint32_t voisin;
+		float duree;
+		float cout;
+
+		float poids(bool dureeCout) const { return dureeCout ? duree : cout; }
+	};
+
+	/**
+	 * \struct Arbre
+	 * \brief Un arbre suivi
+	 */
+	struct Arbre
+	{
+		std::uint32_t origine;
+		bool dureeCout;
+		std::vector<float> distances;
+		std::vector<std::uint32_t> predecesseurs;
+	};
+
+	std::vector<std::vector<ArcPondere> > sortants, entrants;	// par sommet
+	std::vector<Arbre> arbres;
+	size_t sommetsRepares;
+
+	// Tableaux de travail, remis à zéro par estampilles
+	std::vector<std::uint32_t> marques;		// par sommet: dans le sous-arbre touché
+	std::uint32_t generation;
+	std::vector<std::uint32_t> touches;
+	std::vector<std::pair<float, std::uint32_t> > tas;
+
+	std::uint32_t nouvelleGeneration();
+	ArcPondere* chercher(std::vector<ArcPondere>& arcs, size_t voisin);
+	size_t propager(Arbre& arbre);
+	void abaisser(Arbre& arbre, std::uint32_t source, std::uint32_t destination, float poids);
+	void relever(Arbre& arbre, std::uint32_t source, std::uint32_t destination);
+};
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,179 @@
+/**
+ * \file BancCompact.cpp
+ * \brief Banc d'essai: parcours de Dijkstra sur les listes d'adjacence de Graphe (par copies et par les vues de
+ * Graphe::voisins) et sur l'instantané CSR (GrapheCompact).
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Compilation (depuis la racine du projet):
+ *      g++ -std=c++17 -O2 -I. Banc/BancCompact.cpp Graphe.cpp GrapheCompact.cpp DictionnaireNoms.cpp -o bancCompact
+ *  Utilisation:
+ *      ./bancCompact [nbSommets] [degreMoyen] [nbRequetes]
+ *
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "Graphe.h"
+
+using namespace std;
+using namespace TP2;
+
+namespace
+{
+    using Horloge = chrono::steady_clock;
+    using Entree = pair<float, size_t>;
+
+    /**
+    * \fn Graphe genererGraphe(size_t nbSommets, size_t degreMoyen, unsigned graine)
+    * \brief Génère un graphe aléatoire: chaque sommet reçoit degreMoyen arcs vers des sommets tirés au hasard
+    */
+    Graphe genererGraphe(size_t nbSommets, size_t degreMoyen, unsigned graine)
+    {
+        Graphe g(nbSommets);
+        mt19937 alea(graine);
+        uniform_int_distribution<size_t> sommet(0, nbSommets - 1);
+        uniform_real_distribution<float> poids(0.1f, 5.0f);
+
+        for (size_t s = 0; s < nbSommets; ++s)
+            for (size_t k = 0; k < degreMoyen; ++k) {
+                auto d = sommet(alea);
+                if (d != s && !g.arcExiste(s, d)) g.ajouterArc(s, d, poids(alea), 10 * poids(alea));
+            }
+        return g;
+    }
+
+    /**
+    * \fn vector<float> dijkstraListes(const Graphe& g, size_t source)
+    * \brief Dijkstra sur les listes d'adjacence, par l'interface publique de Graphe
+    */
+    vector<float> dijkstraListes(const Graphe& g, size_t source)
+    {
+        vector<float> dist(g.taille(), numeric_limits<float>::infinity());
+        priority_queue<Entree, vector<Entree>, greater<Entree> > tas;
+        dist[source] = 0;
+        tas.emplace(0.f, source);
+
+        while (!tas.empty()) {
+            auto [d, courant] = tas.top();
+            tas.pop();
+            if (d > dist[courant]) continue;
+            for (auto voisin: g.listerSommetsAdjacents(courant)) {
+                auto temp = d + g.getPonderationsArc(courant, voisin).duree;
+                if (temp < dist[voisin]) {
+                    dist[voisin] = temp;
+                    tas.emplace(temp, voisin);
+                }
+            }
+        }
+        return dist;
+    }
+
+    /**
+    * \fn vector<float> dijkstraVues(const Graphe& g, size_t source)
+    * \brief Dijkstra sur les listes d'adjacence, par les vues sans copie de Graphe::voisins
+    */
+    vector<float> dijkstraVues(const Graphe& g, size_t source)
+    {
+        vector<float> dist(g.taille(), numeric_limits<float>::infinity());
+        priority_queue<Entree, vector<Entree>, greater<Entree> > tas;
+        dist[source] = 0;
+        tas.emplace(0.f, source);
+
+        while (!tas.empty()) {
+            auto [d, courant] = tas.top();
+            tas.pop();
+            if (d > dist[courant]) continue;
+            for (const auto& arc: g.voisins(courant)) {
+                auto temp = d + arc.poids.duree;
+                if (temp < dist[arc.destination]) {
+                    dist[arc.destination] = temp;
+                    tas.emplace(temp, arc.destination);
+                }
+            }
+        }
+        return dist;
+    }
+
+    /**
+    * \fn vector<float> dijkstraCompact(const GrapheCompact& g, size_t source)
+    * \brief Dijkstra sur l'instantané CSR
+    */
+    vector<float> dijkstraCompact(const GrapheCompact& g, size_t source)
+    {
+        vector<float> dist(g.taille(), numeric_limits<float>::infinity());
+        priority_queue<Entree, vector<Entree>, greater<Entree> > tas;
+        dist[source] = 0;
+        tas.emplace(0.f, source);
+
+        while (!tas.empty()) {
+            auto [d, courant] = tas.top();
+            tas.pop();
+            if (d > dist[courant]) continue;
+            for (auto arc = g.debutArcs(courant); arc < g.finArcs(courant); ++arc) {
+                auto voisin = g.destination(arc);
+                auto temp = d + g.duree(arc);
+                if (temp < dist[voisin]) {
+                    dist[voisin] = temp;
+                    tas.emplace(temp, voisin);
+                }
+            }
+        }
+        return dist;
+    }
+
+    /**
+    * \fn double chronometrer(size_t nbRequetes, size_t nbSommets, const function<vector<float>(size_t)>& recherche, double& somme)
+    * \brief Exécute nbRequetes recherches depuis des sources pseudo-aléatoires et retourne la durée totale en secondes
+    */
+    double chronometrer(size_t nbRequetes, size_t nbSommets, const function<vector<float>(size_t)>& recherche, double& somme)
+    {
+        mt19937 alea(42);
+        uniform_int_distribution<size_t> sommet(0, nbSommets - 1);
+        somme = 0;
+
+        auto debut = Horloge::now();
+        for (size_t i = 0; i < nbRequetes; ++i)
+            for (auto d: recherche(sommet(alea)))
+                if (d != numeric_limits<float>::infinity()) somme += d;
+        return chrono::duration<double>(Horloge::now() - debut).count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t nbSommets = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+    size_t degreMoyen = argc > 2 ? strtoul(argv[2], nullptr, 10) : 4;
+    size_t nbRequetes = argc > 3 ? strtoul(argv[3], nullptr, 10) : 20;
+
+    cout << "Generation: " << nbSommets << " sommets, degre moyen " << degreMoyen << endl;
+    Graphe g = genererGraphe(nbSommets, degreMoyen, 1);
+
+    auto debut = Horloge::now();
+    GrapheCompact compact = g.figer();
+    cout << "figer(): " << chrono::duration<double, milli>(Horloge::now() - debut).count() << " ms, "
+         << compact.getNombreArcs() << " arcs" << endl;
+
+    double sommeListes, sommeVues, sommeCompact;
+    double tListes = chronometrer(nbRequetes, nbSommets, [&g](size_t s) { return dijkstraListes(g, s); }, sommeListes);
+    double tVues = chronometrer(nbRequetes, nbSommets, [&g](size_t s) { return dijkstraVues(g, s); }, sommeVues);
+    double tCompact = chronometrer(nbRequetes, nbSommets, [&compact](size_t s) { return dijkstraCompact(compact, s); }, sommeCompact);
+
+    cout << "Listes (copies):    " << 1000 * tListes / nbRequetes << " ms/requete" << endl;
+    cout << "Listes (voisins()): " << 1000 * tVues / nbRequetes << " ms/requete" << endl;
+    cout << "CSR:                " << 1000 * tCompact / nbRequetes << " ms/requete" << endl;
+    cout << "Acceleration CSR:   " << tVues / tCompact << "x (vs voisins()), " << tListes / tCompact << "x (vs copies)" << endl;
+    if (sommeListes != sommeCompact || sommeVues != sommeCompact) {
+        cerr << "ERREUR: les deux dispositions ne donnent pas les memes distances" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,644 @@
+/**
+ * \file BancReseau.cpp
+ * \brief Banc d'essai de ReseauInterurbain sur des réseaux synthétiques: chargement du fichier texte, recherches de
+ * Dijkstra entre paires aléatoires (une à une et en lot), atteignabilité, fronts de Pareto, matrices de distances, arbres de chemins (Dijkstra et delta-stepping de 1 à 32 fils), composantes fortement connexes (Tarjan, moteur parallèle de 1 à 32 fils, puis suivies sous modifications), arbres de chemins réparés sous changements de tarifs et tri topologique.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Compilation (depuis la racine du projet):
+ *      g++ -std=c++17 -O2 -pthread -I. Banc/BancReseau.cpp Graphe.cpp GrapheCompact.cpp DictionnaireNoms.cpp Instrumentation.cpp Reperes.cpp HierarchieContraction.cpp ArbreChemins.cpp ArbresDynamiques.cpp DeltaStepping.cpp CacheResultats.cpp FrontPareto.cpp ComposantesDynamiques.cpp IndexAtteignabilite.cpp ComposantesParalleles.cpp ReseauInterurbain.cpp -o bancReseau
+ *  Ajouter -DTP2_INSTRUMENTATION pour afficher aussi les compteurs moyens par requête de chaque moteur (dont le nombre
+ *  de sommets résolus, à comparer entre Dijkstra et ALT) et les durées par phase des composantes.
+ *  Les hiérarchies de contraction ne sont pas préparées pour la famille libre: la contraction des pivots y ajoute un
+ *  nombre quadratique de raccourcis.
+ *  Utilisation:
+ *      ./bancReseau [grille|libre|dag|tous] [nbSommets] [nbRequetes] [repetitions]
+ *      ./bancReseau generer <grille|libre|dag> <nbSommets> <fichier>
+ *  Sans nbSommets, chaque famille est mesurée à 10^3, 10^4 et 10^5 sommets.  Les réseaux de 10^6 et 10^7 sommets
+ *  se demandent explicitement (le fichier texte de 10^7 sommets fait environ 2 Go).
+ *
+ *  Familles de réseaux:
+ *      grille  réseau routier: grille carrée, un trajet dans chaque sens entre voisins (degré moyen ~4)
+ *      libre   réseau à pivots sans échelle (Barabási-Albert, 3 liens par nouvelle ville), trajets orientés
+ *      dag     réseau acyclique aléatoire: 4 trajets par ville vers des villes de numéro plus grand
+ *
+ *  Toutes les durées sont mesurées avec une horloge monotone (std::chrono::steady_clock).  La mémoire rapportée est
+ *  le pic de mémoire résidente du processus (getrusage), qui ne fait que croître d'une mesure à l'autre.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "ReseauInterurbain.h"
+#include "Parallele.h"
+
+using namespace std;
+using namespace TP2;
+
+namespace
+{
+    using Horloge = chrono::steady_clock;
+
+    /**
+    * \struct ReseauSynthetique
+    * \brief Un réseau généré: le nombre de villes (nommées V0, V1, ...) et les trajets, sans doublon
+    */
+    struct ReseauSynthetique
+    {
+        size_t nbVilles = 0;
+        vector<Graphe::NouvelArc> trajets;
+    };
+
+    /**
+    * \fn Ponderations tirerPonderations(mt19937_64& alea)
+    * \brief Tire la durée (heures) et le coût (dollars) d'un trajet; le coût croît avec la durée
+    */
+    Ponderations tirerPonderations(mt19937_64& alea)
+    {
+        uniform_real_distribution<float> duree(0.2f, 3.0f);
+        uniform_real_distribution<float> tarif(10.0f, 30.0f);
+        Ponderations p;
+        p.duree = round(duree(alea) * 100) / 100;
+        p.cout = round(p.duree * tarif(alea) * 100) / 100;
+        return p;
+    }
+
+    /**
+    * \fn ReseauSynthetique genererGrille(size_t nbVilles, mt19937_64& alea)
+    * \brief Grille carrée de côté ceil(sqrt(nbVilles)), remplie ligne par ligne; un trajet dans chaque sens entre
+    * deux villes voisines
+    */
+    ReseauSynthetique genererGrille(size_t nbVilles, mt19937_64& alea)
+    {
+        ReseauSynthetique reseau;
+        reseau.nbVilles = nbVilles;
+        reseau.trajets.reserve(4 * nbVilles);
+        size_t cote = static_cast<size_t>(ceil(sqrt(static_cast<double>(nbVilles))));
+
+        auto relier = [&](size_t a, size_t b) {
+            reseau.trajets.push_back({a, b, tirerPonderations(alea)});
+            reseau.trajets.push_back({b, a, tirerPonderations(alea)});
+        };
+        for (size_t v = 0; v < nbVilles; ++v) {
+            if ((v + 1) % cote != 0 && v + 1 < nbVilles) relier(v, v + 1);
+            if (v + cote < nbVilles) relier(v, v + cote);
+        }
+        return reseau;
+    }
+
+    /**
+    * \fn ReseauSynthetique genererSansEchelle(size_t nbVilles, mt19937_64& alea)
+    * \brief Attachement préférentiel de Barabási-Albert: chaque nouvelle ville se relie à 3 villes existantes tirées
+    * proportionnellement à leur degré.  Le trajet vers la ville existante est toujours présent, le retour une fois sur deux.
+    */
+    ReseauSynthetique genererSansEchelle(size_t nbVilles, mt19937_64& alea)
+    {
+        const size_t LIENS = 3;
+        ReseauSynthetique reseau;
+        reseau.nbVilles = nbVilles;
+        reseau.trajets.reserve(2 * LIENS * nbVilles);
+
+        vector<size_t> extremites;		// chaque ville y figure autant de fois que son degré
+        bernoulli_distribution retour(0.5);
+        for (size_t v = 0; v < nbVilles; ++v) {
+            vector<size_t> cibles;
+            if (v <= LIENS) {
+                for (size_t u = 0; u < v; ++u) cibles.push_back(u);
+            }
+            else {
+                uniform_int_distribution<size_t> tirage(0, extremites.size() - 1);
+                while (cibles.size() < LIENS) {
+                    auto u = extremites[tirage(alea)];
+                    if (find(cibles.begin(), cibles.end(), u) == cibles.end()) cibles.push_back(u);
+                }
+            }
+            for (auto u: cibles) {
+                reseau.trajets.push_back({v, u, tirerPonderations(alea)});
+                if (retour(alea)) reseau.trajets.push_back({u, v, tirerPonderations(alea)});
+                extremites.push_back(u);
+                extremites.push_back(v);
+            }
+        }
+        return reseau;
+    }
+
+    /**
+    * \fn ReseauSynthetique genererAcyclique(size_t nbVilles, mt19937_64& alea)
+    * \brief Réseau acyclique: chaque ville a jusqu'à 4 trajets vers des villes distinctes de numéro plus grand
+    */
+    ReseauSynthetique genererAcyclique(size_t nbVilles, mt19937_64& alea)
+    {
+        const size_t DEGRE = 4;
+        ReseauSynthetique reseau;
+        reseau.nbVilles = nbVilles;
+        reseau.trajets.reserve(DEGRE * nbVilles);
+
+        for (size_t v = 0; v + 1 < nbVilles; ++v) {
+            uniform_int_distribution<size_t> tirage(v + 1, nbVilles - 1);
+            size_t degre = min(DEGRE, nbVilles - 1 - v);
+            vector<size_t> cibles;
+            while (cibles.size() < degre) {
+                auto u = tirage(alea);
+                if (find(cibles.begin(), cibles.end(), u) == cibles.end()) cibles.push_back(u);
+            }
+            for (auto u: cibles) reseau.trajets.push_back({v, u, tirerPonderations(alea)});
+        }
+        return reseau;
+    }
+
+    /**
+    * \fn ReseauSynthetique generer(const string& famille, size_t nbVilles)
+    * \brief Génère un réseau de la famille demandée, avec une graine fixe pour que les mesures soient reproductibles
+    */
+    ReseauSynthetique generer(const string& famille, size_t nbVilles)
+    {
+        mt19937_64 alea(nbVilles);
+        if (famille == "grille") return genererGrille(nbVilles, alea);
+        if (famille == "libre") return genererSansEchelle(nbVilles, alea);
+        if (famille == "dag") return genererAcyclique(nbVilles, alea);
+        throw invalid_argument("famille de réseau inconnue: " + famille);
+    }
+
+    /**
+    * \fn void ecrire(const ReseauSynthetique& reseau, const string& nom, const string& fichier)
+    * \brief Écrit un réseau au format texte lu par ReseauInterurbain::chargerReseau
+    */
+    void ecrire(const ReseauSynthetique& reseau, const string& nom, const string& fichier)
+    {
+        ofstream sortie(fichier, ios::binary | ios::trunc);
+        if (!sortie) throw logic_error("impossible d'écrire " + fichier);
+
+        string tampon;
+        tampon.reserve(1 << 22);
+        auto vider = [&](bool forcer) {
+            if (forcer || tampon.size() > (1 << 21)) {
+                sortie.write(tampon.data(), static_cast<streamsize>(tampon.size()));
+                tampon.clear();
+            }
+        };
+
+        tampon += "Reseau Interurbain: " + nom + "\n" + to_string(reseau.nbVilles) + " villes\nListe des villes:\n";
+        for (size_t v = 0; v < reseau.nbVilles; ++v) {
+            tampon += 'V';
+            tampon += to_string(v);
+            tampon += '\n';
+            vider(false);
+        }
+        tampon += "Liste des trajets:";
+        char nombres[64];
+        for (const auto& trajet: reseau.trajets) {
+            snprintf(nombres, sizeof(nombres), "%.2f %.2f", trajet.poids.duree, trajet.poids.cout);
+            tampon += "\nV" + to_string(trajet.source) + "\nV" + to_string(trajet.destination) + "\n" + nombres;
+            vider(false);
+        }
+        tampon += '\n';
+        vider(true);
+    }
+
+    /**
+    * \fn double secondesDepuis(Horloge::time_point debut)
+    * \brief Donne le temps écoulé depuis debut, en secondes
+    */
+    double secondesDepuis(Horloge::time_point debut)
+    {
+        return chrono::duration<double>(Horloge::now() - debut).count();
+    }
+
+    /**
+    * \fn double picMemoireMo()
+    * \brief Donne le pic de mémoire résidente du processus, en Mo (getrusage donne des Ko sous Linux, des octets sous macOS)
+    */
+    double picMemoireMo()
+    {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1e6;
+#else
+        return usage.ru_maxrss / 1e3;
+#endif
+    }
+
+    /**
+    * \fn double centile(vector<double> mesures, double rang)
+    * \brief Donne le centile demandé (0 à 100) d'une série de mesures, au rang le plus proche
+    */
+    double centile(vector<double> mesures, double rang)
+    {
+        if (mesures.empty()) return 0;
+        size_t k = static_cast<size_t>(ceil(rang / 100 * mesures.size()));
+        k = min(max<size_t>(k, 1), mesures.size()) - 1;
+        nth_element(mesures.begin(), mesures.begin() + static_cast<ptrdiff_t>(k), mesures.end());
+        return mesures[k];
+    }
+
+    /**
+    * \fn void rapporter(const string& operation, const vector<double>& secondes, const string& unite, double volume)
+    * \brief Affiche une ligne de résultats: nombre de mesures, centiles 50/90/99 et maximum (en ms), débit et pic de mémoire.
+    * Le débit est le volume traité par seconde (unite), sur la somme des mesures.
+    */
+    void rapporter(const string& operation, const vector<double>& secondes, const string& unite, double volume)
+    {
+        double total = 0;
+        for (auto s: secondes) total += s;
+
+        printf("  %-26s n=%-6zu p50=%10.3f ms  p90=%10.3f ms  p99=%10.3f ms  max=%10.3f ms  %12.0f %s/s  pic=%8.1f Mo\n",
+               operation.c_str(), secondes.size(), 1e3 * centile(secondes, 50), 1e3 * centile(secondes, 90),
+               1e3 * centile(secondes, 99), 1e3 * *max_element(secondes.begin(), secondes.end()),
+               total > 0 ? volume / total : 0.0, unite.c_str(), picMemoireMo());
+    }
+
+    /**
+    * \fn void mesurer(const string& famille, size_t nbVilles, size_t nbRequetes, size_t repetitions)
+    * \brief Génère un réseau, l'écrit dans un fichier temporaire, puis mesure chaque opération
+    */
+    void mesurer(const string& famille, size_t nbVilles, size_t nbRequetes, size_t repetitions)
+    {
+        auto synthetique = generer(famille, nbVilles);
+        const string fichier = "bancReseau-" + famille + "-" + to_string(nbVilles) + ".txt";
+        ecrire(synthetique, famille, fichier);
+        printf("%s: %zu villes, %zu trajets\n", famille.c_str(), synthetique.nbVilles, synthetique.trajets.size());
+
+        ReseauInterurbain reseau(famille);
+        {
+            ifstream entree(fichier);
+            auto debut = Horloge::now();
+            reseau.chargerReseau(entree);
+            double duree = secondesDepuis(debut);
+            rapporter("chargerReseau", {duree}, "lignes", static_cast<double>(reseau.getStatistiquesChargement().lignes));
+        }
+        remove(fichier.c_str());
+
+        {
+            auto debut = Horloge::now();
+            reseau.preparerReperes(16);
+            rapporter("preparerReperes (16)", {secondesDepuis(debut)}, "villes", static_cast<double>(nbVilles));
+        }
+
+        {
+            //Index d'atteignabilité: construit à la première question, puis questions une à une et en lot
+            auto debut = Horloge::now();
+            reseau.estAtteignable("V0", "V0");
+            rapporter("index d'atteignabilite", {secondesDepuis(debut)}, "villes", static_cast<double>(nbVilles));
+            mt19937_64 alea(42);
+            uniform_int_distribution<size_t> tirage(0, nbVilles - 1);
+            vector<pair<string, string> > paires;
+            for (size_t i = 0; i < nbRequetes; ++i) {
+                auto origine = "V" + to_string(tirage(alea));	// les mêmes paires que Dijkstra (duree)
+                paires.emplace_back(origine, "V" + to_string(tirage(alea)));
+            }
+            vector<double> latences;
+            latences.reserve(nbRequetes);
+            size_t atteignables = 0;
+            for (const auto& paire: paires) {
+                debut = Horloge::now();
+                atteignables += reseau.estAtteignable(paire.first, paire.second);
+                latences.push_back(secondesDepuis(debut));
+            }
+            rapporter("estAtteignable", latences, "requetes", static_cast<double>(nbRequetes));
+            printf("  %-26s %zu/%zu paires reliees\n", "", atteignables, nbRequetes);
+            debut = Horloge::now();
+            reseau.sontAtteignables(paires);
+            rapporter("sontAtteignables (lot)", {secondesDepuis(debut)}, "requetes", static_cast<double>(nbRequetes));
+        }
+
+        vector<pair<MoteurRecherche, const char*> > moteurs = {{MoteurRecherche::Tas, "tas"}, {MoteurRecherche::Bidirectionnel, "bidir"},
+                                                               {MoteurRecherche::ALT, "ALT"}};
+        if (famille != "libre") {
+            auto debut = Horloge::now();
+            reseau.preparerHierarchies();
+            rapporter("preparerHierarchies", {secondesDepuis(debut)}, "villes", static_cast<double>(nbVilles));
+            printf("  %-26s %zu raccourcis (duree), %zu (cout)\n", "", reseau.getHierarchie(true).getNombreRaccourcis(),
+                   reseau.getHierarchie(false).getNombreRaccourcis());
+            moteurs.emplace_back(MoteurRecherche::Hierarchie, "CH");
+        }
+
+        for (const auto& moteur: moteurs) {
+            reseau.choisirMoteur(moteur.first);
+            TP2_INSTRUMENTER(reseau.reinitialiserInstrumentation();)
+            mt19937_64 alea(42);	// les mêmes paires pour chaque moteur
+            uniform_int_distribution<size_t> tirage(0, nbVilles - 1);
+            for (bool dureeCout: {true, false}) {
+                vector<double> latences;
+                latences.reserve(nbRequetes);
+                size_t reussis = 0;
+                for (size_t i = 0; i < nbRequetes; ++i) {
+                    auto origine = "V" + to_string(tirage(alea));
+                    auto destination = "V" + to_string(tirage(alea));
+                    auto debut = Horloge::now();
+                    auto chemin = reseau.rechercheCheminDijkstra(origine, destination, dureeCout);
+                    latences.push_back(secondesDepuis(debut));
+                    reussis += chemin.reussi;
+                }
+                string operation = string("Dijkstra ") + moteur.second + (dureeCout ? " (duree)" : " (cout)");
+                rapporter(operation, latences, "requetes", static_cast<double>(nbRequetes));
+                printf("  %-26s %zu/%zu paires reliees\n", "", reussis, nbRequetes);
+            }
+#ifdef TP2_INSTRUMENTATION
+            auto bilan = reseau.getInstrumentation();
+            double n = static_cast<double>(max<uint64_t>(bilan.nbRecherches, 1));
+            printf("  %-26s par requete: %.0f resolus, %.0f arcs examines, %.0f relaxations, %.0f/%.0f insertions/retraits, %.1f allocations\n",
+                   "instrumentation", bilan.cumulRecherches.sommetsResolus / n, bilan.cumulRecherches.arcsExamines / n,
+                   bilan.cumulRecherches.relaxationsReussies / n, bilan.cumulRecherches.insertionsTas / n,
+                   bilan.cumulRecherches.retraitsTas / n, bilan.cumulRecherches.allocations / n);
+            printf("  %-26s latences (histogramme): p50 <= %.3f ms, p99 <= %.3f ms\n", "",
+                   1e3 * bilan.latencesRecherches.centile(50), 1e3 * bilan.latencesRecherches.centile(99));
+#endif
+        }
+        reseau.choisirMoteur(MoteurRecherche::Tas);
+
+        {
+            //Les mêmes requêtes en lot, sur un fil puis sur tous les coeurs: le rapport des débits donne l'accélération
+            mt19937_64 alea(42);
+            uniform_int_distribution<size_t> tirage(0, nbVilles - 1);
+            vector<RequeteChemin> requetes;
+            for (size_t i = 0; i < nbRequetes; ++i)
+                requetes.push_back(RequeteChemin{"V" + to_string(tirage(alea)), "V" + to_string(tirage(alea)), i % 2 == 0});
+            vector<unsigned> essais = {1};
+            if (nombreFils(0, nbRequetes) > 1) essais.push_back(nombreFils(0, nbRequetes));
+            for (unsigned nbFils: essais) {
+                auto debut = Horloge::now();
+                reseau.rechercheCheminsLot(requetes, nbFils);
+                rapporter("Lot tas (" + to_string(nbFils) + " fils)", {secondesDepuis(debut)}, "requetes", static_cast<double>(nbRequetes));
+            }
+        }
+
+        {
+            //Front de Pareto (durée, coût): le plus rapide et le moins cher en une seule recherche
+            mt19937_64 alea(42);
+            uniform_int_distribution<size_t> tirage(0, nbVilles - 1);
+            vector<double> latences;
+            latences.reserve(nbRequetes);
+            size_t nbTrajets = 0;
+            for (size_t i = 0; i < nbRequetes; ++i) {
+                auto origine = "V" + to_string(tirage(alea));
+                auto destination = "V" + to_string(tirage(alea));
+                auto debut = Horloge::now();
+                nbTrajets += reseau.rechercheCheminsPareto(origine, destination).size();
+                latences.push_back(secondesDepuis(debut));
+            }
+            rapporter("Pareto (duree, cout)", latences, "requetes", static_cast<double>(nbRequetes));
+            printf("  %-26s %.1f trajets par front\n", "", static_cast<double>(nbTrajets) / static_cast<double>(max<size_t>(nbRequetes, 1)));
+        }
+
+        {
+            //Requêtes concentrées sur 200 paires (loi de Zipf), avec un cache de 256 chemins
+            mt19937_64 alea(11);
+            uniform_int_distribution<size_t> tirage(0, nbVilles - 1);
+            vector<pair<string, string> > paires;
+            vector<double> poidsPaires;
+            for (size_t i = 0; i < 200; ++i) {
+                paires.emplace_back("V" + to_string(tirage(alea)), "V" + to_string(tirage(alea)));
+                poidsPaires.push_back(1.0 / static_cast<double>(i + 1));
+            }
+            discrete_distribution<size_t> populaire(poidsPaires.begin(), poidsPaires.end());
+            reseau.dimensionnerCacheResultats(256);
+            vector<double> latences;
+            latences.reserve(nbRequetes);
+            for (size_t i = 0; i < nbRequetes; ++i) {
+                const auto& paire = paires[populaire(alea)];
+                auto debut = Horloge::now();
+                reseau.rechercheCheminDijkstra(paire.first, paire.second, true);
+                latences.push_back(secondesDepuis(debut));
+            }
+            rapporter("Dijkstra tas (cache 256)", latences, "requetes", static_cast<double>(nbRequetes));
+            auto cache = reseau.getStatistiquesCacheResultats();
+            printf("  %-26s %zu succes, %zu echecs, %zu evictions\n", "", cache.succes, cache.echecs, cache.evictions);
+            reseau.dimensionnerCacheResultats(0);
+        }
+
+        {
+            //Matrice de 100 x 100 villes: par seaux sur les hiérarchies si elles sont prêtes, sinon un Dijkstra par origine
+            const size_t cote = min<size_t>(100, nbVilles);
+            mt19937_64 alea(7);
+            uniform_int_distribution<size_t> tirage(0, nbVilles - 1);
+            vector<string> origines, destinations;
+            for (size_t i = 0; i < cote; ++i) {
+                origines.push_back("V" + to_string(tirage(alea)));
+                destinations.push_back("V" + to_string(tirage(alea)));
+            }
+            vector<double> latences;
+            for (size_t i = 0; i < repetitions; ++i) {
+                auto debut = Horloge::now();
+                reseau.matriceDistances(origines, destinations);
+                latences.push_back(secondesDepuis(debut));
+            }
+            rapporter("matriceDistances (" + to_string(cote) + "x" + to_string(cote) + ")", latences, "paires",
+                      static_cast<double>(2 * cote * cote * repetitions));
+        }
+
+        {
+            //Arbres de chemins (durée), sans cache: Dijkstra, puis delta-stepping de 1 à 32 fils, dont les distances
+            //doivent être exactement celles de Dijkstra
+            reseau.dimensionnerCacheArbres(0);
+            const size_t nbArbres = min<size_t>(repetitions, 8);
+            vector<shared_ptr<const ArbreChemins> > references;
+            vector<double> secondes;
+            for (size_t i = 0; i < nbArbres; ++i) {
+                auto debut = Horloge::now();
+                references.push_back(reseau.arbreChemins("V" + to_string(i * nbVilles / nbArbres), true));
+                secondes.push_back(secondesDepuis(debut));
+            }
+            rapporter("arbreChemins Dijkstra", secondes, "villes", static_cast<double>(nbArbres * nbVilles));
+            double reference = 0;
+            for (unsigned nbFils: {1u, 2u, 4u, 8u, 16u, 32u}) {
+                reseau.choisirMoteurArbres(MoteurArbres::DeltaStepping, nbFils);
+                size_t ecarts = 0;
+                secondes.clear();
+                for (size_t i = 0; i < nbArbres; ++i) {
+                    auto debut = Horloge::now();
+                    auto arbre = reseau.arbreChemins("V" + to_string(i * nbVilles / nbArbres), true);
+                    secondes.push_back(secondesDepuis(debut));
+                    for (size_t sommet = 0; sommet < nbVilles; ++sommet)
+                        if (arbre->distance(sommet) != references[i]->distance(sommet)) ++ecarts;
+                }
+                rapporter("arbreChemins delta (" + to_string(nbFils) + ")", secondes, "villes", static_cast<double>(nbArbres * nbVilles));
+                sort(secondes.begin(), secondes.end());
+                if (nbFils == 1) reference = secondes[secondes.size() / 2];
+                printf("  %-26s %zu distances differentes, acceleration x%.2f\n", "", ecarts, reference / secondes[secondes.size() / 2]);
+            }
+            reseau.choisirMoteurArbres(MoteurArbres::Dijkstra);
+            reseau.dimensionnerCacheArbres(8);
+        }
+
+        vector<double> durees;
+        size_t nbComposantes = 0;
+        for (size_t i = 0; i < repetitions; ++i) {
+            auto debut = Horloge::now();
+            nbComposantes = reseau.algorithmeKosaraju().size();
+            durees.push_back(secondesDepuis(debut));
+        }
+        rapporter("algorithmeKosaraju", durees, "villes", static_cast<double>(repetitions * nbVilles));
+        printf("  %-26s %zu composantes\n", "", nbComposantes);
+
+        {
+            //Moteur parallèle: numéros de composante seulement (sans les noms), de 1 à 32 fils, comparé à Tarjan
+            auto mesurer = [&]() {
+                vector<double> secondes;
+                for (size_t i = 0; i < repetitions; ++i) {
+                    auto debut = Horloge::now();
+                    nbComposantes = reseau.composantesFortementConnexes().nombre;
+                    secondes.push_back(secondesDepuis(debut));
+                }
+                return secondes;
+            };
+            auto tarjan = mesurer();
+            rapporter("composantes Tarjan", tarjan, "villes", static_cast<double>(repetitions * nbVilles));
+            double reference = 0;
+            for (unsigned nbFils: {1u, 2u, 4u, 8u, 16u, 32u}) {
+                reseau.choisirMoteurComposantes(MoteurComposantes::Parallele, nbFils);
+                auto secondes = mesurer();
+                rapporter("composantes paralleles (" + to_string(nbFils) + ")", secondes, "villes", static_cast<double>(repetitions * nbVilles));
+                sort(secondes.begin(), secondes.end());
+                if (nbFils == 1) reference = secondes[secondes.size() / 2];
+                printf("  %-26s %zu composantes, acceleration x%.2f\n", "", nbComposantes, reference / secondes[secondes.size() / 2]);
+            }
+            reseau.choisirMoteurComposantes(MoteurComposantes::Tarjan);
+        }
+
+        durees.clear();
+        for (size_t i = 0; i < repetitions; ++i) {
+            auto debut = Horloge::now();
+            reseau.triTopologiqueComposantes();
+            durees.push_back(secondesDepuis(debut));
+        }
+        rapporter("triTopologiqueComposantes", durees, "villes", static_cast<double>(repetitions * nbVilles));
+
+        {
+            //Composantes suivies: chaque trajet tiré est retiré puis remis, le réseau revient à son état initial
+            auto debut = Horloge::now();
+            reseau.composantesDynamiques();
+            rapporter("composantesDynamiques", {secondesDepuis(debut)}, "villes", static_cast<double>(nbVilles));
+            mt19937_64 alea(13);
+            uniform_int_distribution<size_t> tirage(0, synthetique.trajets.size() - 1);
+            const size_t nbModifications = min<size_t>(nbRequetes, 1000);
+            vector<double> latences;
+            latences.reserve(nbModifications);
+            for (size_t i = 0; i < nbModifications; ++i) {
+                const auto& trajet = synthetique.trajets[tirage(alea)];
+                auto origine = "V" + to_string(trajet.source), destination = "V" + to_string(trajet.destination);
+                debut = Horloge::now();
+                reseau.enleverTrajet(origine, destination);
+                reseau.ajouterTrajet(origine, destination, trajet.poids.duree, trajet.poids.cout);
+                latences.push_back(secondesDepuis(debut));
+            }
+            rapporter("enlever + ajouterTrajet", latences, "paires", static_cast<double>(nbModifications));
+            printf("  %-26s %zu composantes\n", "", reseau.composantesDynamiques().nombre());
+        }
+
+        {
+            //Arbres suivis depuis quelques pivots (coût): des tarifs tirés changent, puis sont remis dans l'ordre inverse;
+            //les arbres réparés doivent alors avoir exactement les distances de départ
+            reseau.dimensionnerCacheArbres(0);
+            const size_t nbPivots = 4;
+            vector<string> pivots;
+            vector<shared_ptr<const ArbreChemins> > references;
+            for (size_t i = 0; i < nbPivots; ++i) {
+                pivots.push_back("V" + to_string(i * nbVilles / nbPivots));
+                references.push_back(reseau.arbreChemins(pivots.back(), false));
+            }
+            auto debut = Horloge::now();
+            for (const auto& pivot: pivots) reseau.suivreArbreChemins(pivot, false);
+            rapporter("suivreArbreChemins", {secondesDepuis(debut)}, "arbres", static_cast<double>(nbPivots));
+
+            mt19937_64 alea(17);
+            uniform_int_distribution<size_t> tirage(0, synthetique.trajets.size() - 1);
+            uniform_real_distribution<float> facteur(0.5f, 1.5f);
+            const size_t nbModifications = min<size_t>(nbRequetes, 1000);
+            vector<size_t> tires;
+            vector<double> latences;
+            for (size_t i = 0; i < nbModifications; ++i) {
+                tires.push_back(tirage(alea));
+                const auto& trajet = synthetique.trajets[tires.back()];
+                debut = Horloge::now();
+                reseau.modifierPonderations("V" + to_string(trajet.source), "V" + to_string(trajet.destination),
+                                            trajet.poids.duree, round(trajet.poids.cout * facteur(alea) * 100) / 100);
+                latences.push_back(secondesDepuis(debut));
+            }
+            for (size_t i = tires.size(); i-- > 0;) {
+                const auto& trajet = synthetique.trajets[tires[i]];
+                debut = Horloge::now();
+                reseau.modifierPonderations("V" + to_string(trajet.source), "V" + to_string(trajet.destination),
+                                            trajet.poids.duree, trajet.poids.cout);
+                latences.push_back(secondesDepuis(debut));
+            }
+            rapporter("modifierPonderations", latences, "trajets", static_cast<double>(latences.size()));
+
+            size_t ecarts = 0;
+            for (size_t i = 0; i < nbPivots; ++i) {
+                auto arbre = reseau.arbreChemins(pivots[i], false);
+                for (size_t sommet = 0; sommet < nbVilles; ++sommet)
+                    if (arbre->distance(sommet) != references[i]->distance(sommet)) ++ecarts;
+            }
+            printf("  %-26s %.1f sommets repares par modification et par arbre, %zu distances differentes\n", "",
+                   static_cast<double>(reseau.arbresDynamiques().getSommetsRepares()) / static_cast<double>(latences.size() * nbPivots), ecarts);
+            reseau.dimensionnerCacheArbres(8);
+        }
+
+#ifdef TP2_INSTRUMENTATION
+        auto bilan = reseau.getInstrumentation();
+        double k = static_cast<double>(max<uint64_t>(bilan.nbComposantes, 1));
+        printf("  %-26s composantes: transposition %.3f ms, premier parcours %.3f ms, second parcours %.3f ms\n", "",
+               1e3 * bilan.cumulComposantes.secondesTransposition / k, 1e3 * bilan.cumulComposantes.secondesPremierParcours / k,
+               1e3 * bilan.cumulComposantes.secondesSecondParcours / k);
+#endif
+
+        if (famille == "dag") {
+            Graphe graphe(nbVilles);
+            graphe.ajouterArcs(synthetique.trajets);
+            durees.clear();
+            for (size_t i = 0; i < repetitions; ++i) {
+                auto debut = Horloge::now();
+                graphe.triTopologique();
+                durees.push_back(secondesDepuis(debut));
+            }
+            rapporter("Graphe::triTopologique", durees, "sommets", static_cast<double>(repetitions * nbVilles));
+        }
+        printf("\n");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try {
+        string famille = argc > 1 ? argv[1] : "tous";
+
+        if (famille == "generer") {
+            if (argc < 5) {
+                cerr << "Utilisation: " << argv[0] << " generer <grille|libre|dag> <nbSommets> <fichier>" << endl;
+                return 1;
+            }
+            ecrire(generer(argv[2], strtoul(argv[3], nullptr, 10)), argv[2], argv[4]);
+            return 0;
+        }
+
+        vector<size_t> tailles = {1000, 10000, 100000};
+        if (argc > 2) tailles = {strtoul(argv[2], nullptr, 10)};
+        size_t nbRequetes = argc > 3 ? strtoul(argv[3], nullptr, 10) : 200;
+        size_t repetitions = argc > 4 ? strtoul(argv[4], nullptr, 10) : 5;
+
+        vector<string> familles = {famille};
+        if (famille == "tous") familles = {"grille", "libre", "dag"};
+
+        for (const auto& f: familles)
+            for (auto n: tailles)
+                mesurer(f, n, nbRequetes, repetitions);
+    }
+    catch (exception& e) {
+        cerr << "ERREUR: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * \file CacheResultats.cpp
+ * \brief Implémentation du cache des chemins récemment trouvés.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "CacheResultats.h"
+#include "ReseauInterurbain.h"
+
+namespace TP2
+{
+
+    /**
+    * \fn CacheResultats::CacheResultats(size_t capacite)
+    * \brief Constructeur: un cache vide
+    * \param[in] capacite le nombre maximal de chemins gardés, 0 pour désactiver le cache
+    */
+    CacheResultats::CacheResultats(size_t capacite) : capacite(capacite) {
+    }
+
+    /**
+    * \fn CacheResultats::CacheResultats(const CacheResultats& autre)
+    * \brief Constructeur de copie: les chemins sont partagés avec autre, les compteurs recopiés
+    */
+    CacheResultats::CacheResultats(const CacheResultats& autre) : capacite(0) {
+        *this = autre;
+    }
+
+    /**
+    * \fn CacheResultats& CacheResultats::operator=(const CacheResultats& autre)
+    * \brief Affectation: les chemins sont partagés avec autre, les compteurs recopiés
+    */
+    CacheResultats& CacheResultats::operator=(const CacheResultats& autre) {
+        if (this == &autre) return *this;
+        std::scoped_lock garde(verrou, autre.verrou);
+        capacite = autre.capacite.load();
+        entrees = autre.entrees;
+        statistiques = autre.statistiques;
+        indexer();
+        return *this;
+    }
+
+    /**
+    * \fn size_t CacheResultats::HachageCle::operator()(const Cle& cle) const
+    * \brief Mélange l'origine, la destination et le critère (multiplication de Fibonacci)
+    */
+    size_t CacheResultats::HachageCle::operator()(const Cle& cle) const {
+        std::uint64_t h = (static_cast<std::uint64_t>(cle.source) * 0x9E3779B97F4A7C15ull) ^ cle.cible;
+        h = (h << 1 | (cle.dureeCout ? 1 : 0)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+
+    /**
+    * \fn std::shared_ptr<const Chemin> CacheResultats::trouver(size_t source, size_t cible, bool dureeCout, std::uint64_t version)
+    * \brief Cherche le chemin d'une recherche; s'il est présent et de la bonne version, il passe en tête (le plus récent).
+    * S'il est d'une autre version, il est retiré et compté comme périmé.
+    * \param[in] source le sommet d'origine
+    * \param[in] cible le sommet de destination
+    * \param[in] dureeCout le critère
+    * \param[in] version la version de l'instantané courant
+    * \return std::shared_ptr<const Chemin> le chemin, nullptr s'il n'est pas en cache ou si le cache est désactivé
+    */
+    std::shared_ptr<const Chemin> CacheResultats::trouver(size_t source, size_t cible, bool dureeCout, std::uint64_t version) {
+        if (capacite == 0) return nullptr;
+
+        std::lock_guard<std::mutex> garde(verrou);
+        auto it = index.find(Cle{source, cible, dureeCout});
+        if (it == index.end()) {
+            ++statistiques.echecs;
+            return nullptr;
+        }
+        if (it->second->version != version) {
+            entrees.erase(it->second);
+            index.erase(it);
+            ++statistiques.perimes;
+            ++statistiques.echecs;
+            return nullptr;
+        }
+        entrees.splice(entrees.begin(), entrees, it->second);
+        ++statistiques.succes;
+        return entrees.front().chemin;
+    }
+
+    /**
+    * \fn void CacheResultats::ajouter(size_t source, size_t cible, bool dureeCout, std::uint64_t version, const Chemin& chemin)
+    * \brief Ajoute un chemin en tête; un chemin de même clé est remplacé.  La copie du chemin est faite avant de prendre
+    * le verrou.
+    * \param[in] source le sommet d'origine
+    * \param[in] cible le sommet de destination
+    * \param[in] dureeCout le critère
+    * \param[in] version la version de l'instantané sur lequel le chemin a été calculé
+    * \param[in] chemin le chemin
+    */
+    void CacheResultats::ajouter(size_t source, size_t cible, bool dureeCout, std::uint64_t version, const Chemin& chemin) {
+        if (capacite == 0) return;
+
+        auto copie = std::make_shared<const Chemin>(chemin);
+        const Cle cle{source, cible, dureeCout};
+        std::lock_guard<std::mutex> garde(verrou);
+        auto it = index.find(cle);
+        if (it != index.end()) {
+            it->second->version = version;
+            it->second->chemin = std::move(copie);
+            entrees.splice(entrees.begin(), entrees, it->second);
+            return;
+        }
+        entrees.push_front(Entree{cle, version, std::move(copie)});
+        index.emplace(cle, entrees.begin());
+        evincer();
+    }
+
+    /**
+    * \fn void CacheResultats::vider()
+    * \brief Oublie tous les chemins
+    */
+    void CacheResultats::vider() {
+        std::lock_guard<std::mutex> garde(verrou);
+        entrees.clear();
+        index.clear();
+    }
+
+    /**
+    * \fn void CacheResultats::dimensionner(size_t capacite)
+    * \brief Change la capacité du cache
+    * \param[in] capacite le nombre maximal de chemins gardés, 0 pour désactiver le cache
+    */
+    void CacheResultats::dimensionner(size_t capacite) {
+        std::lock_guard<std::mutex> garde(verrou);
+        this->capacite = capacite;
+        evincer();
+    }
+
+    /**
+    * \fn size_t CacheResultats::taille() const
+    * \return size_t le nombre de chemins en cache
+    */
+    size_t CacheResultats::taille() const {
+        std::lock_guard<std::mutex> garde(verrou);
+        return entrees.size();
+    }
+
+    /**
+    * \fn StatistiquesCacheResultats CacheResultats::getStatistiques() const
+    * \return StatistiquesCacheResultats une copie des compteurs
+    */
+    StatistiquesCacheResultats CacheResultats::getStatistiques() const {
+        std::lock_guard<std::mutex> garde(verrou);
+        return statistiques;
+    }
+
+    /**
+    * \fn void CacheResultats::reinitialiserStatistiques()
+    * \brief Remet les compteurs à zéro
+    */
+    void CacheResultats::reinitialiserStatistiques() {
+        std::lock_guard<std::mutex> garde(verrou);
+        statistiques = StatistiquesCacheResultats();
+    }
+
+    /**
+    * \fn void CacheResultats::evincer()
+    * \brief Retire les chemins les moins récents au-delà de la capacité (verrou déjà pris)
+    */
+    void CacheResultats::evincer() {
+        while (entrees.size() > capacite) {
+            index.erase(entrees.back().cle);
+            entrees.pop_back();
+            ++statistiques.evictions;
+        }
+    }
+
+    /**
+    * \fn void CacheResultats::indexer()
+    * \brief Reconstruit l'index à partir de la liste des chemins (verrou déjà pris)
+    */
+    void CacheResultats::indexer() {
+        index.clear();
+        for (auto it = entrees.begin(); it != entrees.end(); ++it) index.emplace(it->cle, it);
+    }
+
+}//Fin du namespace
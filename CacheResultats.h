@@ -0,0 +1,122 @@
+/**
+ * \file CacheResultats.h
+ * \brief Cache des chemins récemment trouvés, estampillés par la version du réseau.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#ifndef _CACHERESULTATS__H
+#define _CACHERESULTATS__H
+
+namespace TP2
+{
+
+struct Chemin;
+
+/**
+ * \struct StatistiquesCacheResultats
+ * \brief Les compteurs d'un cache de résultats, pour en ajuster la capacité
+ */
+struct StatistiquesCacheResultats
+{
+	size_t succes = 0;		// Les chemins servis par le cache
+	size_t echecs = 0;		// Les chemins absents ou périmés, à calculer
+	size_t perimes = 0;		// Parmi les échecs: les chemins trouvés mais calculés sur une autre version du réseau
+	size_t evictions = 0;	// Les chemins retirés pour faire de la place
+};
+
+/**
+ * \class CacheResultats
+ * \brief Les chemins les plus récemment trouvés, jusqu'à une capacité donnée, retrouvés par (origine, destination,
+ *  critère) en O(1).  Le moins récemment utilisé est évincé.
+ *
+ *  Chaque chemin retient la version de l'instantané sur lequel il a été calculé (GrapheCompact::getVersion): un chemin
+ *  d'une autre version n'est jamais servi, il est retiré au moment où il est demandé.  Le cache n'a donc pas à être
+ *  vidé quand le réseau change.  Une capacité nulle (par défaut) désactive le cache: trouver et ajouter ne prennent
+ *  alors pas le verrou et ne comptent rien.  Les opérations sont protégées par un verrou, pour les recherches
+ *  concurrentes; les chemins sont partagés, de sorte qu'aucune copie n'est faite sous le verrou.
+ */
+class CacheResultats
+{
+public:
+
+	explicit CacheResultats(size_t capacite = 0);
+	CacheResultats(const CacheResultats& autre);
+	CacheResultats& operator=(const CacheResultats& autre);
+
+	// Retourne le chemin de (source, cible, dureeCout) calculé sur la version donnée et le marque le plus récent,
+	// nullptr s'il n'est pas en cache. Un chemin d'une autre version est retiré.
+	std::shared_ptr<const Chemin> trouver(size_t source, size_t cible, bool dureeCout, std::uint64_t version);
+
+	// Ajoute un chemin comme le plus récent (remplace celui de même clé), en évinçant au besoin le moins récent
+	void ajouter(size_t source, size_t cible, bool dureeCout, std::uint64_t version, const Chemin& chemin);
+
+	// Vide le cache (les compteurs sont gardés)
+	void vider();
+
+	// Change la capacité (0: le cache est désactivé), en évinçant au besoin les moins récents
+	void dimensionner(size_t capacite);
+
+	// Retourne la capacité et le nombre de chemins en cache
+	size_t getCapacite() const { return capacite; }
+	size_t taille() const;
+
+	// Retourne une copie des compteurs, ou les remet à zéro
+	StatistiquesCacheResultats getStatistiques() const;
+	void reinitialiserStatistiques();
+
+private:
+
+	/**
+	 * \struct Cle
+	 * \brief Une recherche: origine, destination et critère
+	 */
+	struct Cle
+	{
+		size_t source;
+		size_t cible;
+		bool dureeCout;
+
+		bool operator==(const Cle& autre) const { return source == autre.source && cible == autre.cible && dureeCout == autre.dureeCout; }
+	};
+
+	struct HachageCle
+	{
+		size_t operator()(const Cle& cle) const;
+	};
+
+	/**
+	 * \struct Entree
+	 * \brief Un chemin en cache et la version du réseau sur laquelle il a été calculé
+	 */
+	struct Entree
+	{
+		Cle cle;
+		std::uint64_t version;
+		std::shared_ptr<const Chemin> chemin;
+	};
+
+	mutable std::mutex verrou;
+	std::atomic<size_t> capacite;
+	std::list<Entree> entrees;		// du plus récent au moins récent
+	std::unordered_map<Cle, std::list<Entree>::iterator, HachageCle> index;
+	StatistiquesCacheResultats statistiques;
+
+	void evincer();
+	void indexer();
+};
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,508 @@
+/**
+ * \file ComposantesDynamiques.cpp
+ * \brief Implémentation des composantes fortement connexes dynamiques.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "ComposantesDynamiques.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace TP2
+{
+    namespace
+    {
+        const std::uint32_t TERMINE = 0xFFFFFFFEu;	// indice d'un sommet déjà rangé dans une partie (Tarjan local)
+    }
+
+    /**
+    * \fn ComposantesDynamiques::ComposantesDynamiques()
+    * \brief Constructeur par défaut: aucune composante
+    */
+    ComposantesDynamiques::ComposantesDynamiques() : nbComposantes(0), generation(0) {
+    }
+
+    /**
+    * \fn ComposantesDynamiques::ComposantesDynamiques(const GrapheCompact& graphe)
+    * \brief Constructeur: copie les arcs du graphe, calcule ses composantes par l'algorithme de Tarjan, puis le graphe
+    * condensé.  Les numéros de Tarjan sont en ordre topologique inverse: le rang d'une composante est son numéro retourné.
+    * \param[in] graphe l'instantané du graphe
+    */
+    ComposantesDynamiques::ComposantesDynamiques(const GrapheCompact& graphe) : nbComposantes(0), generation(0) {
+        const size_t nbSommets = graphe.taille();
+        successeurs.resize(nbSommets);
+        predecesseurs.resize(nbSommets);
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet) {
+            successeurs[sommet].reserve(graphe.finArcs(sommet) - graphe.debutArcs(sommet));
+            predecesseurs[sommet].reserve(graphe.finArcsEntrants(sommet) - graphe.debutArcsEntrants(sommet));
+            for (auto arc = graphe.debutArcs(sommet); arc < graphe.finArcs(sommet); ++arc)
+                successeurs[sommet].push_back(static_cast<std::uint32_t>(graphe.destination(arc)));
+            for (auto arc = graphe.debutArcsEntrants(sommet); arc < graphe.finArcsEntrants(sommet); ++arc)
+                predecesseurs[sommet].push_back(static_cast<std::uint32_t>(graphe.source(arc)));
+        }
+
+        auto cfc = graphe.composantesFortementConnexes();
+        nbComposantes = cfc.nombre;
+        composantes.resize(nbSommets);
+        suivants.resize(nbSommets);
+        representants.assign(nbComposantes, AUCUNE);
+        tailles.assign(nbComposantes, 0);
+        rangs.resize(nbComposantes);
+        sortants.resize(nbComposantes);
+        entrants.resize(nbComposantes);
+        ordre.resize(nbComposantes);
+        marquesAvant.assign(nbComposantes, 0);
+        marquesArriere.assign(nbComposantes, 0);
+        marquesSommets.assign(nbSommets, 0);
+        marquesRetour.assign(nbSommets, 0);
+        indices.resize(nbSommets);
+        basses.resize(nbSommets);
+
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet) {
+            auto c = static_cast<std::uint32_t>(cfc.numeros[sommet]);
+            auto s = static_cast<std::uint32_t>(sommet);
+            composantes[s] = c;
+            if (representants[c] == AUCUNE) {
+                representants[c] = s;
+                suivants[s] = s;
+            }
+            else {
+                suivants[s] = suivants[representants[c]];
+                suivants[representants[c]] = s;
+            }
+            ++tailles[c];
+        }
+        for (size_t c = 0; c < nbComposantes; ++c) {
+            rangs[c] = static_cast<std::uint32_t>(nbComposantes - 1 - c);
+            ordre[nbComposantes - 1 - c] = static_cast<std::uint32_t>(c);
+        }
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet)
+            for (auto voisin: successeurs[sommet])
+                if (composantes[sommet] != composantes[voisin]) relier(composantes[sommet], composantes[voisin], 1);
+    }
+
+    /**
+    * \fn std::vector<size_t> ComposantesDynamiques::membres(size_t composante) const
+    * \brief Donne les sommets d'une composante, en suivant sa liste circulaire
+    * \param[in] composante l'identifiant de la composante
+    * \exception logic_error si composante n'est pas l'identifiant d'une composante
+    * \return std::vector<size_t> les sommets de la composante
+    */
+    std::vector<size_t> ComposantesDynamiques::membres(size_t composante) const {
+        if (composante >= representants.size() || representants[composante] == AUCUNE)
+            throw std::logic_error("ComposantesDynamiques::membres : composante inexistante");
+
+        std::vector<size_t> sommets;
+        sommets.reserve(tailles[composante]);
+        auto sommet = representants[composante];
+        do {
+            sommets.push_back(sommet);
+            sommet = suivants[sommet];
+        } while (sommet != representants[composante]);
+        return sommets;
+    }
+
+    /**
+    * \fn Composantes ComposantesDynamiques::numeroter() const
+    * \brief Numérote les composantes de 0 à nombre() - 1 en ordre topologique inverse, en parcourant l'ordre maintenu
+    * \return Composantes le numéro de composante de chaque sommet
+    */
+    Composantes ComposantesDynamiques::numeroter() const {
+        std::vector<size_t> numeros(representants.size());
+        size_t suivant = nbComposantes;
+        for (auto c: ordre)
+            if (c != AUCUNE) numeros[c] = --suivant;
+
+        Composantes resultat;
+        resultat.nombre = nbComposantes;
+        resultat.numeros.resize(composantes.size());
+        for (size_t sommet = 0; sommet < composantes.size(); ++sommet) resultat.numeros[sommet] = numeros[composantes[sommet]];
+        return resultat;
+    }
+
+    /**
+    * \fn void ComposantesDynamiques::ajouterArc(size_t source, size_t destination)
+    * \brief Ajoute un arc.  Entre deux composantes déjà dans le bon ordre, l'ajout ne coûte qu'une mise à jour du compte
+    * de l'arc condensé; sinon l'ordre est réparé (et un cycle éventuel fusionné) par reordonner.
+    * \param[in] source la source de l'arc
+    * \param[in] destination la destination de l'arc
+    * \exception logic_error si source ou destination n'est pas un sommet
+    */
+    void ComposantesDynamiques::ajouterArc(size_t source, size_t destination) {
+        if (source >= taille()) throw std::logic_error("ComposantesDynamiques::ajouterArc : la source est invalide");
+        if (destination >= taille()) throw std::logic_error("ComposantesDynamiques::ajouterArc : la destination est invalide");
+
+        successeurs[source].push_back(static_cast<std::uint32_t>(destination));
+        predecesseurs[destination].push_back(static_cast<std::uint32_t>(source));
+
+        auto a = composantes[source], b = composantes[destination];
+        if (a == b) return;
+        relier(a, b, 1);
+        if (rangs[a] > rangs[b]) reordonner(a, b);
+    }
+
+    /**
+    * \fn void ComposantesDynamiques::enleverArc(size_t source, size_t destination)
+    * \brief Retire un arc.  Un arc entre deux composantes ne change que le graphe condensé.  Un arc interne à une
+    * composante ne la scinde que si sa source ne mène plus à sa destination: une recherche bidirectionnelle dans la
+    * composante le vérifie, et seulement si elle échoue un Tarjan restreint aux membres calcule les parties.
+    * \param[in] source la source de l'arc
+    * \param[in] destination la destination de l'arc
+    * \exception logic_error si source ou destination n'est pas un sommet
+    * \exception logic_error si l'arc n'existe pas
+    */
+    void ComposantesDynamiques::enleverArc(size_t source, size_t destination) {
+        if (source >= taille()) throw std::logic_error("ComposantesDynamiques::enleverArc : la source est invalide");
+        if (destination >= taille()) throw std::logic_error("ComposantesDynamiques::enleverArc : la destination est invalide");
+
+        auto effacer = [](std::vector<std::uint32_t>& liste, size_t extremite) {
+            auto it = std::find(liste.begin(), liste.end(), static_cast<std::uint32_t>(extremite));
+            if (it == liste.end()) return false;
+            *it = liste.back();
+            liste.pop_back();
+            return true;
+        };
+        if (!effacer(successeurs[source], destination)) throw std::logic_error("ComposantesDynamiques::enleverArc : l'arc n'existe pas");
+        effacer(predecesseurs[destination], source);
+
+        auto a = composantes[source], b = composantes[destination];
+        if (a != b) delier(a, b, 1);
+        else if (source != destination && !relies(a, static_cast<std::uint32_t>(source), static_cast<std::uint32_t>(destination))) scinder(a);
+    }
+
+    /**
+    * \fn std::uint32_t ComposantesDynamiques::nouvelleGeneration()
+    * \brief Commence un nouveau parcours: les marques des parcours précédents deviennent caduques
+    * \return std::uint32_t l'estampille du parcours
+    */
+    std::uint32_t ComposantesDynamiques::nouvelleGeneration() {
+        if (++generation == 0) {
+            std::fill(marquesAvant.begin(), marquesAvant.end(), 0);
+            std::fill(marquesArriere.begin(), marquesArriere.end(), 0);
+            std::fill(marquesSommets.begin(), marquesSommets.end(), 0);
+            std::fill(marquesRetour.begin(), marquesRetour.end(), 0);
+            generation = 1;
+        }
+        return generation;
+    }
+
+    /**
+    * \fn std::uint32_t ComposantesDynamiques::nouvelIdentifiant()
+    * \brief Donne un identifiant de composante libre, au besoin en agrandissant les tableaux par composante
+    * \return std::uint32_t l'identifiant
+    */
+    std::uint32_t ComposantesDynamiques::nouvelIdentifiant() {
+        if (!libres.empty()) {
+            auto identifiant = libres.back();
+            libres.pop_back();
+            return identifiant;
+        }
+        auto identifiant = static_cast<std::uint32_t>(representants.size());
+        representants.push_back(AUCUNE);
+        tailles.push_back(0);
+        rangs.push_back(0);
+        sortants.emplace_back();
+        entrants.emplace_back();
+        marquesAvant.push_back(0);
+        marquesArriere.push_back(0);
+        return identifiant;
+    }
+
+    /**
+    * \fn void ComposantesDynamiques::relier(std::uint32_t source, std::uint32_t destination, std::uint32_t nombre)
+    * \brief Ajoute nombre arcs à l'arc condensé source -> destination, dans les deux sens de parcours
+    */
+    void ComposantesDynamiques::relier(std::uint32_t source, std::uint32_t destination, std::uint32_t nombre) {
+        sortants[source][destination] += nombre;
+        entrants[destination][source] += nombre;
+    }
+
+    /**
+    * \fn void ComposantesDynamiques::delier(std::uint32_t source, std::uint32_t destination, std::uint32_t nombre)
+    * \brief Retire nombre arcs de l'arc condensé source -> destination, qui disparaît quand son compte tombe à 0
+    */
+    void ComposantesDynamiques::delier(std::uint32_t source, std::uint32_t destination, std::uint32_t nombre) {
+        auto arc = sortants[source].find(destination);
+        if ((arc->second -= nombre) == 0) {
+            sortants[source].erase(arc);
+            entrants[destination].erase(source);
+        }
+        else entrants[destination][source] -= nombre;
+    }
+
+    /**
+    * \fn bool ComposantesDynamiques::relies(std::uint32_t composante, std::uint32_t source, std::uint32_t destination)
+    * \brief Cherche un chemin de source à destination dans une composante, par deux parcours en largeur (vers l'avant
+    * depuis source, vers l'arrière depuis destination) dont on avance toujours la plus petite frontière.  Une
+    * destination qui n'a plus d'autre arc entrant, cas courant d'une scission, est ainsi reconnue en O(1).
+    * \param[in] composante la composante commune de source et destination
+    * \return bool true si les deux parcours se rencontrent
+    */
+    bool ComposantesDynamiques::relies(std::uint32_t composante, std::uint32_t source, std::uint32_t destination) {
+        const auto gen = nouvelleGeneration();
+        std::vector<std::uint32_t> avant{source}, arriere{destination};
+        marquesSommets[source] = gen;
+        marquesRetour[destination] = gen;
+        size_t prochainAvant = 0, prochainArriere = 0;
+        while (prochainAvant < avant.size() && prochainArriere < arriere.size()) {
+            if (avant.size() - prochainAvant <= arriere.size() - prochainArriere) {
+                for (auto voisin: successeurs[avant[prochainAvant++]]) {
+                    if (composantes[voisin] != composante || marquesSommets[voisin] == gen) continue;
+                    if (marquesRetour[voisin] == gen) return true;
+                    marquesSommets[voisin] = gen;
+                    avant.push_back(voisin);
+                }
+            }
+            else {
+                for (auto voisin: predecesseurs[arriere[prochainArriere++]]) {
+                    if (composantes[voisin] != composante || marquesRetour[voisin] == gen) continue;
+                    if (marquesSommets[voisin] == gen) return true;
+                    marquesRetour[voisin] = gen;
+                    arriere.push_back(voisin);
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+    * \fn void ComposantesDynamiques::reordonner(std::uint32_t a, std::uint32_t b)
+    * \brief Répare l'ordre après l'ajout de l'arc condensé a -> b, b étant placé avant a (Pearce-Kelly).  avant: les
+    * composantes atteintes depuis b sans dépasser le rang de a; arriere: celles qui mènent à a sans descendre sous le rang
+    * de b.  Les rangs de ces composantes sont réattribués: arriere d'abord, avant ensuite, chacune dans son ordre
+    * précédent.  Si a est dans avant, les composantes des deux ensembles forment un cycle et sont fusionnées, au rang qui
+    * sépare les deux autres groupes.
+    * \param[in] a la composante source du nouvel arc
+    * \param[in] b la composante destination du nouvel arc
+    */
+    void ComposantesDynamiques::reordonner(std::uint32_t a, std::uint32_t b) {
+        const auto gen = nouvelleGeneration();
+        const auto rangA = rangs[a], rangB = rangs[b];
+
+        std::vector<std::uint32_t> avant, arriere, pile;
+        marquesAvant[b] = gen;
+        pile.push_back(b);
+        while (!pile.empty()) {
+            auto c = pile.back();
+            pile.pop_back();
+            avant.push_back(c);
+            for (const auto& arc: sortants[c]) {
+                if (rangs[arc.first] > rangA || marquesAvant[arc.first] == gen) continue;
+                marquesAvant[arc.first] = gen;
+                pile.push_back(arc.first);
+            }
+        }
+        marquesArriere[a] = gen;
+        pile.push_back(a);
+        while (!pile.empty()) {
+            auto c = pile.back();
+            pile.pop_back();
+            arriere.push_back(c);
+            for (const auto& arc: entrants[c]) {
+                if (rangs[arc.first] < rangB || marquesArriere[arc.first] == gen) continue;
+                marquesArriere[arc.first] = gen;
+                pile.push_back(arc.first);
+            }
+        }
+
+        //Le cycle: les composantes à la fois atteintes depuis b et menant à a
+        std::vector<std::uint32_t> debut, cycle, fin, places;
+        for (auto c: arriere) (marquesAvant[c] == gen ? cycle : debut).push_back(c);
+        for (auto c: avant) if (marquesArriere[c] != gen) fin.push_back(c);
+        for (auto groupe: {&debut, &cycle, &fin})
+            for (auto c: *groupe) places.push_back(rangs[c]);
+        std::sort(places.begin(), places.end());
+        auto parRang = [this](std::uint32_t x, std::uint32_t y) { return rangs[x] < rangs[y]; };
+        std::sort(debut.begin(), debut.end(), parRang);
+        std::sort(fin.begin(), fin.end(), parRang);
+
+        size_t place = 0;
+        for (auto c: debut) {
+            rangs[c] = places[place];
+            ordre[places[place++]] = c;
+        }
+        auto placeCycle = cycle.empty() ? AUCUNE : places[place++];
+        while (place < places.size() - fin.size()) ordre[places[place++]] = AUCUNE;
+        for (auto c: fin) {
+            rangs[c] = places[place];
+            ordre[places[place++]] = c;
+        }
+
+        if (!cycle.empty()) {
+            auto fusionnee = fusionner(cycle, gen);
+            rangs[fusionnee] = placeCycle;
+            ordre[placeCycle] = fusionnee;
+            if (ordre.size() > 2 * nbComposantes + 64) compacter();
+        }
+    }
+
+    /**
+    * \fn std::uint32_t ComposantesDynamiques::fusionner(const std::vector<std::uint32_t>& cycle, std::uint32_t gen)
+    * \brief Fusionne les composantes d'un cycle dans la plus grande: les membres des autres sont renumérotés et leurs
+    * listes raccordées, leurs arcs condensés reportés (sauf ceux internes au cycle, qui disparaissent aussi des tables de
+    * la composante gardée), et leurs identifiants libérés.
+    * \param[in] cycle les composantes à fusionner, marquées de gen vers l'avant et vers l'arrière
+    * \param[in] gen l'estampille du parcours de reordonner
+    * \return std::uint32_t l'identifiant de la composante fusionnée
+    */
+    std::uint32_t ComposantesDynamiques::fusionner(const std::vector<std::uint32_t>& cycle, std::uint32_t gen) {
+        auto dansCycle = [&](std::uint32_t c) { return marquesAvant[c] == gen && marquesArriere[c] == gen; };
+        auto garde = *std::max_element(cycle.begin(), cycle.end(), [this](std::uint32_t x, std::uint32_t y) { return tailles[x] < tailles[y]; });
+
+        for (auto c: cycle) {
+            if (c == garde) continue;
+            auto sommet = representants[c];
+            do {
+                composantes[sommet] = garde;
+                sommet = suivants[sommet];
+            } while (sommet != representants[c]);
+            std::swap(suivants[representants[garde]], suivants[representants[c]]);
+            tailles[garde] += tailles[c];
+
+            for (const auto& arc: sortants[c]) {
+                entrants[arc.first].erase(c);
+                if (!dansCycle(arc.first)) relier(garde, arc.first, arc.second);
+            }
+            for (const auto& arc: entrants[c]) {
+                sortants[arc.first].erase(c);
+                if (!dansCycle(arc.first)) relier(arc.first, garde, arc.second);
+            }
+            ArcsCondenses().swap(sortants[c]);
+            ArcsCondenses().swap(entrants[c]);
+            representants[c] = AUCUNE;
+            tailles[c] = 0;
+            libres.push_back(c);
+            --nbComposantes;
+        }
+        return garde;
+    }
+
+    /**
+    * \fn void ComposantesDynamiques::scinder(std::uint32_t composante)
+    * \brief Relance l'algorithme de Tarjan (itératif) sur les seuls membres d'une composante dont un arc interne a été
+    * retiré.  Si elle se scinde, la plus grande partie garde l'identifiant et ses membres; seuls les arcs des membres des
+    * autres parties sont reportés dans le graphe condensé.  Les parties prennent la place de la composante dans l'ordre,
+    * en ordre topologique.
+    * \param[in] composante la composante à vérifier
+    */
+    void ComposantesDynamiques::scinder(std::uint32_t composante) {
+        const auto gen = nouvelleGeneration();
+        std::vector<std::uint32_t> membresComposante;
+        membresComposante.reserve(tailles[composante]);
+        auto sommet = representants[composante];
+        do {
+            membresComposante.push_back(sommet);
+            marquesSommets[sommet] = gen;
+            indices[sommet] = AUCUNE;
+            sommet = suivants[sommet];
+        } while (sommet != representants[composante]);
+
+        std::vector<std::vector<std::uint32_t> > parties;		// en ordre topologique inverse
+        std::vector<std::pair<std::uint32_t, size_t> > pile;		// sommet, prochain successeur à examiner
+        std::vector<std::uint32_t> pileTarjan;
+        std::uint32_t compteur = 0;
+        for (auto depart: membresComposante) {
+            if (indices[depart] != AUCUNE) continue;
+            indices[depart] = basses[depart] = compteur++;
+            pileTarjan.push_back(depart);
+            pile.emplace_back(depart, 0);
+            while (!pile.empty()) {
+                auto courant = pile.back().first;
+                if (pile.back().second < successeurs[courant].size()) {
+                    auto voisin = successeurs[courant][pile.back().second++];
+                    if (marquesSommets[voisin] != gen) continue;
+                    if (indices[voisin] == AUCUNE) {
+                        indices[voisin] = basses[voisin] = compteur++;
+                        pileTarjan.push_back(voisin);
+                        pile.emplace_back(voisin, 0);
+                    }
+                    else if (indices[voisin] != TERMINE) basses[courant] = std::min(basses[courant], indices[voisin]);
+                    continue;
+                }
+                pile.pop_back();
+                if (!pile.empty()) basses[pile.back().first] = std::min(basses[pile.back().first], basses[courant]);
+                if (basses[courant] == indices[courant]) {
+                    parties.emplace_back();
+                    std::uint32_t membre;
+                    do {
+                        membre = pileTarjan.back();
+                        pileTarjan.pop_back();
+                        indices[membre] = TERMINE;
+                        parties.back().push_back(membre);
+                    } while (membre != courant);
+                }
+            }
+        }
+        if (parties.size() == 1) return;
+
+        size_t plusGrande = 0;
+        for (size_t i = 1; i < parties.size(); ++i) if (parties[i].size() > parties[plusGrande].size()) plusGrande = i;
+        std::vector<std::uint32_t> identifiants(parties.size());
+        for (size_t i = 0; i < parties.size(); ++i) {
+            auto identifiant = i == plusGrande ? composante : nouvelIdentifiant();
+            const auto& partie = parties[i];
+            for (size_t k = 0; k < partie.size(); ++k) {
+                composantes[partie[k]] = identifiant;
+                suivants[partie[k]] = partie[(k + 1) % partie.size()];
+            }
+            representants[identifiant] = partie.front();
+            tailles[identifiant] = static_cast<std::uint32_t>(partie.size());
+            identifiants[i] = identifiant;
+        }
+        nbComposantes += parties.size() - 1;
+
+        //Seuls les arcs des membres renumérotés changent d'arc condensé; ceux de la plus grande partie restent
+        for (auto membre: membresComposante) {
+            const auto partie = composantes[membre];
+            if (partie == composante) continue;
+            for (auto voisin: successeurs[membre]) {
+                auto ancienne = marquesSommets[voisin] == gen ? composante : composantes[voisin];
+                if (ancienne != composante) delier(composante, ancienne, 1);
+                if (composantes[voisin] != partie) relier(partie, composantes[voisin], 1);
+            }
+            for (auto voisin: predecesseurs[membre]) {
+                if (marquesSommets[voisin] == gen && composantes[voisin] != composante) continue;	// compté par ses successeurs
+                if (marquesSommets[voisin] != gen) delier(composantes[voisin], composante, 1);
+                relier(composantes[voisin], partie, 1);
+            }
+        }
+
+        //Les parties remplacent la composante dans l'ordre: les places vides qui la suivent sont utilisées d'abord
+        const size_t rang = rangs[composante];
+        size_t libresApres = 0;
+        while (libresApres < parties.size() - 1 && rang + 1 + libresApres < ordre.size() && ordre[rang + 1 + libresApres] == AUCUNE)
+            ++libresApres;
+        const size_t manquantes = parties.size() - 1 - libresApres;
+        ordre.insert(ordre.begin() + static_cast<std::ptrdiff_t>(rang + 1 + libresApres), manquantes, AUCUNE);
+        for (size_t j = 0; j < parties.size(); ++j) {
+            auto identifiant = identifiants[parties.size() - 1 - j];
+            ordre[rang + j] = identifiant;
+            rangs[identifiant] = static_cast<std::uint32_t>(rang + j);
+        }
+        if (manquantes > 0) {
+            for (size_t position = rang + parties.size(); position < ordre.size(); ++position)
+                if (ordre[position] != AUCUNE) rangs[ordre[position]] = static_cast<std::uint32_t>(position);
+        }
+    }
+
+    /**
+    * \fn void ComposantesDynamiques::compacter()
+    * \brief Retire les places vides de l'ordre (laissées par les fusions) et renumérote les rangs
+    */
+    void ComposantesDynamiques::compacter() {
+        size_t position = 0;
+        for (auto c: ordre) {
+            if (c == AUCUNE) continue;
+            rangs[c] = static_cast<std::uint32_t>(position);
+            ordre[position++] = c;
+        }
+        ordre.resize(position);
+    }
+
+}//Fin du namespace
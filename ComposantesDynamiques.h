@@ -0,0 +1,118 @@
+/**
+ * \file ComposantesDynamiques.h
+ * \brief Composantes fortement connexes tenues à jour sous l'ajout et le retrait d'arcs.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "GrapheCompact.h"
+
+#ifndef _COMPOSANTESDYNAMIQUES__H
+#define _COMPOSANTESDYNAMIQUES__H
+
+namespace TP2
+{
+
+/**
+ * \class ComposantesDynamiques
+ * \brief Les composantes fortement connexes d'un graphe dont les arcs changent, avec le graphe condensé (chaque arc
+ *  entre deux composantes compte les arcs qui le forment) et un ordre topologique de ses composantes.
+ *
+ *  Ajout de u -> v entre deux composantes a et b: si a précède déjà b dans l'ordre, rien d'autre ne change.  Sinon,
+ *  l'ordre est réparé à la Pearce-Kelly: seules les composantes de rang compris entre ceux de b et de a sont visitées,
+ *  vers l'avant depuis b et vers l'arrière depuis a, puis leurs rangs sont réattribués.  Si b mène à a, les composantes
+ *  d'un chemin de b à a forment un cycle et sont fusionnées (les membres de la plus petite sont renumérotés).
+ *
+ *  Retrait de u -> v: entre deux composantes, seul le compte de l'arc condensé change.  Dans une même composante, elle
+ *  reste entière si u mène encore à v (recherche bidirectionnelle limitée à la composante).  Sinon l'algorithme de
+ *  Tarjan est relancé sur ses seuls membres; ses parties prennent sa place dans l'ordre (les rangs suivants sont
+ *  décalés) et seuls les arcs des parties autres que la plus grande sont reportés dans le graphe condensé.
+ *
+ *  Entre deux mises à jour, la composante d'un sommet se lit en O(1).  Les identifiants de composante sont stables tant
+ *  que la composante ne change pas, mais ne sont pas contigus: numeroter() donne une numérotation contiguë.
+ */
+class ComposantesDynamiques
+{
+public:
+
+	// Construit une structure vide (taille() == 0)
+	ComposantesDynamiques();
+
+	// Calcule les composantes du graphe (Tarjan) et copie ses arcs. O(V + E).
+	explicit ComposantesDynamiques(const GrapheCompact& graphe);
+
+	// Retourne le nombre de sommets
+	size_t taille() const { return composantes.size(); }
+
+	// Retourne le nombre de composantes
+	size_t nombre() const { return nbComposantes; }
+
+	// Retourne l'identifiant de la composante d'un sommet (sommet < taille()). O(1).
+	size_t composante(size_t sommet) const { return composantes[sommet]; }
+
+	// Retourne true si a et b sont dans la même composante, c'est-à-dire mutuellement atteignables. O(1).
+	bool memeComposante(size_t a, size_t b) const { return composantes[a] == composantes[b]; }
+
+	// Retourne les sommets d'une composante, donnée par son identifiant
+	// Exception logic_error si composante n'est pas l'identifiant d'une composante
+	std::vector<size_t> membres(size_t composante) const;
+
+	// Retourne les composantes numérotées comme GrapheCompact::composantesFortementConnexes (ordre topologique inverse)
+	Composantes numeroter() const;
+
+	// Ajoute l'arc source -> destination et met les composantes à jour
+	// Exception logic_error si source ou destination supérieur à taille()
+	void ajouterArc(size_t source, size_t destination);
+
+	// Retire l'arc source -> destination et met les composantes à jour
+	// Exception logic_error si source ou destination supérieur à taille()
+	// Exception logic_error si l'arc n'existe pas
+	void enleverArc(size_t source, size_t destination);
+
+private:
+
+	static constexpr std::uint32_t AUCUNE = 0xFFFFFFFFu;
+
+	using ArcsCondenses = std::unordered_map<std::uint32_t, std::uint32_t>;	// composante voisine -> nombre d'arcs
+
+	// Par sommet
+	std::vector<std::vector<std::uint32_t> > successeurs, predecesseurs;
+	std::vector<std::uint32_t> composantes;
+	std::vector<std::uint32_t> suivants;		// les membres d'une composante forment une liste circulaire
+
+	// Par identifiant de composante (AUCUNE comme représentant: identifiant libre)
+	std::vector<std::uint32_t> representants;
+	std::vector<std::uint32_t> tailles;
+	std::vector<std::uint32_t> rangs;			// position dans ordre
+	std::vector<ArcsCondenses> sortants, entrants;
+	std::vector<std::uint32_t> libres;
+
+	std::vector<std::uint32_t> ordre;			// les composantes en ordre topologique, AUCUNE pour une place vide
+	size_t nbComposantes;
+
+	// Tableaux de travail, remis à zéro par estampilles
+	std::vector<std::uint32_t> marquesAvant, marquesArriere;	// par composante
+	std::vector<std::uint32_t> marquesSommets, marquesRetour, indices, basses;	// par sommet
+	std::uint32_t generation;
+
+	std::uint32_t nouvelleGeneration();
+	std::uint32_t nouvelIdentifiant();
+	void relier(std::uint32_t source, std::uint32_t destination, std::uint32_t nombre);
+	void delier(std::uint32_t source, std::uint32_t destination, std::uint32_t nombre);
+	bool relies(std::uint32_t composante, std::uint32_t source, std::uint32_t destination);
+	void reordonner(std::uint32_t a, std::uint32_t b);
+	std::uint32_t fusionner(const std::vector<std::uint32_t>& cycle, std::uint32_t gen);
+	void scinder(std::uint32_t composante);
+	void compacter();
+};
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,651 @@
+/**
+ * \file ComposantesParalleles.cpp
+ * \brief Implémentation des composantes fortement connexes parallèles (élagage, avant-arrière, Tarjan restreint).
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "ComposantesParalleles.h"
+#include "Parallele.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace TP2
+{
+    namespace
+    {
+        const std::uint32_t CLASSE = 0xFFFFFFFFu;		// groupe d'un sommet dont la composante est connue
+        const std::uint32_t NON_VISITE = 0xFFFFFFFFu;
+        const size_t SEUIL_AVANT_ARRIERE = 1 << 12;		// taille minimale d'un groupe découpé par avant-arrière
+        const size_t SEUIL_PARCOURS_PARALLELE = 1 << 16;	// taille minimale d'un groupe parcouru sur plusieurs fils
+        const size_t NB_CANDIDATS_PIVOT = 8;			// sommets tirés au hasard parmi lesquels le pivot est choisi
+        const std::uint32_t ECHECS_AVANT_TARJAN = 2;	// passes déséquilibrées de suite avant de passer la main à Tarjan
+        const size_t TAILLE_BLOC = 1 << 14;				// sommets par tâche des boucles parallèles
+        const size_t LOT = 256;							// sommets développés entre deux partages d'un parcours
+
+        /**
+        * \struct BitsAtomiques
+        * \brief Un bit par sommet, posé et effacé de façon atomique
+        */
+        struct BitsAtomiques
+        {
+            std::vector<std::atomic<std::uint64_t> > mots;
+
+            explicit BitsAtomiques(size_t taille) : mots((taille + 63) / 64) {
+                for (auto& mot: mots) mot.store(0, std::memory_order_relaxed);
+            }
+
+            // Pose le bit; retourne true s'il ne l'était pas encore (le fil appelant a gagné le sommet).  Une lecture simple
+            // précède l'écriture atomique, qui n'est tentée que pour un bit encore libre.
+            bool marquer(std::uint32_t sommet) {
+                auto bit = std::uint64_t(1) << (sommet & 63);
+                auto& mot = mots[sommet >> 6];
+                if (mot.load(std::memory_order_relaxed) & bit) return false;
+                return !(mot.fetch_or(bit, std::memory_order_relaxed) & bit);
+            }
+
+            // Comme marquer, sans écriture atomique: seulement si aucun autre fil n'utilise les bits
+            bool marquerSeul(std::uint32_t sommet) {
+                auto bit = std::uint64_t(1) << (sommet & 63);
+                auto& mot = mots[sommet >> 6];
+                auto valeur = mot.load(std::memory_order_relaxed);
+                if (valeur & bit) return false;
+                mot.store(valeur | bit, std::memory_order_relaxed);
+                return true;
+            }
+
+            bool marque(std::uint32_t sommet) const {
+                return (mots[sommet >> 6].load(std::memory_order_relaxed) >> (sommet & 63)) & 1;
+            }
+
+            // Efface le mot entier du sommet: seulement si tous les bits posés du mot doivent l'être
+            void effacerMot(std::uint32_t sommet) {
+                mots[sommet >> 6].store(0, std::memory_order_relaxed);
+            }
+        };
+
+        /**
+        * \struct Groupe
+        * \brief Des sommets qu'aucune composante ne relie au reste, et la première des positions qui leur reviennent
+        */
+        struct Groupe
+        {
+            std::uint32_t numero;
+            std::uint32_t debut;
+            std::vector<std::uint32_t> sommets;		// par numéro croissant
+            std::uint32_t echecs = 0;				// passes avant-arrière de suite qui l'ont laissé presque entier
+        };
+
+        /**
+        * \class Decomposition
+        * \brief L'état d'un calcul: le groupe de chaque sommet et, une fois classé, la position de sa composante
+        */
+        class Decomposition
+        {
+        public:
+            Decomposition(const GrapheCompact& graphe, unsigned nbFils);
+            Composantes calculer();
+
+        private:
+            const GrapheCompact& graphe;
+            unsigned nbFils;
+            EquipeFils equipe;						// les fils, créés une fois pour tout le calcul
+            std::mt19937_64 alea;					// tirage des pivots, à graine fixe
+            std::vector<std::uint32_t> groupes;		// par sommet, CLASSE une fois la composante connue
+            std::vector<std::uint32_t> positions;	// par sommet: la position de sa composante
+            std::vector<std::uint32_t> ordres, liens;	// Tarjan restreint (chaque groupe n'écrit que ses sommets)
+            std::vector<std::uint8_t> surPile;
+            BitsAtomiques avant, arriere;
+            std::uint32_t nbGroupes;
+
+            template <typename Travail>
+            void pourBlocs(size_t taille, Travail travail);
+            Groupe elaguer();
+            void avantArriere(const Groupe& groupe, std::vector<Groupe>& nouveaux);
+            std::uint32_t choisirPivot(const Groupe& groupe);
+            void atteindre(std::uint32_t depart, const Groupe& groupe, bool versAvant, BitsAtomiques& vus);
+            void tarjan(const Groupe& groupe);
+        };
+
+        Decomposition::Decomposition(const GrapheCompact& graphe, unsigned nbFils)
+            : graphe(graphe), nbFils(nombreFils(nbFils, std::numeric_limits<unsigned>::max())), equipe(this->nbFils), alea(0x5CC),
+              groupes(graphe.taille(), 0),
+              positions(graphe.taille(), 0), ordres(graphe.taille()), liens(graphe.taille()), surPile(graphe.taille(), 0),
+              avant(graphe.taille()), arriere(graphe.taille()), nbGroupes(1) {
+        }
+
+        /**
+        * \fn void Decomposition::pourBlocs(size_t taille, Travail travail)
+        * \brief Exécute travail(debut, fin, bloc) sur les blocs de TAILLE_BLOC indices de [0, taille), répartis entre les
+        * fils de l'équipe; un seul bloc s'exécute dans le fil appelant, sans réveiller les autres
+        */
+        template <typename Travail>
+        void Decomposition::pourBlocs(size_t taille, Travail travail) {
+            const size_t nbBlocs = (taille + TAILLE_BLOC - 1) / TAILLE_BLOC;
+            equipe.repartir(nbBlocs, [&](size_t bloc, unsigned) {
+                travail(bloc * TAILLE_BLOC, std::min(taille, (bloc + 1) * TAILLE_BLOC), bloc);
+            });
+        }
+
+        /**
+        * \fn Groupe Decomposition::elaguer()
+        * \brief Retire par rondes les sommets sans arc sortant (premières positions) ou sans arc entrant (dernières
+        * positions) parmi les sommets restants.  Les sommets d'une même ronde ne sont pas reliés entre eux, et chacun ne
+        * touche que des sommets retirés avant lui du même côté: l'ordre des positions respecte les arcs.  Quand plus aucun
+        * sommet ne peut l'être, les paires de sommets dont chacun n'a pour successeur (ou pour prédécesseur) restant que
+        * l'autre sont retirées de même: chaque paire est une composante de deux sommets, puits (ou source) du reste.  Seuls
+        * les sommets dont un compteur est tombé à 1 sont réexaminés, et un petit front est défait sans rondes, de sorte
+        * qu'une chaîne de sommets ou de 2-cycles est défaite en O(V + E).
+        * \return Groupe les sommets restants, avec les positions du milieu
+        */
+        Groupe Decomposition::elaguer() {
+            const size_t nbSommets = graphe.taille();
+            std::vector<std::atomic<std::uint32_t> > sortants(nbSommets), entrants(nbSommets);
+            auto nbBlocs = (nbSommets + TAILLE_BLOC - 1) / TAILLE_BLOC;
+            std::vector<std::vector<std::uint32_t> > trouves(nbBlocs), aRevoir(nbBlocs);
+            pourBlocs(nbSommets, [&](size_t debut, size_t fin, size_t bloc) {
+                for (auto sommet = static_cast<std::uint32_t>(debut); sommet < fin; ++sommet) {
+                    std::uint32_t nbSortants = 0, nbEntrants = 0;
+                    for (auto arc = graphe.debutArcs(sommet); arc < graphe.finArcs(sommet); ++arc) nbSortants += graphe.destination(arc) != sommet;
+                    for (auto arc = graphe.debutArcsEntrants(sommet); arc < graphe.finArcsEntrants(sommet); ++arc) nbEntrants += graphe.source(arc) != sommet;
+                    sortants[sommet].store(nbSortants, std::memory_order_relaxed);
+                    entrants[sommet].store(nbEntrants, std::memory_order_relaxed);
+                    if (nbSortants == 0 || nbEntrants == 0) trouves[bloc].push_back(sommet);
+                    else if (nbSortants == 1 || nbEntrants == 1) aRevoir[bloc].push_back(sommet);
+                }
+            });
+
+            //Les listes de chaque bloc, réunies par numéro croissant: le résultat ne dépend pas du nombre de fils
+            auto rassembler = [](std::vector<std::vector<std::uint32_t> >& blocs, std::vector<std::uint32_t>& sommets) {
+                sommets.clear();
+                for (auto& bloc: blocs) {
+                    sommets.insert(sommets.end(), bloc.begin(), bloc.end());
+                    bloc.clear();
+                }
+                if (!std::is_sorted(sommets.begin(), sommets.end())) std::sort(sommets.begin(), sommets.end());
+                sommets.erase(std::unique(sommets.begin(), sommets.end()), sommets.end());
+            };
+
+            //Les voisins restants des sommets retirés perdent un arc; à 0 ils seront retirés, à 1 réexaminés en paire
+            auto retirer = [&](const std::vector<std::uint32_t>& retires) {
+                trouves.resize(std::max(trouves.size(), (retires.size() + TAILLE_BLOC - 1) / TAILLE_BLOC));
+                aRevoir.resize(trouves.size());
+                pourBlocs(retires.size(), [&](size_t debut, size_t fin, size_t bloc) {
+                    for (auto i = debut; i < fin; ++i) {
+                        auto sommet = retires[i];
+                        for (auto arc = graphe.debutArcs(sommet); arc < graphe.finArcs(sommet); ++arc) {
+                            auto voisin = static_cast<std::uint32_t>(graphe.destination(arc));
+                            if (voisin == sommet || groupes[voisin] == CLASSE) continue;
+                            auto avant = entrants[voisin].fetch_sub(1, std::memory_order_relaxed);
+                            if (avant == 1) trouves[bloc].push_back(voisin);
+                            else if (avant == 2) aRevoir[bloc].push_back(voisin);
+                        }
+                        for (auto arc = graphe.debutArcsEntrants(sommet); arc < graphe.finArcsEntrants(sommet); ++arc) {
+                            auto voisin = static_cast<std::uint32_t>(graphe.source(arc));
+                            if (voisin == sommet || groupes[voisin] == CLASSE) continue;
+                            auto avant = sortants[voisin].fetch_sub(1, std::memory_order_relaxed);
+                            if (avant == 1) trouves[bloc].push_back(voisin);
+                            else if (avant == 2) aRevoir[bloc].push_back(voisin);
+                        }
+                    }
+                });
+            };
+
+            //Le seul successeur (versAvant) ou prédécesseur restant d'un sommet dont le compteur vaut 1
+            auto seulVoisin = [&](std::uint32_t sommet, bool versAvant) {
+                if (versAvant) {
+                    for (auto arc = graphe.debutArcs(sommet); arc < graphe.finArcs(sommet); ++arc) {
+                        auto voisin = static_cast<std::uint32_t>(graphe.destination(arc));
+                        if (voisin != sommet && groupes[voisin] != CLASSE) return voisin;
+                    }
+                }
+                else {
+                    for (auto arc = graphe.debutArcsEntrants(sommet); arc < graphe.finArcsEntrants(sommet); ++arc) {
+                        auto voisin = static_cast<std::uint32_t>(graphe.source(arc));
+                        if (voisin != sommet && groupes[voisin] != CLASSE) return voisin;
+                    }
+                }
+                return NON_VISITE;
+            };
+            auto enPaire = [&](std::uint32_t sommet, std::vector<std::atomic<std::uint32_t> >& compteurs, bool versAvant) {
+                if (compteurs[sommet].load(std::memory_order_relaxed) != 1) return NON_VISITE;
+                auto autre = seulVoisin(sommet, versAvant);
+                if (autre == NON_VISITE || compteurs[autre].load(std::memory_order_relaxed) != 1 || seulVoisin(autre, versAvant) != sommet) return NON_VISITE;
+                return autre;
+            };
+
+            std::vector<std::uint32_t> ronde, candidats;
+            std::vector<std::vector<std::pair<std::uint64_t, bool> > > paires;	// (min << 32 | max, puits)
+            std::vector<std::pair<std::uint64_t, bool> > toutesPaires;
+            rassembler(trouves, ronde);
+
+            std::uint32_t bas = 0, haut = static_cast<std::uint32_t>(nbSommets);
+
+            //Un front d'au plus un bloc est défait par le fil appelant, un sommet ou une paire à la fois et sans rondes: un
+            //maillon de chaîne n'y coûte que ses arcs.  Le front qui dépasse un bloc retourne aux rondes.
+            std::vector<std::uint32_t> front;
+            auto enlever = [&](std::uint32_t sommet) {
+                for (auto arc = graphe.debutArcs(sommet); arc < graphe.finArcs(sommet); ++arc) {
+                    auto voisin = static_cast<std::uint32_t>(graphe.destination(arc));
+                    if (voisin != sommet && groupes[voisin] != CLASSE && entrants[voisin].fetch_sub(1, std::memory_order_relaxed) <= 2)
+                        front.push_back(voisin);
+                }
+                for (auto arc = graphe.debutArcsEntrants(sommet); arc < graphe.finArcsEntrants(sommet); ++arc) {
+                    auto voisin = static_cast<std::uint32_t>(graphe.source(arc));
+                    if (voisin != sommet && groupes[voisin] != CLASSE && sortants[voisin].fetch_sub(1, std::memory_order_relaxed) <= 2)
+                        front.push_back(voisin);
+                }
+            };
+            auto elaguerSeul = [&]() {
+                front.assign(candidats.rbegin(), candidats.rend());
+                front.insert(front.end(), ronde.rbegin(), ronde.rend());
+                while (!front.empty() && front.size() <= TAILLE_BLOC) {
+                    auto sommet = front.back();
+                    front.pop_back();
+                    if (groupes[sommet] == CLASSE) continue;
+                    auto autre = NON_VISITE;
+                    if (sortants[sommet].load(std::memory_order_relaxed) == 0) positions[sommet] = bas++;
+                    else if (entrants[sommet].load(std::memory_order_relaxed) == 0) positions[sommet] = --haut;
+                    else if ((autre = enPaire(sommet, sortants, true)) != NON_VISITE) {
+                        positions[sommet] = positions[autre] = bas;
+                        bas += 2;
+                    }
+                    else if ((autre = enPaire(sommet, entrants, false)) != NON_VISITE) {
+                        haut -= 2;
+                        positions[sommet] = positions[autre] = haut;
+                    }
+                    else continue;
+                    groupes[sommet] = CLASSE;
+                    if (autre != NON_VISITE) groupes[autre] = CLASSE;
+                    enlever(sommet);
+                    if (autre != NON_VISITE) enlever(autre);
+                }
+                for (auto sommet: front) {
+                    if (groupes[sommet] == CLASSE) continue;
+                    bool seul = sortants[sommet].load(std::memory_order_relaxed) == 0 || entrants[sommet].load(std::memory_order_relaxed) == 0;
+                    (seul ? trouves : aRevoir).front().push_back(sommet);
+                }
+                front.clear();
+            };
+
+            while (true) {
+                size_t enAttente = ronde.size();
+                for (const auto& bloc: aRevoir) enAttente += bloc.size();
+                if (enAttente == 0) break;
+                if (enAttente <= TAILLE_BLOC) {
+                    rassembler(aRevoir, candidats);
+                    elaguerSeul();
+                    rassembler(trouves, ronde);
+                    continue;
+                }
+
+                if (ronde.empty()) {
+                    //Aucun sommet seul à retirer: les paires, parmi les sommets dont un compteur est tombé à 1
+                    rassembler(aRevoir, candidats);
+                    paires.assign((candidats.size() + TAILLE_BLOC - 1) / TAILLE_BLOC, {});
+                    pourBlocs(candidats.size(), [&](size_t debut, size_t fin, size_t bloc) {
+                        for (auto i = debut; i < fin; ++i) {
+                            auto sommet = candidats[i];
+                            if (groupes[sommet] == CLASSE) continue;
+                            bool puits = true;
+                            auto autre = enPaire(sommet, sortants, true);
+                            if (autre == NON_VISITE) {
+                                puits = false;
+                                autre = enPaire(sommet, entrants, false);
+                            }
+                            if (autre != NON_VISITE)
+                                paires[bloc].emplace_back(std::uint64_t(std::min(sommet, autre)) << 32 | std::max(sommet, autre), puits);
+                        }
+                    });
+                    toutesPaires.clear();
+                    for (auto& bloc: paires) toutesPaires.insert(toutesPaires.end(), bloc.begin(), bloc.end());
+                    std::sort(toutesPaires.begin(), toutesPaires.end());
+                    toutesPaires.erase(std::unique(toutesPaires.begin(), toutesPaires.end(),
+                                                   [](const auto& a, const auto& b) { return a.first == b.first; }), toutesPaires.end());
+
+                    //Une paire vue depuis ses deux sommets n'est gardée qu'une fois; un sommet n'est que d'une paire
+                    ronde.clear();
+                    for (const auto& paire: toutesPaires) {
+                        auto u = static_cast<std::uint32_t>(paire.first >> 32), v = static_cast<std::uint32_t>(paire.first);
+                        std::uint32_t position;
+                        if (paire.second) {
+                            position = bas;
+                            bas += 2;
+                        }
+                        else {
+                            haut -= 2;
+                            position = haut;
+                        }
+                        groupes[u] = groupes[v] = CLASSE;
+                        positions[u] = positions[v] = position;
+                        ronde.push_back(u);
+                        ronde.push_back(v);
+                    }
+                    retirer(ronde);
+                    rassembler(trouves, ronde);
+                    continue;
+                }
+
+                std::uint32_t nbSources = 0;
+                for (auto sommet: ronde) nbSources += sortants[sommet].load(std::memory_order_relaxed) != 0;
+                haut -= nbSources;
+                auto source = haut;
+                for (auto sommet: ronde) {
+                    groupes[sommet] = CLASSE;
+                    positions[sommet] = sortants[sommet].load(std::memory_order_relaxed) == 0 ? bas++ : source++;
+                }
+                retirer(ronde);
+                rassembler(trouves, ronde);
+            }
+
+            Groupe reste{0, bas, {}};
+            reste.sommets.reserve(haut - bas);
+            for (std::uint32_t sommet = 0; sommet < nbSommets; ++sommet)
+                if (groupes[sommet] != CLASSE) reste.sommets.push_back(sommet);
+            return reste;
+        }
+
+        /**
+        * \fn std::uint32_t Decomposition::choisirPivot(const Groupe& groupe)
+        * \brief Parmi NB_CANDIDATS_PIVOT sommets du groupe tirés au hasard, celui qui maximise (degré sortant + 1) x
+        * (degré entrant + 1), le premier tiré à égalité: il a le plus de chances d'appartenir à la plus grande composante.
+        * Le tirage empêche un graphe (une chaîne de petites composantes, par exemple) de faire choisir à chaque passe un
+        * pivot qui ne détache qu'une petite composante; la graine est fixe, et le résultat reproductible.
+        */
+        std::uint32_t Decomposition::choisirPivot(const Groupe& groupe) {
+            std::uniform_int_distribution<size_t> tirage(0, groupe.sommets.size() - 1);
+            std::uint64_t meilleurScore = 0;
+            std::uint32_t meilleur = NON_VISITE;
+            for (size_t i = 0; i < NB_CANDIDATS_PIVOT; ++i) {
+                auto sommet = groupe.sommets[tirage(alea)];
+                std::uint64_t score = (graphe.finArcs(sommet) - graphe.debutArcs(sommet) + 1)
+                                    * static_cast<std::uint64_t>(graphe.finArcsEntrants(sommet) - graphe.debutArcsEntrants(sommet) + 1);
+                if (meilleur == NON_VISITE || score > meilleurScore) {
+                    meilleurScore = score;
+                    meilleur = sommet;
+                }
+            }
+            return meilleur;
+        }
+
+        /**
+        * \fn void Decomposition::atteindre(std::uint32_t depart, const Groupe& groupe, bool versAvant, BitsAtomiques& vus)
+        * \brief Marque dans vus les sommets du groupe atteints depuis depart (versAvant) ou qui l'atteignent.  Un groupe de
+        * moins de SEUIL_PARCOURS_PARALLELE sommets est parcouru par le fil appelant seul.  Sinon, chaque fil
+        * développe sa propre pile par lots et en dépose la moitié dans sa réserve quand elle grossit; un fil sans travail
+        * vide sa réserve puis vole la moitié de celle d'un autre.  Le compteur enAttente (sommets marqués non encore
+        * développés, surestimé entre deux lots mais jamais sous-estimé) dit quand le parcours est fini.
+        */
+        void Decomposition::atteindre(std::uint32_t depart, const Groupe& groupe, bool versAvant, BitsAtomiques& vus) {
+            const bool seul = nbFils == 1 || groupe.sommets.size() < SEUIL_PARCOURS_PARALLELE;
+            const auto numero = groupe.numero;
+            auto developper = [&](std::uint32_t sommet, std::vector<std::uint32_t>& pile) {
+                size_t nbTrouves = 0;
+                auto visiter = [&](size_t voisin) {
+                    auto v = static_cast<std::uint32_t>(voisin);
+                    if (groupes[v] == numero && (seul ? vus.marquerSeul(v) : vus.marquer(v))) {
+                        pile.push_back(v);
+                        ++nbTrouves;
+                    }
+                };
+                if (versAvant) for (auto arc = graphe.debutArcs(sommet); arc < graphe.finArcs(sommet); ++arc) visiter(graphe.destination(arc));
+                else for (auto arc = graphe.debutArcsEntrants(sommet); arc < graphe.finArcsEntrants(sommet); ++arc) visiter(graphe.source(arc));
+                return nbTrouves;
+            };
+
+            vus.marquer(depart);
+            if (seul) {
+                std::vector<std::uint32_t> pile{depart};
+                while (!pile.empty()) {
+                    auto sommet = pile.back();
+                    pile.pop_back();
+                    developper(sommet, pile);
+                }
+                return;
+            }
+
+            /**
+            * \struct Reserve
+            * \brief Les sommets qu'un fil met à la disposition des autres, sur sa propre ligne de cache
+            */
+            struct alignas(64) Reserve
+            {
+                std::mutex verrou;
+                std::vector<std::uint32_t> sommets;
+            };
+            std::vector<Reserve> reserves(nbFils);
+            reserves[0].sommets.push_back(depart);
+            std::atomic<size_t> enAttente(1);
+
+            equipe.repartir(nbFils, [&](size_t moi, unsigned) {
+                std::vector<std::uint32_t> pile;
+                while (true) {
+                    for (size_t i = 0; i < nbFils && pile.empty(); ++i) {
+                        auto& reserve = reserves[(moi + i) % nbFils];
+                        std::lock_guard<std::mutex> garde(reserve.verrou);
+                        auto nb = i == 0 ? std::min(reserve.sommets.size(), LOT) : (reserve.sommets.size() + 1) / 2;
+                        pile.assign(reserve.sommets.end() - nb, reserve.sommets.end());
+                        reserve.sommets.resize(reserve.sommets.size() - nb);
+                    }
+                    if (pile.empty()) {
+                        if (enAttente.load(std::memory_order_acquire) == 0) return;
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    size_t nbDeveloppes = 0, nbTrouves = 0;
+                    while (!pile.empty() && nbDeveloppes < LOT) {
+                        auto sommet = pile.back();
+                        pile.pop_back();
+                        nbTrouves += developper(sommet, pile);
+                        ++nbDeveloppes;
+                    }
+                    if (pile.size() > 2 * LOT) {
+                        auto moitie = pile.begin() + pile.size() / 2;
+                        std::lock_guard<std::mutex> garde(reserves[moi].verrou);
+                        reserves[moi].sommets.insert(reserves[moi].sommets.end(), pile.begin(), moitie);
+                        pile.erase(pile.begin(), moitie);
+                    }
+                    enAttente.fetch_add(nbTrouves, std::memory_order_release);
+                    enAttente.fetch_sub(nbDeveloppes, std::memory_order_acq_rel);
+                }
+            });
+        }
+
+        /**
+        * \fn void Decomposition::avantArriere(const Groupe& groupe, std::vector<Groupe>& nouveaux)
+        * \brief Classe la composante d'un pivot et partage le reste du groupe en F \ B, reste et B \ F.  La partition est
+        * stable (comptage par bloc puis placement).  Les bits de visite sont ensuite effacés par mots entiers: les grands
+        * groupes sont traités un à la fois, aucun autre sommet n'a donc de bit posé.  Une passe qui laisse plus des 7/8
+        * du groupe dans une seule partie n'a presque rien classé: cette partie compte un échec de plus, et sera confiée
+        * à Tarjan après ECHECS_AVANT_TARJAN échecs de suite plutôt que découpée à nouveau.
+        */
+        void Decomposition::avantArriere(const Groupe& groupe, std::vector<Groupe>& nouveaux) {
+            auto pivot = choisirPivot(groupe);
+            atteindre(pivot, groupe, true, avant);
+            atteindre(pivot, groupe, false, arriere);
+
+            //Catégories: 0 = F \ B, 1 = composante du pivot, 2 = reste, 3 = B \ F (l'ordre des positions)
+            auto categorie = [&](std::uint32_t sommet) {
+                bool f = avant.marque(sommet), b = arriere.marque(sommet);
+                return f ? (b ? 1 : 0) : (b ? 3 : 2);
+            };
+            const auto& sommets = groupe.sommets;
+            auto nbBlocs = (sommets.size() + TAILLE_BLOC - 1) / TAILLE_BLOC;
+            std::vector<std::array<size_t, 4> > comptes(nbBlocs);
+            pourBlocs(sommets.size(), [&](size_t debut, size_t fin, size_t bloc) {
+                comptes[bloc].fill(0);
+                for (auto i = debut; i < fin; ++i) ++comptes[bloc][categorie(sommets[i])];
+            });
+            std::array<size_t, 4> tailles{};
+            for (auto& compte: comptes)
+                for (int c = 0; c < 4; ++c) {
+                    auto nb = compte[c];
+                    compte[c] = tailles[c];		// devient la place du bloc dans sa catégorie
+                    tailles[c] += nb;
+                }
+
+            std::array<Groupe, 4> parties;
+            auto debut = groupe.debut;
+            for (int c = 0; c < 4; ++c) {
+                parties[c].numero = c == 1 ? CLASSE : nbGroupes++;
+                parties[c].debut = debut;
+                if (c != 1) parties[c].sommets.resize(tailles[c]);
+                debut += static_cast<std::uint32_t>(tailles[c]);
+            }
+            pourBlocs(sommets.size(), [&](size_t debut, size_t fin, size_t bloc) {
+                auto places = comptes[bloc];
+                for (auto i = debut; i < fin; ++i) {
+                    auto sommet = sommets[i];
+                    auto c = categorie(sommet);
+                    groupes[sommet] = parties[c].numero;
+                    if (c == 1) positions[sommet] = parties[1].debut;
+                    else parties[c].sommets[places[c]++] = sommet;
+                }
+            });
+            pourBlocs(sommets.size(), [&](size_t debut, size_t fin, size_t) {
+                for (auto i = debut; i < fin; ++i) {
+                    avant.effacerMot(sommets[i]);
+                    arriere.effacerMot(sommets[i]);
+                }
+            });
+            for (int c: {0, 2, 3})
+                if (parties[c].sommets.size() > sommets.size() / 8 * 7) parties[c].echecs = groupe.echecs + 1;
+            for (int c: {0, 2, 3})
+                if (!parties[c].sommets.empty()) nouveaux.push_back(std::move(parties[c]));
+        }
+
+        /**
+        * \fn void Decomposition::tarjan(const Groupe& groupe)
+        * \brief Tarjan itératif restreint aux sommets du groupe (voir GrapheCompact::composantesFortementConnexes): les
+        * composantes fermées reçoivent les positions du groupe dans l'ordre où elles se ferment.  Les groupes résolus en
+        * même temps sont disjoints: chacun n'écrit que les cases de ses sommets, et le numéro de groupe des autres
+        * sommets ne change plus.
+        */
+        void Decomposition::tarjan(const Groupe& groupe) {
+            for (auto sommet: groupe.sommets) ordres[sommet] = NON_VISITE;
+            std::vector<std::uint32_t> pile;
+            std::vector<std::pair<std::uint32_t, size_t> > appels;	// (sommet, prochain arc à examiner)
+            std::uint32_t rang = 0, position = groupe.debut;
+
+            auto decouvrir = [&](std::uint32_t sommet) {
+                ordres[sommet] = liens[sommet] = rang++;
+                pile.push_back(sommet);
+                surPile[sommet] = 1;
+                appels.emplace_back(sommet, graphe.debutArcs(sommet));
+            };
+
+            for (auto racine: groupe.sommets) {
+                if (ordres[racine] != NON_VISITE) continue;
+                decouvrir(racine);
+                while (!appels.empty()) {
+                    auto sommet = appels.back().first;
+                    auto arc = appels.back().second;
+                    if (arc < graphe.finArcs(sommet)) {
+                        ++appels.back().second;
+                        auto voisin = static_cast<std::uint32_t>(graphe.destination(arc));
+                        if (groupes[voisin] != groupe.numero) continue;
+                        if (ordres[voisin] == NON_VISITE) decouvrir(voisin);
+                        else if (surPile[voisin]) liens[sommet] = std::min(liens[sommet], ordres[voisin]);
+                        continue;
+                    }
+
+                    if (liens[sommet] == ordres[sommet]) {
+                        auto taille = static_cast<std::uint32_t>(pile.size());
+                        std::uint32_t membre;
+                        do {
+                            membre = pile.back();
+                            pile.pop_back();
+                            surPile[membre] = 0;
+                            positions[membre] = position;
+                        } while (membre != sommet);
+                        position += taille - static_cast<std::uint32_t>(pile.size());
+                    }
+
+                    appels.pop_back();
+                    if (!appels.empty()) {
+                        auto parent = appels.back().first;
+                        liens[parent] = std::min(liens[parent], liens[sommet]);
+                    }
+                }
+            }
+        }
+
+        /**
+        * \fn Composantes Decomposition::calculer()
+        * \brief Élague, découpe les grands groupes par avant-arrière (un à la fois, chaque parcours étant parallèle), résout
+        * les petits groupes et ceux que l'avant-arrière ne réduit plus par Tarjan en parallèle, puis numérote les
+        * composantes par position croissante
+        */
+        Composantes Decomposition::calculer() {
+            const size_t nbSommets = graphe.taille();
+            std::vector<Groupe> aTraiter;
+            auto reste = elaguer();
+            if (!reste.sommets.empty()) aTraiter.push_back(std::move(reste));
+
+            while (!aTraiter.empty()) {
+                std::vector<Groupe> petits, nouveaux;
+                for (auto& groupe: aTraiter) {
+                    if (groupe.sommets.size() >= SEUIL_AVANT_ARRIERE && groupe.echecs < ECHECS_AVANT_TARJAN) avantArriere(groupe, nouveaux);
+                    else petits.push_back(std::move(groupe));
+                }
+                equipe.repartir(petits.size(), [&](size_t i, unsigned) { tarjan(petits[i]); });
+                aTraiter = std::move(nouveaux);
+            }
+
+            //Chaque composante marque sa position; son numéro est le nombre de positions marquées avant elle
+            BitsAtomiques marquees(nbSommets);
+            pourBlocs(nbSommets, [&](size_t debut, size_t fin, size_t) {
+                for (auto sommet = debut; sommet < fin; ++sommet) marquees.marquer(positions[sommet]);
+            });
+            auto nbBlocs = (nbSommets + TAILLE_BLOC - 1) / TAILLE_BLOC;
+            std::vector<std::uint32_t> premiers(nbBlocs + 1, 0), numerosPositions(nbSommets);
+            pourBlocs(nbSommets, [&](size_t debut, size_t fin, size_t bloc) {
+                for (auto position = debut; position < fin; ++position) premiers[bloc + 1] += marquees.marque(static_cast<std::uint32_t>(position));
+            });
+            for (size_t bloc = 0; bloc < nbBlocs; ++bloc) premiers[bloc + 1] += premiers[bloc];
+            pourBlocs(nbSommets, [&](size_t debut, size_t fin, size_t bloc) {
+                auto numero = premiers[bloc];
+                for (auto position = debut; position < fin; ++position) {
+                    numerosPositions[position] = numero;
+                    numero += marquees.marque(static_cast<std::uint32_t>(position));
+                }
+            });
+
+            Composantes resultat;
+            resultat.numeros.resize(nbSommets);
+            resultat.nombre = premiers[nbBlocs];
+            pourBlocs(nbSommets, [&](size_t debut, size_t fin, size_t) {
+                for (auto sommet = debut; sommet < fin; ++sommet) resultat.numeros[sommet] = numerosPositions[positions[sommet]];
+            });
+            return resultat;
+        }
+    }
+
+    /**
+    * \fn Composantes composantesParalleles(const GrapheCompact& graphe, unsigned nbFils)
+    * \brief Calcule les composantes fortement connexes du graphe sur plusieurs fils d'exécution.  Sur un seul fil,
+    * l'élagage, l'avant-arrière et la numérotation coûteraient chacun autant qu'un Tarjan complet: le calcul est alors
+    * confié à GrapheCompact::composantesFortementConnexes.
+    * \param[in] graphe l'instantané du réseau
+    * \param[in] nbFils le nombre de fils d'exécution, 0 pour autant que de coeurs
+    * \return Composantes le numéro de composante de chaque sommet, en ordre topologique inverse
+    */
+    Composantes composantesParalleles(const GrapheCompact& graphe, unsigned nbFils) {
+        if (nombreFils(nbFils, std::numeric_limits<unsigned>::max()) == 1) return graphe.composantesFortementConnexes();
+        return Decomposition(graphe, nbFils).calculer();
+    }
+
+}//Fin du namespace
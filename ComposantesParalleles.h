@@ -0,0 +1,48 @@
+/**
+ * \file ComposantesParalleles.h
+ * \brief Composantes fortement connexes calculées sur plusieurs fils d'exécution.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "GrapheCompact.h"
+
+#ifndef _COMPOSANTESPARALLELES__H
+#define _COMPOSANTESPARALLELES__H
+
+namespace TP2
+{
+
+/**
+ * \fn Composantes composantesParalleles(const GrapheCompact& graphe, unsigned nbFils)
+ * \brief Les composantes fortement connexes du graphe, calculées sur nbFils fils d'exécution (0: autant que de coeurs).
+ *
+ *  1. Élagage: un sommet sans arc entrant ou sans arc sortant (parmi les sommets restants) est à lui seul une
+ *     composante, et deux sommets dont chacun n'a pour seul successeur (ou seul prédécesseur) restant que l'autre en
+ *     forment une.  Les sommets sont retirés par rondes, chaque ronde en parallèle (compteurs de degrés atomiques);
+ *     un petit front est défait par un seul fil, sans rondes.
+ *  2. Avant-arrière: dans un groupe de sommets assez grand, les sommets atteints depuis un pivot tiré au hasard (F)
+ *     et ceux qui l'atteignent (B) sont marqués par deux parcours parallèles (bits de visite atomiques, vol de travail
+ *     entre les fils).  F inter B est la composante du pivot; F \ B, B \ F et le reste forment trois nouveaux groupes,
+ *     car aucune composante ne les chevauche.  Un groupe que les passes ne réduisent presque plus passe à l'étape 3.
+ *  3. Les petits groupes sont répartis entre les fils, chacun résolu par un Tarjan restreint à ses sommets.
+ *
+ *  Les fils sont créés une fois pour tout le calcul (voir EquipeFils).  Sur un seul fil, le calcul est celui de
+ *  GrapheCompact::composantesFortementConnexes, que ces étapes ne feraient que ralentir.
+ *
+ *  Chaque groupe reçoit une plage de positions: celles de F \ B précèdent la composante du pivot, puis viennent le
+ *  reste et enfin B \ F; les sommets élagués sans successeur prennent les premières positions, ceux sans prédécesseur
+ *  les dernières.  Les composantes numérotées dans l'ordre de leurs positions le sont donc en ordre topologique
+ *  inverse, comme par GrapheCompact::composantesFortementConnexes, qui donne les mêmes composantes mais pas forcément
+ *  les mêmes numéros.  Les pivots sont tirés avec une graine fixe: sur plusieurs fils, le résultat ne dépend pas de
+ *  leur nombre.
+ */
+Composantes composantesParalleles(const GrapheCompact& graphe, unsigned nbFils = 0);
+
+}//Fin du namespace
+
+#endif
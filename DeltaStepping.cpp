@@ -0,0 +1,364 @@
+/**
+ * \file DeltaStepping.cpp
+ * \brief Implémentation des plus courts chemins par delta-stepping (seaux par fil, relaxation parallèle).
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "DeltaStepping.h"
+#include "Parallele.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace TP2
+{
+    namespace
+    {
+        const std::uint32_t SANS_PREDECESSEUR = 0xFFFFFFFFu;
+        const size_t TAILLE_BLOC = 1 << 10;				// sommets (ou arcs) par tâche des boucles parallèles
+        const size_t SEUIL_PARALLELE = 1 << 12;			// en dessous, le fil appelant relâche seul
+        const size_t ANNEAU_MAXIMAL = size_t(1) << 22;	// places de l'anneau de seaux d'un fil
+        const float DELTA_MINIMAL = 1.f / (1 << 20);	// fraction de la plus grande pondération
+
+        std::uint32_t enBits(float valeur) {
+            std::uint32_t bits;
+            std::memcpy(&bits, &valeur, sizeof bits);
+            return bits;
+        }
+
+        float enFlottant(std::uint32_t bits) {
+            float valeur;
+            std::memcpy(&valeur, &bits, sizeof valeur);
+            return valeur;
+        }
+
+        /**
+        * \struct Ponderations
+        * \brief Ce qu'il faut savoir des pondérations d'un critère pour choisir delta et dimensionner les seaux
+        */
+        struct Ponderations
+        {
+            double somme = 0;
+            float plusGrande = 0;
+            bool negative = false;
+        };
+
+        /**
+        * \fn Ponderations examiner(const GrapheCompact& graphe, bool dureeCout, EquipeFils& equipe)
+        * \brief Parcourt les pondérations du critère, par blocs d'arcs répartis entre les fils de l'équipe
+        */
+        Ponderations examiner(const GrapheCompact& graphe, bool dureeCout, EquipeFils& equipe) {
+            const size_t nbArcs = graphe.getNombreArcs();
+            const size_t nbBlocs = (nbArcs + TAILLE_BLOC * 64 - 1) / (TAILLE_BLOC * 64);
+            std::vector<Ponderations> parBloc(nbBlocs);
+            equipe.repartir(nbBlocs, [&](size_t bloc, unsigned) {
+                auto& resultat = parBloc[bloc];
+                const size_t fin = std::min(nbArcs, (bloc + 1) * TAILLE_BLOC * 64);
+                for (size_t arc = bloc * TAILLE_BLOC * 64; arc < fin; ++arc) {
+                    float poids = graphe.poids(arc, dureeCout);
+                    resultat.somme += poids;
+                    resultat.plusGrande = std::max(resultat.plusGrande, poids);
+                    resultat.negative = resultat.negative || poids < 0;
+                }
+            });
+            Ponderations total;
+            for (const auto& resultat: parBloc) {
+                total.somme += resultat.somme;
+                total.plusGrande = std::max(total.plusGrande, resultat.plusGrande);
+                total.negative = total.negative || resultat.negative;
+            }
+            return total;
+        }
+
+        /**
+        * \fn float deltaPour(const Ponderations& ponderations, size_t nbArcs)
+        * \brief Delta selon choisirDelta
+        */
+        float deltaPour(const Ponderations& ponderations, size_t nbArcs) {
+            if (nbArcs == 0 || !(ponderations.plusGrande > 0)) return 1;
+            auto delta = static_cast<float>(ponderations.somme / nbArcs);
+            return std::max(delta, ponderations.plusGrande * DELTA_MINIMAL);
+        }
+
+        /**
+        * \struct Seaux
+        * \brief L'anneau de seaux d'un fil, sur ses propres lignes de cache: le seau i est à la place i % taille
+        */
+        struct alignas(64) Seaux
+        {
+            std::vector<std::vector<std::uint32_t> > places;
+        };
+
+        /**
+        * \class Relaxation
+        * \brief L'état d'un calcul: les distances provisoires, sous forme de bits, et les seaux de chaque fil.  Les rondes
+        * et le rattachement sont répartis sur une seule équipe de fils, gardée tout le calcul: un calcul peut compter des
+        * milliers de rondes parallèles.
+        */
+        class Relaxation
+        {
+        public:
+            Relaxation(const GrapheCompact& graphe, bool dureeCout, EquipeFils& equipe, float delta, size_t anneau);
+            void calculer(size_t origine, CheminsDepuisOrigine& resultat);
+
+        private:
+            const GrapheCompact& graphe;
+            bool dureeCout;
+            EquipeFils& equipe;
+            unsigned nbFils;
+            float delta;
+            size_t anneau;
+            std::vector<std::atomic<std::uint32_t> > distances;
+            std::vector<Seaux> seaux;				// par fil
+            std::vector<std::uint32_t> marques;	// estampille: sommet déjà pris dans la ronde, ou dans le lot lourd
+            std::vector<std::uint32_t> marquesLourds;
+            std::uint32_t ronde, lot;
+
+            size_t seau(float distance) const { return static_cast<size_t>(distance / delta); }
+            void relacher(std::uint32_t sommet, bool legers, unsigned fil);
+            void relacherTous(const std::vector<std::uint32_t>& sommets, bool legers);
+            bool vider(size_t numero, std::vector<std::uint32_t>& front, std::vector<std::uint32_t>& regles);
+            void rattacher(size_t origine, CheminsDepuisOrigine& resultat);
+        };
+
+        Relaxation::Relaxation(const GrapheCompact& graphe, bool dureeCout, EquipeFils& equipe, float delta, size_t anneau)
+            : graphe(graphe), dureeCout(dureeCout), equipe(equipe), nbFils(equipe.taille()),
+              delta(delta), anneau(anneau), distances(graphe.taille()), seaux(this->nbFils), marques(graphe.taille(), 0),
+              marquesLourds(graphe.taille(), 0), ronde(0), lot(0) {
+            const auto infini = enBits(std::numeric_limits<float>::infinity());
+            for (auto& distance: distances) distance.store(infini, std::memory_order_relaxed);
+            for (auto& s: seaux) s.places.resize(anneau);
+        }
+
+        /**
+        * \fn void Relaxation::relacher(std::uint32_t sommet, bool legers, unsigned fil)
+        * \brief Relâche les arcs légers (ou lourds) de sommet; chaque voisin abaissé est rangé dans un seau du fil
+        */
+        void Relaxation::relacher(std::uint32_t sommet, bool legers, unsigned fil) {
+            const float depart = enFlottant(distances[sommet].load(std::memory_order_relaxed));
+            auto& places = seaux[fil].places;
+            for (auto arc = graphe.debutArcs(sommet); arc < graphe.finArcs(sommet); ++arc) {
+                float poids = graphe.poids(arc, dureeCout);
+                if ((poids <= delta) != legers) continue;
+                float distance = depart + poids;
+                auto bits = enBits(distance);
+                auto voisin = graphe.destination(arc);
+                auto& courante = distances[voisin];
+                auto ancienne = courante.load(std::memory_order_relaxed);
+                while (bits < ancienne) {
+                    if (courante.compare_exchange_weak(ancienne, bits, std::memory_order_relaxed)) {
+                        places[seau(distance) % anneau].push_back(static_cast<std::uint32_t>(voisin));
+                        break;
+                    }
+                }
+            }
+        }
+
+        /**
+        * \fn void Relaxation::relacherTous(const std::vector<std::uint32_t>& sommets, bool legers)
+        * \brief Relâche les arcs légers (ou lourds) de chacun des sommets, par blocs répartis entre les fils s'ils sont
+        * assez nombreux
+        */
+        void Relaxation::relacherTous(const std::vector<std::uint32_t>& sommets, bool legers) {
+            if (sommets.size() < SEUIL_PARALLELE || nbFils == 1) {
+                for (auto sommet: sommets) relacher(sommet, legers, 0);
+                return;
+            }
+            const size_t nbBlocs = (sommets.size() + TAILLE_BLOC - 1) / TAILLE_BLOC;
+            equipe.repartir(nbBlocs, [&](size_t bloc, unsigned fil) {
+                const size_t fin = std::min(sommets.size(), (bloc + 1) * TAILLE_BLOC);
+                for (size_t i = bloc * TAILLE_BLOC; i < fin; ++i) relacher(sommets[i], legers, fil);
+            });
+        }
+
+        /**
+        * \fn bool Relaxation::vider(size_t numero, std::vector<std::uint32_t>& front, std::vector<std::uint32_t>& regles)
+        * \brief Vide la place du seau numero dans l'anneau de chaque fil: front reçoit, une seule fois chacun, les sommets
+        * dont la distance est bien dans ce seau (les autres y ont été rangés avant d'être abaissés encore), et regles ceux
+        * qui ne sont pas encore dans le lot lourd courant
+        * \return bool true si le front n'est pas vide
+        */
+        bool Relaxation::vider(size_t numero, std::vector<std::uint32_t>& front, std::vector<std::uint32_t>& regles) {
+            front.clear();
+            ++ronde;
+            for (auto& s: seaux) {
+                auto& place = s.places[numero % anneau];
+                for (auto sommet: place) {
+                    if (marques[sommet] == ronde) continue;
+                    if (seau(enFlottant(distances[sommet].load(std::memory_order_relaxed))) != numero) continue;
+                    marques[sommet] = ronde;
+                    front.push_back(sommet);
+                    if (marquesLourds[sommet] != lot) {
+                        marquesLourds[sommet] = lot;
+                        regles.push_back(sommet);
+                    }
+                }
+                place.clear();
+            }
+            return !front.empty();
+        }
+
+        /**
+        * \fn void Relaxation::calculer(size_t origine, CheminsDepuisOrigine& resultat)
+        * \brief Vide les seaux dans l'ordre.  Un seau est vidé par rondes d'arcs légers; quand il reste vide, ses sommets
+        * relâchent leurs arcs lourds.  Une pondération lourde est plus grande que delta, mais l'arrondi peut ramener un
+        * voisin dans le seau courant: les rondes reprennent alors, et seuls les sommets passés depuis le dernier lot lourd
+        * relâchent à nouveau leurs arcs lourds.
+        */
+        void Relaxation::calculer(size_t origine, CheminsDepuisOrigine& resultat) {
+            distances[origine].store(enBits(0.f), std::memory_order_relaxed);
+            seaux[0].places[0].push_back(static_cast<std::uint32_t>(origine));
+
+            std::vector<std::uint32_t> front, regles;
+            size_t numero = 0;
+            while (true) {
+                ++resultat.seaux;
+                ++lot;
+                regles.clear();
+                while (true) {
+                    if (vider(numero, front, regles)) {
+                        relacherTous(front, true);
+                    }
+                    else if (!regles.empty()) {
+                        relacherTous(regles, false);
+                        regles.clear();
+                        ++lot;
+                    }
+                    else break;
+                    ++resultat.rondes;
+                }
+
+                // Le prochain seau non vide est dans l'anneau: aucun arc ne mène plus loin que anneau - 1 seaux
+                size_t suivant = numero + 1;
+                auto estVide = [&](size_t candidat) {
+                    for (const auto& s: seaux)
+                        if (!s.places[candidat % anneau].empty()) return false;
+                    return true;
+                };
+                while (suivant < numero + anneau && estVide(suivant)) ++suivant;
+                if (suivant == numero + anneau) break;
+                numero = suivant;
+            }
+
+            resultat.distances.resize(graphe.taille());
+            for (size_t sommet = 0; sommet < graphe.taille(); ++sommet)
+                resultat.distances[sommet] = enFlottant(distances[sommet].load(std::memory_order_relaxed));
+            rattacher(origine, resultat);
+        }
+
+        /**
+        * \fn void Relaxation::rattacher(size_t origine, CheminsDepuisOrigine& resultat)
+        * \brief Choisit les prédécesseurs: pour chaque sommet atteint, en parallèle, l'arc entrant tendu (distance(u) +
+        * poids == distance(v)) de plus petite distance(u) < distance(v), puis de plus petit u.  Les sommets restants ne
+        * sont reliés que par des arcs tendus sans allongement; ils sont rattachés par un parcours en largeur depuis les
+        * sommets déjà rattachés, ce qui ne peut former de cycle.
+        */
+        void Relaxation::rattacher(size_t origine, CheminsDepuisOrigine& resultat) {
+            const auto& d = resultat.distances;
+            auto& predecesseurs = resultat.predecesseurs;
+            predecesseurs.assign(graphe.taille(), SANS_PREDECESSEUR);
+            std::vector<std::vector<std::uint32_t> > restantsParFil(nbFils);
+
+            const size_t nbBlocs = (graphe.taille() + TAILLE_BLOC - 1) / TAILLE_BLOC;
+            equipe.repartir(nbBlocs, [&](size_t bloc, unsigned fil) {
+                const size_t fin = std::min(graphe.taille(), (bloc + 1) * TAILLE_BLOC);
+                for (size_t sommet = bloc * TAILLE_BLOC; sommet < fin; ++sommet) {
+                    if (sommet == origine || d[sommet] == std::numeric_limits<float>::infinity()) continue;
+                    auto meilleur = SANS_PREDECESSEUR;
+                    for (auto arc = graphe.debutArcsEntrants(sommet); arc < graphe.finArcsEntrants(sommet); ++arc) {
+                        auto source = graphe.source(arc);
+                        if (!(d[source] < d[sommet]) || d[source] + graphe.poidsEntrant(arc, dureeCout) != d[sommet]) continue;
+                        if (meilleur == SANS_PREDECESSEUR || d[source] < d[meilleur] || (d[source] == d[meilleur] && source < meilleur))
+                            meilleur = static_cast<std::uint32_t>(source);
+                    }
+                    if (meilleur == SANS_PREDECESSEUR) restantsParFil[fil].push_back(static_cast<std::uint32_t>(sommet));
+                    else predecesseurs[sommet] = meilleur;
+                }
+            });
+
+            std::vector<std::uint32_t> restants;
+            for (const auto& r: restantsParFil) restants.insert(restants.end(), r.begin(), r.end());
+            if (restants.empty()) return;
+            std::sort(restants.begin(), restants.end());	// le même parcours quel que soit le nombre de fils
+            ++ronde;
+            for (auto sommet: restants) marques[sommet] = ronde;	// ronde: pas encore rattaché
+
+            std::vector<std::uint32_t> file;
+            auto tendu = [&](size_t source, size_t arc, size_t sommet) {
+                return d[source] == d[sommet] && d[source] + graphe.poids(arc, dureeCout) == d[sommet];
+            };
+            for (auto sommet: restants) {
+                for (auto arc = graphe.debutArcsEntrants(sommet); arc < graphe.finArcsEntrants(sommet); ++arc) {
+                    auto source = graphe.source(arc);
+                    if (marques[source] == ronde || d[source] != d[sommet]) continue;
+                    if (d[source] + graphe.poidsEntrant(arc, dureeCout) != d[sommet]) continue;
+                    file.push_back(static_cast<std::uint32_t>(source));	// déjà rattaché: point de départ
+                    break;
+                }
+            }
+            for (size_t i = 0; i < file.size(); ++i) {
+                auto source = file[i];
+                for (auto arc = graphe.debutArcs(source); arc < graphe.finArcs(source); ++arc) {
+                    auto sommet = graphe.destination(arc);
+                    if (marques[sommet] != ronde || !tendu(source, arc, sommet)) continue;
+                    marques[sommet] = 0;
+                    predecesseurs[sommet] = source;
+                    file.push_back(static_cast<std::uint32_t>(sommet));
+                }
+            }
+        }
+    }
+
+    /**
+    * \fn float choisirDelta(const GrapheCompact& graphe, bool dureeCout)
+    * \brief Donne la largeur de seau tirée des pondérations du critère (voir DeltaStepping.h)
+    * \param[in] graphe l'instantané du réseau
+    * \param[in] dureeCout le critère: la durée si true, le coût sinon
+    * \return float delta, strictement positif
+    */
+    float choisirDelta(const GrapheCompact& graphe, bool dureeCout) {
+        EquipeFils equipe(0);
+        return deltaPour(examiner(graphe, dureeCout, equipe), graphe.getNombreArcs());
+    }
+
+    /**
+    * \fn CheminsDepuisOrigine deltaStepping(const GrapheCompact& graphe, size_t origine, bool dureeCout, unsigned nbFils, float delta)
+    * \brief Calcule les plus courts chemins depuis origine par delta-stepping (voir DeltaStepping.h)
+    * \param[in] graphe l'instantané du réseau
+    * \param[in] origine le sommet de départ
+    * \param[in] dureeCout le critère: la durée si true, le coût sinon
+    * \param[in] nbFils le nombre de fils d'exécution, 0 pour autant que de coeurs
+    * \param[in] delta la largeur des seaux, 0 pour celle de choisirDelta
+    * \exception logic_error si origine n'est pas un sommet du graphe
+    * \exception logic_error si delta est négatif, ou trop petit devant la plus grande pondération
+    * \exception logic_error si une pondération du critère est négative
+    * \return CheminsDepuisOrigine les distances, les prédécesseurs et le déroulement du calcul
+    */
+    CheminsDepuisOrigine deltaStepping(const GrapheCompact& graphe, size_t origine, bool dureeCout, unsigned nbFils, float delta) {
+        if (origine >= graphe.taille()) throw std::logic_error("deltaStepping : origine invalide");
+        if (!(delta >= 0) || delta == std::numeric_limits<float>::infinity()) throw std::logic_error("deltaStepping : delta invalide");
+
+        EquipeFils equipe(nbFils);
+        auto ponderations = examiner(graphe, dureeCout, equipe);
+        if (ponderations.negative) throw std::logic_error("deltaStepping : pondération négative");
+        if (delta == 0) delta = deltaPour(ponderations, graphe.getNombreArcs());
+        // Un arc mène au plus floor(plusGrande / delta) + 1 seaux plus loin, arrondis compris
+        const double portee = std::floor(ponderations.plusGrande / delta) + 3;
+        if (portee > ANNEAU_MAXIMAL) throw std::logic_error("deltaStepping : delta trop petit devant les pondérations");
+
+        CheminsDepuisOrigine resultat;
+        resultat.delta = delta;
+        Relaxation(graphe, dureeCout, equipe, delta, static_cast<size_t>(portee)).calculer(origine, resultat);
+        return resultat;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,74 @@
+/**
+ * \file DeltaStepping.h
+ * \brief Plus courts chemins depuis une origine par delta-stepping, sur plusieurs fils d'exécution.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <cstdint>
+#include <vector>
+#include "GrapheCompact.h"
+
+#ifndef _DELTASTEPPING__H
+#define _DELTASTEPPING__H
+
+namespace TP2
+{
+
+/**
+ * \struct CheminsDepuisOrigine
+ * \brief Les plus courts chemins d'une origine vers tous les sommets, et le déroulement du calcul
+ */
+struct CheminsDepuisOrigine
+{
+	std::vector<float> distances;				// infinie si le sommet n'est pas atteignable
+	std::vector<std::uint32_t> predecesseurs;	// 0xFFFFFFFF: aucun (origine, sommets non atteints)
+	float delta = 0;			// La largeur des seaux utilisée
+	size_t seaux = 0;			// Le nombre de seaux vidés
+	size_t rondes = 0;			// Le nombre de rondes de relaxation (arcs légers et lourds)
+};
+
+/**
+ * \fn float choisirDelta(const GrapheCompact& graphe, bool dureeCout)
+ * \brief La largeur de seau tirée des pondérations du critère: leur moyenne.  Un arc léger fait alors avancer d'au plus
+ *  un seau environ, et le nombre de seaux vidés est de l'ordre du nombre d'arcs des plus longs chemins: chaque seau est
+ *  un front d'onde, aussi large qu'un niveau de parcours en largeur.  Un delta plus grand relâcherait plus d'arcs
+ *  inutilement (sommets réinsérés dans le même seau), un plus petit viderait plus de seaux presque vides.  Delta ne
+ *  descend pas sous 2^-20 fois la plus grande pondération, pour borner le nombre de seaux ouverts; il vaut 1 si
+ *  aucune pondération n'est positive.
+ */
+float choisirDelta(const GrapheCompact& graphe, bool dureeCout);
+
+/**
+ * \fn CheminsDepuisOrigine deltaStepping(const GrapheCompact& graphe, size_t origine, bool dureeCout, unsigned nbFils, float delta)
+ * \brief Les plus courts chemins depuis origine pour un critère, sur nbFils fils d'exécution (0: autant que de coeurs),
+ *  avec des seaux de largeur delta (0: celle de choisirDelta).
+ *
+ *  Un sommet de distance provisoire d est rangé dans le seau floor(d / delta).  Les arcs de pondération au plus delta
+ *  sont légers, les autres lourds.  Le plus petit seau non vide est vidé par rondes: ses sommets relâchent en parallèle
+ *  leurs arcs légers, qui peuvent remettre des sommets dans ce même seau, jusqu'à ce qu'il reste vide; les sommets qui
+ *  y sont passés, dont la distance est maintenant définitive, relâchent alors leurs arcs lourds, qui mènent à des seaux
+ *  suivants.  Les distances sont abaissées par comparaison-échange atomique sur leur représentation binaire (l'ordre
+ *  des flottants positifs est celui de leurs bits), et chaque fil range les sommets qu'il abaisse dans ses propres
+ *  seaux: les fils ne partagent que les distances.  Les seaux forment un anneau d'environ plus grand arc / delta
+ *  places par fil.  Un seau de moins de quelques milliers de sommets est vidé par le fil appelant seul.
+ *
+ *  Chaque distance est le minimum, sur les chemins, de la somme de leurs arcs faite dans l'ordre du chemin, en float:
+ *  le même résultat que ArbreChemins (Dijkstra), bit pour bit, quel que soit le nombre de fils.  Le prédécesseur d'un
+ *  sommet v est ensuite choisi parmi les arcs u -> v tels que distance(u) + poids == distance(v): celui de plus petite
+ *  distance(u), puis de plus petit numéro u, à distance(u) < distance(v); les sommets reliés seulement par des arcs de
+ *  poids nul (ou absorbé par l'arrondi) sont rattachés ensuite par un parcours depuis les sommets déjà rattachés.
+ *  C'est un arbre de plus courts chemins déterministe, le plus souvent celui de Dijkstra, mais pas toujours en cas
+ *  d'égalité.
+ * \exception logic_error si origine n'est pas un sommet du graphe, si delta est négatif (ou si petit que l'anneau
+ *  dépasserait 2^22 places) ou si une pondération du critère est négative
+ */
+CheminsDepuisOrigine deltaStepping(const GrapheCompact& graphe, size_t origine, bool dureeCout, unsigned nbFils = 0, float delta = 0);
+
+}//Fin du namespace
+
+#endif
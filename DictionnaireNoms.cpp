@@ -0,0 +1,253 @@
+/**
+ * \file DictionnaireNoms.cpp
+ * \brief Implémentation du dictionnaire des noms de sommets.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "DictionnaireNoms.h"
+#include <stdexcept>
+
+namespace TP2
+{
+    /**
+    * \fn DictionnaireNoms::DictionnaireNoms(size_t taille)
+    * \brief Constructeur avec parametre. Les sommets n'ont pas encore de nom.
+    * \param[in] taille le nombre de sommets
+    */
+    DictionnaireNoms::DictionnaireNoms(size_t taille) : entrees(taille, Entree{0, 0}), nbIndexes(0), nbDoublons(0), octetsMorts(0) {
+        reconstruireIndex();
+    }
+
+    /**
+    * \fn void DictionnaireNoms::resize(size_t nouvelleTaille)
+    * \brief Change le nombre de sommets. Les sommets ajoutés n'ont pas de nom.
+    * \param[in] nouvelleTaille le nouveau nombre de sommets
+    */
+    void DictionnaireNoms::resize(size_t nouvelleTaille) {
+        for (size_t i = nouvelleTaille; i < entrees.size(); ++i) octetsMorts += entrees[i].longueur;
+        entrees.resize(nouvelleTaille, Entree{0, 0});
+        reconstruireIndex();
+    }
+
+    /**
+    * \fn void DictionnaireNoms::nommer(size_t numero, std::string_view nom)
+    * \brief Donne un nom à un sommet. Le nouveau nom est ajouté à la fin de l'arène; l'ancien devient de l'espace mort,
+    * récupéré par compacter() lorsqu'il dépasse la moitié de l'arène.
+    * \param[in] numero le numéro du sommet
+    * \param[in] nom le nom à donner au sommet
+    * \exception logic_error si numero n'est pas un sommet
+    * \exception length_error si l'arène dépasse 4 Go
+    */
+    void DictionnaireNoms::nommer(size_t numero, std::string_view nom) {
+        if (numero >= entrees.size()) throw std::logic_error("DictionnaireNoms::nommer : sommet inexistant");
+        if (arene.size() + nom.size() > VIDE) throw std::length_error("DictionnaireNoms::nommer : l'arène des noms est pleine");
+
+        //Le nom peut provenir de l'arène elle-même, qui risque d'être réallouée par l'ajout
+        std::string copie;
+        if (!arene.empty() && nom.data() >= arene.data() && nom.data() < arene.data() + arene.size()) {
+            copie.assign(nom);
+            nom = copie;
+        }
+
+        desindexer(numero);
+        octetsMorts += entrees[numero].longueur;
+
+        entrees[numero].debut = static_cast<std::uint32_t>(arene.size());
+        entrees[numero].longueur = static_cast<std::uint32_t>(nom.size());
+        arene.append(nom);
+        indexer(numero);
+
+        if (octetsMorts > 4096 && 2 * octetsMorts > arene.size()) compacter();
+    }
+
+    /**
+    * \fn void DictionnaireNoms::retirer(size_t numero)
+    * \brief Retire un sommet. Les numéros suivants étant décalés, l'index est reconstruit au complet (O(V)).
+    * \param[in] numero le numéro du sommet à retirer
+    * \exception logic_error si numero n'est pas un sommet
+    */
+    void DictionnaireNoms::retirer(size_t numero) {
+        if (numero >= entrees.size()) throw std::logic_error("DictionnaireNoms::retirer : sommet inexistant");
+
+        octetsMorts += entrees[numero].longueur;
+        entrees.erase(entrees.begin() + static_cast<std::vector<Entree>::difference_type>(numero));
+        reconstruireIndex();
+    }
+
+    /**
+    * \fn std::string_view DictionnaireNoms::operator[](size_t numero) const
+    * \brief Donne le nom d'un sommet, sans copie
+    * \param[in] numero le numéro du sommet (doit être inférieur à size())
+    * \return std::string_view une vue sur le nom dans l'arène
+    */
+    std::string_view DictionnaireNoms::operator[](size_t numero) const {
+        const auto& entree = entrees[numero];
+        return std::string_view(arene.data() + entree.debut, entree.longueur);
+    }
+
+    /**
+    * \fn size_t DictionnaireNoms::chercher(std::string_view nom) const
+    * \brief Cherche le numéro du sommet portant un nom.  Les sommets sans nom ne sont pas indexés; chercher le nom vide
+    * balaye donc les sommets à la recherche du premier sommet sans nom.
+    * \param[in] nom le nom recherché
+    * \return size_t le plus petit numéro de sommet portant ce nom, ou size() si aucun
+    */
+    size_t DictionnaireNoms::chercher(std::string_view nom) const {
+        if (nom.empty()) {
+            for (size_t i = 0; i < entrees.size(); ++i)
+                if (entrees[i].longueur == 0) return i;
+            return entrees.size();
+        }
+
+        auto numero = alveoles[localiser(nom, hacher(nom))].numero;
+        return numero == VIDE ? entrees.size() : numero;
+    }
+
+    /**
+    * \fn size_t DictionnaireNoms::size() const
+    * \brief Donne le nombre de sommets
+    * \return size_t le nombre de sommets
+    */
+    size_t DictionnaireNoms::size() const {
+        return entrees.size();
+    }
+
+    /**
+    * \fn std::uint64_t DictionnaireNoms::hacher(std::string_view nom)
+    * \brief Hachage FNV-1a 64 bits d'un nom
+    * \param[in] nom le nom à hacher
+    * \return std::uint64_t le code de hachage
+    */
+    std::uint64_t DictionnaireNoms::hacher(std::string_view nom) {
+        std::uint64_t code = 14695981039346656037ull;
+        for (unsigned char c: nom) {
+            code ^= c;
+            code *= 1099511628211ull;
+        }
+        return code;
+    }
+
+    /**
+    * \fn size_t DictionnaireNoms::localiser(std::string_view nom, std::uint64_t code) const
+    * \brief Sondage linéaire: trouve l'alvéole contenant nom, ou la première alvéole libre rencontrée
+    * \param[in] nom le nom recherché
+    * \param[in] code le hachage de nom
+    * \return size_t l'indice de l'alvéole
+    */
+    size_t DictionnaireNoms::localiser(std::string_view nom, std::uint64_t code) const {
+        const size_t masque = alveoles.size() - 1;
+        const auto empreinte = static_cast<std::uint32_t>(code);
+
+        for (size_t i = code & masque; ; i = (i + 1) & masque) {
+            const auto& alveole = alveoles[i];
+            if (alveole.numero == VIDE) return i;
+            if (alveole.empreinte == empreinte && (*this)[alveole.numero] == nom) return i;
+        }
+    }
+
+    /**
+    * \fn void DictionnaireNoms::indexer(size_t numero)
+    * \brief Ajoute le nom du sommet numero à l'index. Si le nom est déjà indexé, le plus petit numéro est conservé.
+    * \param[in] numero le numéro du sommet
+    */
+    void DictionnaireNoms::indexer(size_t numero) {
+        if (entrees[numero].longueur == 0) return;
+        if (2 * (nbIndexes + 1) > alveoles.size()) {
+            reconstruireIndex();
+            return;
+        }
+
+        auto nom = (*this)[numero];
+        auto code = hacher(nom);
+        auto& alveole = alveoles[localiser(nom, code)];
+
+        if (alveole.numero == VIDE) {
+            alveole.numero = static_cast<std::uint32_t>(numero);
+            alveole.empreinte = static_cast<std::uint32_t>(code);
+            ++nbIndexes;
+        }
+        else {
+            ++nbDoublons;
+            if (numero < alveole.numero) alveole.numero = static_cast<std::uint32_t>(numero);
+        }
+    }
+
+    /**
+    * \fn void DictionnaireNoms::desindexer(size_t numero)
+    * \brief Retire le nom du sommet numero de l'index, avant qu'il ne change. L'alvéole libérée est comblée par
+    * décalage arrière, ce qui évite les pierres tombales.
+    * \param[in] numero le numéro du sommet
+    */
+    void DictionnaireNoms::desindexer(size_t numero) {
+        if (entrees[numero].longueur == 0) return;
+
+        auto nom = (*this)[numero];
+        auto i = localiser(nom, hacher(nom));
+
+        if (alveoles[i].numero != numero) {
+            --nbDoublons;
+            return;
+        }
+
+        //Un autre sommet porte peut-être le même nom: il prend la place (rare, seulement s'il existe des doublons)
+        if (nbDoublons > 0) {
+            for (size_t k = 0; k < entrees.size(); ++k) {
+                if (k != numero && (*this)[k] == nom) {
+                    alveoles[i].numero = static_cast<std::uint32_t>(k);
+                    --nbDoublons;
+                    return;
+                }
+            }
+        }
+
+        const size_t masque = alveoles.size() - 1;
+        for (size_t j = (i + 1) & masque; alveoles[j].numero != VIDE; j = (j + 1) & masque) {
+            size_t origine = alveoles[j].empreinte & masque;
+            bool deplacable = (i <= j) ? (origine <= i || origine > j) : (origine <= i && origine > j);
+            if (deplacable) {
+                alveoles[i] = alveoles[j];
+                i = j;
+            }
+        }
+        alveoles[i].numero = VIDE;
+        --nbIndexes;
+    }
+
+    /**
+    * \fn void DictionnaireNoms::reconstruireIndex()
+    * \brief Reconstruit l'index au complet, avec au moins deux alvéoles par sommet
+    */
+    void DictionnaireNoms::reconstruireIndex() {
+        size_t capacite = 16;
+        while (capacite < 2 * entrees.size()) capacite *= 2;
+
+        alveoles.assign(capacite, Alveole{VIDE, 0});
+        nbIndexes = 0;
+        nbDoublons = 0;
+        for (size_t i = 0; i < entrees.size(); ++i) indexer(i);
+    }
+
+    /**
+    * \fn void DictionnaireNoms::compacter()
+    * \brief Recopie les noms vivants dans une nouvelle arène, dans l'ordre des numéros
+    */
+    void DictionnaireNoms::compacter() {
+        std::string nouvelle;
+        nouvelle.reserve(arene.size() - octetsMorts);
+
+        for (auto& entree: entrees) {
+            auto debut = static_cast<std::uint32_t>(nouvelle.size());
+            nouvelle.append(arene, entree.debut, entree.longueur);
+            entree.debut = debut;
+        }
+
+        arene.swap(nouvelle);
+        octetsMorts = 0;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,99 @@
+/**
+ * \file DictionnaireNoms.h
+ * \brief Gestion des noms des sommets d'un graphe.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _DICTIONNAIRENOMS__H
+#define _DICTIONNAIRENOMS__H
+
+namespace TP2
+{
+
+/**
+ * \class DictionnaireNoms
+ * \brief Associe un nom à chaque numéro de sommet et permet de retrouver le numéro à partir du nom en O(1).
+ *
+ *  Tous les noms sont internés dans une seule zone mémoire contiguë (l'arène) plutôt que dans une std::string
+ *  chacun.  L'index nom -> numéro est une table de hachage à adressage ouvert (sondage linéaire, facteur de
+ *  charge d'au plus 1/2).  Lorsqu'un même nom est donné à plusieurs sommets, l'index retourne le plus petit
+ *  numéro, comme le ferait un balayage linéaire.
+ */
+class DictionnaireNoms
+{
+public:
+
+	explicit DictionnaireNoms(size_t taille = 0);
+
+	// Change le nombre de sommets. Les nouveaux sommets n'ont pas de nom.
+	void resize(size_t nouvelleTaille);
+
+	// Donne un nom au sommet numero (numero < size())
+	void nommer(size_t numero, std::string_view nom);
+
+	// Retire le sommet numero; les numéros des sommets suivants diminuent de 1
+	void retirer(size_t numero);
+
+	// Retourne le nom du sommet numero (numero < size()). La vue est invalidée par toute modification.
+	std::string_view operator[](size_t numero) const;
+
+	// Retourne le numéro du sommet portant ce nom, ou size() si aucun sommet ne le porte
+	size_t chercher(std::string_view nom) const;
+
+	// Retourne le nombre de sommets
+	size_t size() const;
+
+	// Fonction de hachage utilisée par l'index (FNV-1a 64 bits)
+	static std::uint64_t hacher(std::string_view nom);
+
+private:
+
+	/**
+	 * \struct Entree
+	 * \brief Position d'un nom dans l'arène
+	 */
+	struct Entree
+	{
+		std::uint32_t debut;
+		std::uint32_t longueur;
+	};
+
+	/**
+	 * \struct Alveole
+	 * \brief Case de la table de hachage. numero vaut VIDE si la case est libre.
+	 */
+	struct Alveole
+	{
+		std::uint32_t numero;
+		std::uint32_t empreinte;	// 32 bits de poids faible du hachage, évite de relire l'arène en cas de collision
+	};
+
+	static constexpr std::uint32_t VIDE = 0xFFFFFFFFu;
+
+	std::string arene;				/*!< les noms, mis bout à bout */
+	std::vector<Entree> entrees;	/*!< la position du nom de chaque sommet dans l'arène */
+	std::vector<Alveole> alveoles;	/*!< l'index nom -> numéro (taille puissance de 2) */
+	size_t nbIndexes;				// Le nombre d'alvéoles occupées
+	size_t nbDoublons;				// Le nombre de sommets dont le nom est déjà porté par un numéro plus petit
+	size_t octetsMorts;				// Les octets de l'arène qui ne sont plus référencés par aucune entrée
+
+	size_t localiser(std::string_view nom, std::uint64_t code) const;
+	void indexer(size_t numero);
+	void desindexer(size_t numero);
+	void reconstruireIndex();
+	void compacter();
+};
+
+}//Fin du namespace
+
+#endif
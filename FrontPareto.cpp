@@ -0,0 +1,204 @@
+/**
+ * \file FrontPareto.cpp
+ * \brief Implémentation de la recherche multicritère du front de Pareto.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "FrontPareto.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+namespace TP2
+{
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+        const std::uint32_t SANS_PRECEDENTE = 0xFFFFFFFFu;
+        // Les bornes sont additionnées dans l'ordre inverse des chemins: réduites pour rester inférieures malgré les arrondis
+        const float REDUCTION = 1 - 1e-5f;
+
+        /**
+        * \struct Etiquette
+        * \brief Un chemin partiel de la source à sommet, et l'étiquette du sommet précédent
+        */
+        struct Etiquette
+        {
+            float duree;
+            float cout;
+            std::uint32_t sommet;
+            std::uint32_t precedente;
+        };
+
+        using EntreeTas = std::tuple<float, float, std::uint32_t>;	// durée, coût, numéro d'étiquette
+
+        /**
+        * \struct Brouillon
+        * \brief Les tableaux de travail des recherches d'un fil d'exécution, remis à zéro par estampilles
+        */
+        struct Brouillon
+        {
+            std::vector<float> bornes;					// coût minimal du sommet à la cible
+            std::vector<float> coutsFixes;				// coût de la dernière étiquette fixée du sommet
+            std::vector<std::uint32_t> nbFixees;		// nombre d'étiquettes fixées du sommet
+            std::vector<std::uint32_t> bornees;			// estampille: borne calculée (le sommet mène à la cible)
+            std::vector<std::uint32_t> resolus;			// estampille: borne définitive
+            std::vector<std::uint32_t> visites;			// estampille: coutsFixes et nbFixees valides
+            std::vector<Etiquette> etiquettes;
+            std::vector<EntreeTas> tas;
+            std::vector<std::pair<float, std::uint32_t> > tasBornes;
+            std::uint32_t generation = 0;
+
+            void preparer(size_t taille) {
+                if (bornees.size() < taille) {
+                    bornes.resize(taille);
+                    coutsFixes.resize(taille);
+                    nbFixees.resize(taille);
+                    bornees.assign(taille, 0);
+                    resolus.assign(taille, 0);
+                    visites.assign(taille, 0);
+                    generation = 0;
+                }
+                if (++generation == 0) {
+                    std::fill(bornees.begin(), bornees.end(), 0);
+                    std::fill(resolus.begin(), resolus.end(), 0);
+                    std::fill(visites.begin(), visites.end(), 0);
+                    generation = 1;
+                }
+                etiquettes.clear();
+                tas.clear();
+                tasBornes.clear();
+            }
+
+            bool mene(std::uint32_t sommet) const { return bornees[sommet] == generation; }
+            float coutFixe(std::uint32_t sommet) const { return visites[sommet] == generation ? coutsFixes[sommet] : INFINI; }
+        };
+
+        /**
+        * \fn Brouillon& brouillonDuFil()
+        * \brief Donne les tableaux de travail du fil d'exécution courant
+        */
+        Brouillon& brouillonDuFil() {
+            static thread_local Brouillon brouillon;
+            return brouillon;
+        }
+
+        /**
+        * \fn void calculerBornes(const GrapheCompact& graphe, std::uint32_t cible, Brouillon& brouillon)
+        * \brief Dijkstra arrière sur le coût depuis la cible, sur les arcs entrants: bornes[s] est le coût minimal de s à
+        * la cible, pour chaque sommet s qui mène à la cible
+        */
+        void calculerBornes(const GrapheCompact& graphe, std::uint32_t cible, Brouillon& brouillon) {
+            const std::greater<std::pair<float, std::uint32_t> > priorite;
+            auto& tas = brouillon.tasBornes;
+
+            brouillon.bornes[cible] = 0;
+            brouillon.bornees[cible] = brouillon.generation;
+            tas.emplace_back(0.f, cible);
+            while (!tas.empty()) {
+                std::pop_heap(tas.begin(), tas.end(), priorite);
+                auto courant = tas.back().second;
+                tas.pop_back();
+                if (brouillon.resolus[courant] == brouillon.generation) continue;
+                brouillon.resolus[courant] = brouillon.generation;
+
+                for (auto arc = graphe.debutArcsEntrants(courant); arc < graphe.finArcsEntrants(courant); ++arc) {
+                    auto voisin = static_cast<std::uint32_t>(graphe.source(arc));
+                    if (brouillon.resolus[voisin] == brouillon.generation) continue;
+                    float borne = brouillon.bornes[courant] + graphe.poidsEntrant(arc, false);
+                    if (!brouillon.mene(voisin) || borne < brouillon.bornes[voisin]) {
+                        brouillon.bornes[voisin] = borne;
+                        brouillon.bornees[voisin] = brouillon.generation;
+                        tas.emplace_back(borne, voisin);
+                        std::push_heap(tas.begin(), tas.end(), priorite);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+    * \fn FrontPareto::FrontPareto(const GrapheCompact& graphe, size_t source, size_t cible, size_t limiteEtiquettes)
+    * \brief Calcule le front de Pareto (durée, coût) de source à cible par une recherche à étiquettes fixées
+    * \param[in] graphe l'instantané du réseau
+    * \param[in] source le sommet de départ
+    * \param[in] cible le sommet d'arrivée
+    * \param[in] limiteEtiquettes le nombre maximal d'étiquettes fixées par sommet, 0 pour aucune limite
+    * \exception logic_error si source ou cible n'est pas un sommet du graphe
+    */
+    FrontPareto::FrontPareto(const GrapheCompact& graphe, size_t source, size_t cible, size_t limiteEtiquettes) : nbEtiquettes(0) {
+        if (source >= graphe.taille()) throw std::logic_error("FrontPareto::FrontPareto : la source est invalide");
+        if (cible >= graphe.taille()) throw std::logic_error("FrontPareto::FrontPareto : la cible est invalide");
+        if (source == cible) return;
+
+        const auto limite = limiteEtiquettes == 0 ? std::numeric_limits<std::uint32_t>::max()
+                                                  : static_cast<std::uint32_t>(std::min<size_t>(limiteEtiquettes, std::numeric_limits<std::uint32_t>::max()));
+        const auto arrivee = static_cast<std::uint32_t>(cible);
+        auto& brouillon = brouillonDuFil();
+        brouillon.preparer(graphe.taille());
+        calculerBornes(graphe, arrivee, brouillon);
+        if (!brouillon.mene(static_cast<std::uint32_t>(source))) return;
+
+        auto& etiquettes = brouillon.etiquettes;
+        auto& tas = brouillon.tas;
+        const std::greater<EntreeTas> priorite;
+        //Une étiquette est inutile si elle ne peut pas mener à un trajet moins cher que le dernier trouvé
+        auto inutile = [&](std::uint32_t sommet, float cout) {
+            return cout >= brouillon.coutFixe(sommet) || cout + brouillon.bornes[sommet] * REDUCTION >= brouillon.coutFixe(arrivee);
+        };
+
+        std::vector<std::uint32_t> arrivees;
+        etiquettes.push_back(Etiquette{0.f, 0.f, static_cast<std::uint32_t>(source), SANS_PRECEDENTE});
+        tas.emplace_back(0.f, 0.f, 0u);
+        while (!tas.empty()) {
+            std::pop_heap(tas.begin(), tas.end(), priorite);
+            auto numero = std::get<2>(tas.back());
+            tas.pop_back();
+            const auto etiquette = etiquettes[numero];
+            const auto courant = etiquette.sommet;
+            if (inutile(courant, etiquette.cout)) continue;
+            if (brouillon.visites[courant] == brouillon.generation && brouillon.nbFixees[courant] >= limite) continue;
+
+            //Fixée: les étiquettes suivantes du sommet sont plus longues, elles devront être moins chères
+            if (brouillon.visites[courant] != brouillon.generation) {
+                brouillon.visites[courant] = brouillon.generation;
+                brouillon.nbFixees[courant] = 0;
+            }
+            brouillon.coutsFixes[courant] = etiquette.cout;
+            ++brouillon.nbFixees[courant];
+            ++nbEtiquettes;
+            if (courant == arrivee) {
+                arrivees.push_back(numero);
+                continue;
+            }
+
+            for (auto arc = graphe.debutArcs(courant); arc < graphe.finArcs(courant); ++arc) {
+                auto voisin = static_cast<std::uint32_t>(graphe.destination(arc));
+                if (!brouillon.mene(voisin)) continue;
+                float cout = etiquette.cout + graphe.cout(arc);
+                if (inutile(voisin, cout)) continue;
+                float duree = etiquette.duree + graphe.duree(arc);
+                auto suivante = static_cast<std::uint32_t>(etiquettes.size());
+                etiquettes.push_back(Etiquette{duree, cout, voisin, numero});
+                tas.emplace_back(duree, cout, suivante);
+                std::push_heap(tas.begin(), tas.end(), priorite);
+            }
+        }
+
+        trajets.reserve(arrivees.size());
+        for (auto numero: arrivees) {
+            Trajet trajet{etiquettes[numero].duree, etiquettes[numero].cout, {}};
+            for (auto e = numero; e != SANS_PRECEDENTE; e = etiquettes[e].precedente) trajet.sommets.push_back(etiquettes[e].sommet);
+            std::reverse(trajet.sommets.begin(), trajet.sommets.end());
+            trajets.push_back(std::move(trajet));
+        }
+    }
+
+}//Fin du namespace
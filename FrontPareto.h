@@ -0,0 +1,83 @@
+/**
+ * \file FrontPareto.h
+ * \brief Front de Pareto des trajets entre deux villes, selon la durée et le coût.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <cstdint>
+#include <vector>
+#include "GrapheCompact.h"
+
+#ifndef _FRONTPARETO__H
+#define _FRONTPARETO__H
+
+namespace TP2
+{
+
+/**
+ * \class FrontPareto
+ * \brief Les trajets Pareto-optimaux d'une source à une cible pour le couple (durée, coût): aucun autre trajet n'est à
+ *  la fois aussi rapide et aussi économique, et strictement meilleur sur l'un des deux.  Les trajets sont rangés par
+ *  durée croissante, donc par coût strictement décroissant: le premier est le plus rapide (le moins cher parmi les plus
+ *  rapides), le dernier le moins cher (le plus rapide parmi les moins chers).
+ *
+ *  Recherche à étiquettes fixées (Martins): une étiquette (durée, coût, sommet, étiquette précédente) est tirée d'un tas
+ *  dans l'ordre lexicographique (durée, coût).  Les étiquettes fixées d'un sommet arrivent donc par durée croissante,
+ *  et une étiquette n'est dominée que si son coût atteint celui de la dernière étiquette fixée du sommet: le test de
+ *  dominance est en O(1).  Avant la recherche, un Dijkstra arrière sur le coût depuis la cible donne à chaque sommet une
+ *  borne inférieure du coût restant; une étiquette est écartée dès que son coût plus cette borne atteint celui du
+ *  dernier trajet trouvé, ou si son sommet ne mène pas à la cible.  Les totaux de chaque trajet sont additionnés dans
+ *  l'ordre du chemin, comme dans rechercheCheminDijkstra: le premier trajet a exactement la durée minimale, le dernier
+ *  exactement le coût minimal.
+ *
+ *  Le nombre d'étiquettes fixées par sommet peut être borné: la recherche devient approchée (des trajets peu coûteux
+ *  peuvent manquer, le dernier n'est plus forcément le moins cher), mais le premier trajet reste le plus rapide.
+ *  Les tableaux de travail sont propres à chaque fil d'exécution et remis à zéro par estampilles.
+ */
+class FrontPareto
+{
+public:
+
+	// Calcule le front de source à cible, avec au plus limiteEtiquettes étiquettes fixées par sommet (0: sans limite).
+	// Le front est vide si cible n'est pas atteignable ou si source == cible.
+	// Exception logic_error si source ou cible n'est pas un sommet du graphe
+	FrontPareto(const GrapheCompact& graphe, size_t source, size_t cible, size_t limiteEtiquettes = 0);
+
+	// Retourne le nombre de trajets du front
+	size_t taille() const { return trajets.size(); }
+
+	// Retourne la durée et le coût totaux d'un trajet (i < taille())
+	float duree(size_t i) const { return trajets[i].duree; }
+	float cout(size_t i) const { return trajets[i].cout; }
+
+	// Retourne les sommets d'un trajet, source et cible comprises (i < taille())
+	const std::vector<size_t>& sommets(size_t i) const { return trajets[i].sommets; }
+
+	// Retourne le nombre d'étiquettes fixées par la recherche
+	size_t getNombreEtiquettes() const { return nbEtiquettes; }
+
+private:
+
+	/**
+	 * \struct Trajet
+	 * \brief Un trajet du front et ses totaux
+	 */
+	struct Trajet
+	{
+		float duree;
+		float cout;
+		std::vector<size_t> sommets;
+	};
+
+	std::vector<Trajet> trajets;
+	size_t nbEtiquettes;
+};
+
+}//Fin du namespace
+
+#endif
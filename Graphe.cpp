@@ -24,7 +24,27 @@ namespace TP2
    * \param[in] nbSommets le nombre de sommets du graphe
    * \return Un objet Graphe
    */
-    Graphe::Graphe(size_t nbSommets) : listesAdj(nbSommets), nbSommets(nbSommets), nbArcs(0), noms(nbSommets) {
+    Graphe::Graphe(size_t nbSommets) : listesAdj(nbSommets), nbSommets(nbSommets), nbArcs(0), noms(nbSommets), aritesEntree(nbSommets, 0), suiviEntrants(false), version(GrapheCompact::nouvelleVersion()) {
+    }
+
+    /**
+    * \fn  Graphe::Graphe(const GrapheCompact& compact)
+    * \brief Constructeur à partir d'un instantané: les noms et les arcs sont recopiés, les arcs de chaque sommet dans
+    * l'ordre de l'instantané, de sorte que figer() redonne les mêmes tableaux.  Le graphe prend la version de l'instantané.
+    * \param[in] compact l'instantané à recopier
+    */
+    Graphe::Graphe(const GrapheCompact& compact) : Graphe(compact.taille()) {
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet)
+            noms.nommer(sommet, compact.nom(sommet));
+
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet) {
+            for (auto arc = compact.debutArcs(sommet); arc < compact.finArcs(sommet); ++arc) {
+                listesAdj[sommet].emplace_back(compact.destination(arc), compact.getPonderations(arc));
+                ++aritesEntree[compact.destination(arc)];
+            }
+        }
+        nbArcs = compact.getNombreArcs();
+        version = compact.getVersion();
     }
 
     /**
@@ -43,6 +63,9 @@ namespace TP2
         nbSommets = nouvelleTaille;
         listesAdj.resize(nouvelleTaille);
         noms.resize(nouvelleTaille);
+        aritesEntree.resize(nouvelleTaille, 0);
+        if (suiviEntrants) listesEntrantes.resize(nouvelleTaille);
+        version = GrapheCompact::nouvelleVersion();
     }
 
     /**
@@ -54,7 +77,8 @@ namespace TP2
     */
     void Graphe::nommer(size_t sommet, const std::string& nom){
         if(!sommetExiste(sommet)) throw logic_error("Graphe::nommer : sommet inexistant");
-        noms.at(sommet) = nom;
+        noms.nommer(sommet, nom);
+        version = GrapheCompact::nouvelleVersion();
     }
 
     /**
@@ -78,7 +102,53 @@ namespace TP2
         p.duree = duree;
 
         listesAdj.at(source).emplace_back(destination, p);
+        if (suiviEntrants) listesEntrantes[destination].emplace_back(source, p);
+        aritesEntree[destination]++;
         nbArcs++;
+        version = GrapheCompact::nouvelleVersion();
+    }
+
+    /**
+    * \fn void ajouterArcs(const std::vector<NouvelArc>& arcs)
+    * \brief Fonction servant à ajouter un lot d'arcs.  Plutôt que de vérifier chaque arc par arcExiste, les arcs du lot
+    * sont regroupés par source (tri par dénombrement) et les doublons sont détectés en une seule passe: pour chaque source,
+    * ses destinations actuelles puis celles du lot sont marquées dans un tableau d'estampilles.
+    * \param[in] arcs les arcs à ajouter
+    * \exception logic_error si une source ou une destination n'existe pas
+    * \exception logic_error si un arc existe déjà ou apparaît deux fois dans le lot
+    */
+    void Graphe::ajouterArcs(const std::vector<NouvelArc>& arcs){
+        for (const auto& arc: arcs) {
+            if(!sommetExiste(arc.source)) throw logic_error("Graphe::ajouterArcs : une source est invalide");
+            if(!sommetExiste(arc.destination)) throw logic_error("Graphe::ajouterArcs : une destination est invalide");
+        }
+
+        std::vector<size_t> debut(nbSommets + 1, 0);
+        for (const auto& arc: arcs) ++debut[arc.source + 1];
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet) debut[sommet + 1] += debut[sommet];
+        std::vector<size_t> parSource(arcs.size());
+        std::vector<size_t> prochain(debut.begin(), debut.end() - 1);
+        for (size_t i = 0; i < arcs.size(); ++i) parSource[prochain[arcs[i].source]++] = i;
+
+        const size_t AUCUNE = nbSommets;
+        std::vector<size_t> estampille(nbSommets, AUCUNE);
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet) {
+            if (debut[sommet] == debut[sommet + 1]) continue;
+            for (const auto& arc: listesAdj[sommet]) estampille[arc.destination] = sommet;
+            for (auto i = debut[sommet]; i < debut[sommet + 1]; ++i) {
+                auto destination = arcs[parSource[i]].destination;
+                if (estampille[destination] == sommet) throw logic_error("Graphe::ajouterArcs : l'arc existe déjà");
+                estampille[destination] = sommet;
+            }
+        }
+
+        for (const auto& arc: arcs) {
+            listesAdj[arc.source].emplace_back(arc.destination, arc.poids);
+            if (suiviEntrants) listesEntrantes[arc.destination].emplace_back(arc.source, arc.poids);
+            aritesEntree[arc.destination]++;
+        }
+        nbArcs += arcs.size();
+        version = GrapheCompact::nouvelleVersion();
     }
 
     /**
@@ -95,16 +165,48 @@ namespace TP2
         if(!sommetExiste(destination)) throw logic_error("Graphe::enleverArc : la destination est invalide");
 
         auto& liste = listesAdj.at(source) ;
-        auto it = find_if(liste.begin(), liste.end(), [&destination](Arc e) {return e.destination == destination ; }) ;
+        auto it = find_if(liste.begin(), liste.end(), [&destination](const Arc& e) {return e.destination == destination ; }) ;
 
         if (it != liste.end())
         {
             liste.erase(it) ;
+            if (suiviEntrants) effacerArc(listesEntrantes[destination], source) ;
+            aritesEntree[destination]--;
             nbArcs--;
+            version = GrapheCompact::nouvelleVersion();
         }
         else throw logic_error("Graphe::enleverArc : l'arc n'existe pas dans le graphe") ;
     }
 
+    /**
+    * \fn void modifierPonderations(size_t source, size_t destination, float duree, float cout)
+    * \brief Fonction servant à changer sur place les pondérations d'un arc, sans le retirer ni changer sa position dans
+    * la liste d'adjacence (ni dans la liste entrante, si elle est suivie)
+    * \param[in] source le sommet source de l'arc à modifier
+    * \param[in] destination le sommet destination de l'arc à modifier
+    * \param[in] duree la nouvelle pondération durée de l'arc
+    * \param[in] cout la nouvelle pondération cout de l'arc
+    * \exception logic_error si le sommet source n'existe pas
+    * \exception logic_error si le sommet destination n'existe pas
+    * \exception logic_error si l'arc n'existe pas
+    */
+    void Graphe::modifierPonderations(size_t source, size_t destination, float duree, float cout){
+        if(!sommetExiste(source)) throw logic_error("Graphe::modifierPonderations : la source est invalide");
+        if(!sommetExiste(destination)) throw logic_error("Graphe::modifierPonderations : la destination est invalide");
+
+        auto& liste = listesAdj[source] ;
+        auto it = find_if(liste.begin(), liste.end(), [&destination](const Arc& e) {return e.destination == destination ; }) ;
+        if (it == liste.end()) throw logic_error("Graphe::modifierPonderations : l'arc n'existe pas dans le graphe") ;
+
+        it->poids.duree = duree;
+        it->poids.cout = cout;
+        if (suiviEntrants) {
+            for (auto& arc : listesEntrantes[destination])
+                if (arc.destination == source) { arc.poids = it->poids; break; }
+        }
+        version = GrapheCompact::nouvelleVersion();
+    }
+
     /**
     * \fn bool arcExiste(size_t source, size_t destination) const
     * \brief Fonction servant à savoir si un arc existe entre deux sommets d'un graphe
@@ -118,8 +220,7 @@ namespace TP2
         if(!sommetExiste(source)) throw logic_error("Graphe::arcExiste : la source est invalide");
         if(!sommetExiste(destination)) throw logic_error("Graphe::arcExiste : la destination est invalide");
 
-        auto liste = listesAdj.at(source);
-        for (auto element : liste)
+        for (const auto& element : listesAdj[source])
         {
             if(element.destination == destination)
             {
@@ -141,9 +242,9 @@ namespace TP2
         if(!sommetExiste(sommet)) throw logic_error("Graphe::listerSommetsAdjacents : le sommet est invalide");
 
         vector<size_t> sommetsAdjacents;
+        sommetsAdjacents.reserve(listesAdj[sommet].size());
 
-        auto liste = listesAdj.at(sommet);
-        for(auto arc : liste)
+        for(const auto& arc : listesAdj[sommet])
         {
             sommetsAdjacents.push_back(arc.destination);
         }
@@ -151,6 +252,20 @@ namespace TP2
         return sommetsAdjacents;
     }
 
+    /**
+    * \fn PlageArcs voisins(size_t sommet) const
+    * \brief Fonction servant à parcourir les arcs sortants d'un sommet sans les copier. Chaque élément de la plage donne
+    * la destination de l'arc et ses pondérations.
+    * \param[in] sommet le sommet dont nous voulons les arcs sortants
+    * \exception logic_error si le sommet n'existe pas
+    * \return PlageArcs une vue sur la liste d'adjacence du sommet
+    */
+    Graphe::PlageArcs Graphe::voisins(size_t sommet) const
+    {
+        if(!sommetExiste(sommet)) throw logic_error("Graphe::voisins : le sommet est invalide");
+        return PlageArcs(listesAdj[sommet].cbegin(), listesAdj[sommet].cend());
+    }
+
     /**
     * \fn std::string getNomSommet(size_t sommet) const
     * \brief Fonction servant à connaître le nom associé au sommet d'un graphe
@@ -161,23 +276,33 @@ namespace TP2
     std::string Graphe::getNomSommet(size_t sommet) const
     {
         if(!sommetExiste(sommet)) throw logic_error("Graphe::getNomSommet : le sommet est invalide");
-        return noms.at(sommet);
+        return std::string(noms[sommet]);
     }
 
     /**
     * \fn std::string getNumeroSommetconst std::string& nom) const
-    * \brief Fonction servant à connaître le numéro associé au nom du sommet d'un graphe
+    * \brief Fonction servant à connaître le numéro associé au nom du sommet d'un graphe. O(1) grâce à l'index du dictionnaire des noms.
     * \param[in] nom le nom dont nous voulons savoir le numéro de sommet
      * \exception logic_error si le nom n'existe pas
     * \return size_t le numéro du sommet
     */
     size_t Graphe::getNumeroSommet(const std::string& nom) const
     {
-        for (int i = 0; i < noms.size(); ++i)
-        {
-            if (noms[i] == nom) return i;
-        }
-        throw logic_error("Graphe::getNumeroSommet : Le nom n'existe pas");
+        auto numero = noms.chercher(nom);
+        if (numero == noms.size()) throw logic_error("Graphe::getNumeroSommet : Le nom n'existe pas");
+        return numero;
+    }
+
+    /**
+    * \fn size_t chercherSommet(std::string_view nom) const
+    * \brief Fonction servant à connaître le numéro d'un sommet sans exception ni allocation
+    * \param[in] nom le nom du sommet
+    * \return size_t le numéro du sommet, ou taille() si aucun sommet ne porte ce nom
+    */
+    size_t Graphe::chercherSommet(std::string_view nom) const
+    {
+        auto numero = noms.chercher(nom);
+        return numero == noms.size() ? taille() : numero;
     }
 
     /**
@@ -214,30 +339,38 @@ namespace TP2
     {
         if (!sommetExiste(source)) throw logic_error("Graphe::getPonderationsArc : la source est invalide");
         if(!sommetExiste(destination)) throw logic_error("Graphe::getPonderationsArc : la destination est invalide");
-        if(!arcExiste(source, destination)) throw logic_error("Graphe::getPonderationsArc : l'arc n'existe pas");
 
-        auto liste = listesAdj.at(source);
-        for(auto arc : liste)
+        for(const auto& arc : listesAdj[source])
         {
             if(arc.destination == destination)
             {
                 return arc.poids;
             }
         }
+        throw logic_error("Graphe::getPonderationsArc : l'arc n'existe pas");
     }
 
     /**
     * \fn Graphe grapheInverse() const
-    * \brief Fonction servant à inverser un Graphe et à le retourner
+    * \brief Fonction servant à inverser un Graphe et à le retourner.  Si les arcs entrants sont suivis, ils deviennent
+    * directement les listes d'adjacence de l'inverse.  Pour parcourir le graphe à rebours sans copie, voir arcsEntrants().
     * \return Graphe inverse le graphe inversé
     */
     Graphe Graphe::grapheInverse() const {
 
         Graphe inverse(listesAdj.size()) ;
 
+        if (suiviEntrants) {
+            inverse.listesAdj = listesEntrantes ;
+            inverse.listesEntrantes = listesAdj ;
+            inverse.suiviEntrants = true ;
+            inverse.nbArcs = nbArcs ;
+            for (size_t sommet = 0; sommet < nbSommets; ++sommet) inverse.aritesEntree[sommet] = listesAdj[sommet].size() ;
+            return inverse ;
+        }
+
         for (size_t depart = 0; depart < listesAdj.size(); ++depart) {
-            auto liste = listesAdj.at(depart) ;
-            for (auto arc: liste) {
+            for (const auto& arc: listesAdj[depart]) {
                 inverse.ajouterArc(arc.destination, depart, arc.poids.duree, arc.poids.cout) ;
             }
         }
@@ -247,19 +380,58 @@ namespace TP2
 
     /**
     * \fn size_t ariteEntree(size_t sommet) const
-    * \brief Fonction servant à connaître l'arité d'entrée d'un sommet
+    * \brief Fonction servant à connaître l'arité d'entrée d'un sommet. O(1): le compteur est tenu à jour par ajouterArc,
+    * enleverArc et retirerSommet.
     * \param[in] sommet le sommet dont nous voulons savoir l'arité d'entrée
     * \exception logic_error si le sommet n'existe pas
     * \return size_t l'arité d'entrée
     */
     size_t Graphe::ariteEntree(size_t sommet) const {
         if (!sommetExiste(sommet)) throw std::invalid_argument("ariteEntree: sommet invalide.") ;
-        auto arite = 0 ;
+        return aritesEntree[sommet] ;
+    }
 
-        for (const auto& liste: listesAdj)
-            for (auto elem: liste) if (elem.destination == sommet) ++ arite ;
+    /**
+    * \fn void suivreArcsEntrants(bool actif)
+    * \brief Fonction servant à activer ou désactiver le suivi des arcs entrants.  À l'activation, les listes entrantes
+    * sont construites en O(V + E); elles sont ensuite tenues à jour par ajouterArc, enleverArc, modifierPonderations et retirerSommet.
+    * \param[in] actif true pour suivre les arcs entrants, false pour libérer les listes entrantes
+    */
+    void Graphe::suivreArcsEntrants(bool actif) {
+        if (actif == suiviEntrants) return ;
+
+        listesEntrantes.clear() ;
+        listesEntrantes.shrink_to_fit() ;
+        if (actif) {
+            listesEntrantes.resize(nbSommets) ;
+            for (size_t sommet = 0; sommet < nbSommets; ++sommet)
+                for (const auto& arc: listesAdj[sommet]) listesEntrantes[arc.destination].emplace_back(sommet, arc.poids) ;
+        }
+        suiviEntrants = actif ;
+    }
 
-        return arite ;
+    /**
+    * \fn bool suitArcsEntrants() const
+    * \brief Indique si les arcs entrants sont suivis
+    * \return bool true si les listes entrantes sont tenues à jour
+    */
+    bool Graphe::suitArcsEntrants() const {
+        return suiviEntrants ;
+    }
+
+    /**
+    * \fn PlageArcs arcsEntrants(size_t sommet) const
+    * \brief Fonction servant à parcourir les arcs entrants d'un sommet sans copie, c'est-à-dire les arcs sortants du sommet
+    * dans le graphe inverse.  Le champ destination de chaque élément donne donc la source de l'arc.
+    * \param[in] sommet le sommet dont nous voulons les arcs entrants
+    * \exception logic_error si le sommet n'existe pas
+    * \exception logic_error si les arcs entrants ne sont pas suivis (voir suivreArcsEntrants)
+    * \return PlageArcs une vue sur la liste des arcs entrants du sommet
+    */
+    Graphe::PlageArcs Graphe::arcsEntrants(size_t sommet) const {
+        if (!sommetExiste(sommet)) throw logic_error("Graphe::arcsEntrants : le sommet est invalide") ;
+        if (!suiviEntrants) throw logic_error("Graphe::arcsEntrants : les arcs entrants ne sont pas suivis") ;
+        return PlageArcs(listesEntrantes[sommet].cbegin(), listesEntrantes[sommet].cend()) ;
     }
 
 
@@ -277,24 +449,53 @@ namespace TP2
 
     /**
     * \fn void retirerSommet(size_t sommet)
-    * \brief Fonction servant à retirer le sommet d'un graphe
+    * \brief Fonction servant à retirer le sommet d'un graphe, avec ses arcs sortants et entrants.  Les sommets suivants
+    * sont renumérotés.
     * \param[in] sommet le sommet à retirer
      * \exception logic_error si le sommet n'existe pas
     */
     void Graphe::retirerSommet(size_t sommet) {
         if (!sommetExiste(sommet)) throw logic_error("Graphe::retirerSommet: sommet inexistant") ;
 
-        listesAdj.erase(listesAdj.begin() + static_cast<std::vector<size_t>::difference_type> (sommet)) ;
+        for (const auto& arc: listesAdj[sommet]) {
+            aritesEntree[arc.destination]-- ;
+            if (suiviEntrants && arc.destination != sommet) effacerArc(listesEntrantes[arc.destination], sommet) ;
+        }
+        nbArcs -= listesAdj[sommet].size() ;
 
-        for (auto& liste: listesAdj) {
-            auto it = std::find_if(liste.begin(), liste.end(), [sommet](Arc element) {return element.destination == sommet; }) ;
-            if (it != liste.end()) liste.erase(it) ;
+        for (size_t autre = 0; autre < nbSommets; ++autre) {
+            if (autre == sommet) continue ;
+            if (effacerArc(listesAdj[autre], sommet)) nbArcs-- ;
         }
 
+        const auto position = static_cast<std::vector<size_t>::difference_type> (sommet) ;
+        listesAdj.erase(listesAdj.begin() + position) ;
+        aritesEntree.erase(aritesEntree.begin() + position) ;
+        if (suiviEntrants) listesEntrantes.erase(listesEntrantes.begin() + position) ;
+        noms.retirer(sommet) ;
+
         for (auto& liste: listesAdj) {
             for (auto& voisin: liste) if (voisin.destination > sommet) --voisin.destination ;
         }
+        for (auto& liste: listesEntrantes) {
+            for (auto& voisin: liste) if (voisin.destination > sommet) --voisin.destination ;
+        }
         nbSommets--;
+        version = GrapheCompact::nouvelleVersion();
+    }
+
+    /**
+    * \fn bool effacerArc(std::list<Arc>& liste, size_t extremite)
+    * \brief Fonction auxiliaire servant à effacer d'une liste l'arc dont l'autre extrémité est donnée
+    * \param[in] liste la liste d'arcs
+    * \param[in] extremite la destination (liste sortante) ou la source (liste entrante) de l'arc
+    * \return bool true si un arc a été effacé
+    */
+    bool Graphe::effacerArc(std::list<Arc>& liste, size_t extremite) {
+        auto it = std::find_if(liste.begin(), liste.end(), [extremite](const Arc& element) {return element.destination == extremite; }) ;
+        if (it == liste.end()) return false ;
+        liste.erase(it) ;
+        return true ;
     }
 
     /**
@@ -316,30 +517,196 @@ namespace TP2
     }
 
     /**
-    * \fn  std::vector<size_t> triTopologique()
-    * \brief Fonction servant faire le tri topologique d'un graphe
-    * \exception invalid_argument si le graphe est cyclique
+    * \fn  std::vector<size_t> triTopologique() const
+    * \brief Fonction servant faire le tri topologique d'un graphe avec l'algorithme de Kahn: les sommets sans arc
+    * entrant sont placés en premier, puis retirés du décompte des arités d'entrée de leurs voisins.  O(V + E), le graphe
+    * n'est pas modifié.
+    * \exception invalid_argument si le graphe est cyclique. Le message donne les noms des sommets d'un cycle.
     * \return std::vector<size_t> un vecteur comprenant les numéros de sommets dans l'ordre topologique
     */
-    std::vector<size_t> Graphe::triTopologique() {
+    std::vector<size_t> Graphe::triTopologique() const {
+        std::vector<size_t> ariteRestante;
+        auto tri = ordreKahn(ariteRestante) ;
+
+        if (tri.size() < nbSommets) {
+            std::string message = "Tri topologique: tentative de trier un graphe cyclique (cycle:" ;
+            for (auto sommet: trouverCycle()) message += " " + std::string(noms[sommet]) + "(" + std::to_string(sommet) + ")" ;
+            throw std::invalid_argument(message + ")") ;
+        }
+        return tri ;
+    }
 
-        std::vector<size_t> tri(taille(), taille()) ;
-        std::vector<size_t> index(taille()) ;
-        std::iota(index.begin(), index.end(), 0) ;
-        size_t restants = taille() ;
+    /**
+    * \fn  std::vector<size_t> trouverCycle() const
+    * \brief Fonction servant à trouver un cycle.  Après l'algorithme de Kahn, chaque sommet restant a au moins un
+    * prédécesseur restant: en remontant ces prédécesseurs on finit forcément par revenir sur un sommet déjà vu.
+    * \return std::vector<size_t> les sommets du cycle dans le sens des arcs, le premier répété à la fin; vide si le graphe est acyclique
+    */
+    std::vector<size_t> Graphe::trouverCycle() const {
+        std::vector<size_t> ariteRestante;
+        if (ordreKahn(ariteRestante).size() == nbSommets) return {} ;
+
+        const size_t AUCUN = nbSommets ;
+        std::vector<size_t> predecesseur(nbSommets, AUCUN) ;
+        size_t depart = AUCUN ;
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet) {
+            if (ariteRestante[sommet] == 0) continue ;
+            for (const auto& arc: listesAdj[sommet])
+                if (ariteRestante[arc.destination] > 0) predecesseur[arc.destination] = sommet ;
+            depart = sommet ;
+        }
 
-        while (restants > 0) {
-            size_t i = 0 ;
+        std::vector<bool> vu(nbSommets, false) ;
+        auto courant = depart ;
+        while (!vu[courant]) {
+            vu[courant] = true ;
+            courant = predecesseur[courant] ;
+        }
 
-            while (i < taille() && ariteSortie(i) != 0) ++i ;
-            if (i == taille())
-                throw std::invalid_argument("Tri topologique: tentative de trier un graphe cyclique") ;
+        std::vector<size_t> cycle(1, courant) ;
+        for (auto sommet = predecesseur[courant]; sommet != courant; sommet = predecesseur[sommet]) cycle.push_back(sommet) ;
+        cycle.push_back(courant) ;
+        std::reverse(cycle.begin(), cycle.end()) ;
+        return cycle ;
+    }
 
-            retirerSommet(i) ;
-            tri.at(-- restants) = index.at(i) ;
-            index.erase(index.begin() + static_cast<std::vector<size_t>::difference_type> (i)) ;
+    /**
+    * \fn  std::vector<size_t> ordreKahn(std::vector<size_t>& ariteRestante) const
+    * \brief Algorithme de Kahn.  Les sommets qui ne sont pas placés dans l'ordre sont ceux qui sont sur un cycle ou
+    * qui en sont accessibles; ils gardent une arité restante non nulle.
+    * \param[out] ariteRestante l'arité d'entrée de chaque sommet qui n'a pas pu être placé, 0 pour les autres
+    * \return std::vector<size_t> les sommets placés, en ordre topologique
+    */
+    std::vector<size_t> Graphe::ordreKahn(std::vector<size_t>& ariteRestante) const {
+        ariteRestante.assign(nbSommets, 0) ;
+        for (const auto& liste: listesAdj)
+            for (const auto& arc: liste) ++ariteRestante[arc.destination] ;
+
+        std::vector<size_t> ordre ;
+        ordre.reserve(nbSommets) ;
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet)
+            if (ariteRestante[sommet] == 0) ordre.push_back(sommet) ;
+
+        for (size_t i = 0; i < ordre.size(); ++i)
+            for (const auto& arc: listesAdj[ordre[i]])
+                if (--ariteRestante[arc.destination] == 0) ordre.push_back(arc.destination) ;
+
+        return ordre ;
+    }
+
+    /**
+    * \fn  Graphe condensation(const Composantes& composantes) const
+    * \brief Fonction servant à construire le graphe condensé à partir des composantes fortement connexes.  Les arcs
+    * parallèles entre deux composantes sont fusionnés en gardant la plus petite durée et le plus petit coût, ce qui fait
+    * des pondérations du graphe condensé des bornes inférieures.  O(V + E).
+    * \param[in] composantes le numéro de composante de chaque sommet (voir GrapheCompact::composantesFortementConnexes)
+    * \exception logic_error si composantes n'a pas un numéro valide par sommet
+    * \return Graphe le graphe condensé, acyclique
+    */
+    Graphe Graphe::condensation(const Composantes& composantes) const {
+        if (composantes.numeros.size() != nbSommets) throw logic_error("Graphe::condensation : les composantes ne correspondent pas au graphe") ;
+
+        Graphe dag(composantes.nombre) ;
+        std::vector<size_t> representant(composantes.nombre, nbSommets) ;
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet) {
+            auto c = composantes.numeros[sommet] ;
+            if (c >= composantes.nombre) throw logic_error("Graphe::condensation : numéro de composante invalide") ;
+            if (representant[c] == nbSommets) representant[c] = sommet ;
         }
-        return tri ;
+        for (size_t c = 0; c < composantes.nombre; ++c)
+            if (representant[c] != nbSommets) dag.noms.nommer(c, noms[representant[c]]) ;
+
+        //Les sommets sont regroupés par composante (tri par dénombrement) pour traiter tous les arcs d'une composante d'un coup
+        std::vector<size_t> debut(composantes.nombre + 1, 0) ;
+        for (auto c: composantes.numeros) ++debut[c + 1] ;
+        for (size_t c = 0; c < composantes.nombre; ++c) debut[c + 1] += debut[c] ;
+        std::vector<size_t> membres(nbSommets) ;
+        std::vector<size_t> prochain(debut.begin(), debut.end() - 1) ;
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet) membres[prochain[composantes.numeros[sommet]]++] = sommet ;
+
+        //arcVers[d] pointe vers l'arc source -> d déjà créé pour la composante source courante
+        std::vector<size_t> derniereSource(composantes.nombre, composantes.nombre) ;
+        std::vector<Arc*> arcVers(composantes.nombre, nullptr) ;
+        for (size_t i = 0; i < nbSommets; ++i) {
+            auto sommet = membres[i] ;
+            auto source = composantes.numeros[sommet] ;
+            for (const auto& arc: listesAdj[sommet]) {
+                auto destination = composantes.numeros[arc.destination] ;
+                if (destination == source) continue ;
+
+                if (derniereSource[destination] == source) {
+                    auto& poids = arcVers[destination]->poids ;
+                    poids.duree = std::min(poids.duree, arc.poids.duree) ;
+                    poids.cout = std::min(poids.cout, arc.poids.cout) ;
+                }
+                else {
+                    dag.listesAdj[source].emplace_back(destination, arc.poids) ;
+                    dag.aritesEntree[destination]++ ;
+                    dag.nbArcs++ ;
+                    derniereSource[destination] = source ;
+                    arcVers[destination] = &dag.listesAdj[source].back() ;
+                }
+            }
+        }
+        return dag ;
+    }
+
+    /**
+    * \fn  GrapheCompact figer() const
+    * \brief Fonction servant à produire un instantané immuable du graphe en lignes creuses compressées (CSR): un tableau
+    * des positions de début des arcs de chaque sommet, puis les destinations, durées et coûts des arcs dans des tableaux
+    * séparés.  Les arcs gardent l'ordre des listes d'adjacence.  Les arcs entrants sont copiés des listes entrantes si
+    * elles sont suivies, sinon obtenus par transposition.  Les noms sont recopiés bout à bout et indexés.  L'instantané
+    * porte la version du graphe.
+    * \exception length_error si le nombre de sommets ou d'arcs ne tient pas sur 32 bits
+    * \return GrapheCompact l'instantané du graphe
+    */
+    GrapheCompact Graphe::figer() const {
+        const size_t limite = std::numeric_limits<std::uint32_t>::max();
+
+        size_t total = 0;
+        for (const auto& liste: listesAdj) total += liste.size();
+        if (nbSommets >= limite || total >= limite) throw length_error("Graphe::figer : le graphe est trop grand pour un instantané 32 bits");
+
+        auto stockage = std::make_shared<GrapheCompact::Stockage>();
+
+        auto copier = [&](const std::vector<std::list<Arc> >& listes, int sens) {
+            auto& debuts = stockage->debuts[sens];
+            auto& voisins = stockage->voisins[sens];
+            auto& durees = stockage->durees[sens];
+            auto& couts = stockage->couts[sens];
+
+            debuts.resize(nbSommets + 1);
+            voisins.reserve(total);
+            durees.reserve(total);
+            couts.reserve(total);
+
+            debuts[0] = 0;
+            for (size_t sommet = 0; sommet < nbSommets; ++sommet) {
+                for (const auto& arc: listes[sommet]) {
+                    voisins.push_back(static_cast<std::uint32_t>(arc.destination));
+                    durees.push_back(arc.poids.duree);
+                    couts.push_back(arc.poids.cout);
+                }
+                debuts[sommet + 1] = static_cast<std::uint32_t>(voisins.size());
+            }
+        };
+
+        copier(listesAdj, 0);
+        if (suiviEntrants) copier(listesEntrantes, 1);
+        else stockage->transposer(nbSommets);
+
+        stockage->debutsNoms.resize(nbSommets + 1);
+        stockage->debutsNoms[0] = 0;
+        for (size_t sommet = 0; sommet < nbSommets; ++sommet) {
+            stockage->octetsNoms.append(noms[sommet]);
+            stockage->debutsNoms[sommet + 1] = static_cast<std::uint32_t>(stockage->octetsNoms.size());
+        }
+        stockage->indexerNoms(nbSommets);
+
+        GrapheCompact compact(stockage);
+        compact.version = version;
+        return compact;
     }
 
 }//Fin du namespace
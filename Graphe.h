@@ -16,6 +16,11 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cstdint>
+#include "DictionnaireNoms.h"
+#include "GrapheCompact.h"
 //Vous pouvez ajouter d'autres librairies de la STL
 
 #ifndef _GRAPHE__H
@@ -43,8 +48,17 @@ class Graphe
 public:
 
 	Graphe(size_t nbSommets = 10);
+
+	// Reconstruit un graphe modifiable (noms, arcs dans l'ordre de l'instantané) à partir d'un instantané. O(V + E).
+	explicit Graphe(const GrapheCompact& compact);
+
 	~Graphe();
 
+	Graphe(const Graphe&) = default;
+	Graphe(Graphe&&) = default;
+	Graphe& operator=(const Graphe&) = default;
+	Graphe& operator=(Graphe&&) = default;
+
 	// Change la taille du graphe en utilisant un nombre de sommet = nouvelleTaille
 	// Vous pouvez supposer que cette méthode va être appliquée uniquement sur un graphe vide.
 	void resize(size_t nouvelleTaille);
@@ -63,6 +77,11 @@ public:
 	// Exception logic_error si l'arc n'existe pas dans le graphe
 	void enleverArc(size_t source, size_t destination);
 
+	// Change les pondérations d'un arc existant, sur place (l'ordre des arcs ne change pas)
+	// Exception logic_error si source ou destination supérieur à nbSommets
+	// Exception logic_error si l'arc n'existe pas dans le graphe
+	void modifierPonderations(size_t source, size_t destination, float duree, float cout);
+
 	// Vérifie si un arc existe
 	// Exception logic_error si source ou destination supérieur à nbSommets
 	bool arcExiste(size_t source, size_t destination) const;
@@ -125,12 +144,33 @@ public:
 
     bool sommetExiste(size_t numero) const ;
 
-    std::vector<size_t> triTopologique();
-
-private:
-
-	std::vector<std::string> noms; /*!< les noms des sommets */
-
+    // Retourne les sommets en ordre topologique (algorithme de Kahn, O(V + E)). Le graphe n'est pas modifié.
+    // Exception invalid_argument si le graphe est cyclique; le message donne un cycle
+    std::vector<size_t> triTopologique() const;
+
+    // Retourne un cycle du graphe (s0, s1, ..., s0), ou un vecteur vide si le graphe est acyclique. O(V + E).
+    std::vector<size_t> trouverCycle() const;
+
+    // Retourne le graphe condensé: un sommet par composante (numéroté comme dans composantes), un arc entre deux
+    // composantes distinctes dès qu'un arc relie leurs sommets, avec la plus petite durée et le plus petit coût.
+    // Le graphe condensé est toujours acyclique. Chaque composante porte le nom de son plus petit sommet.
+    // Exception logic_error si composantes ne couvre pas les sommets du graphe
+    Graphe condensation(const Composantes& composantes) const;
+
+    // Retourne un instantané immuable du graphe et de ses noms en format CSR (voir GrapheCompact). O(V + E).
+    // Exception length_error si le graphe compte 2^32 - 1 sommets ou arcs et plus
+    GrapheCompact figer() const;
+
+    // Retourne la version du graphe: un numéro qui change à chaque modification (resize, nommer, ajouterArc,
+    // ajouterArcs, enleverArc, modifierPonderations, retirerSommet) et que deux graphes de contenus différents ne
+    // partagent jamais.
+    // L'instantané donné par figer() porte la version du graphe.
+    std::uint64_t getVersion() const { return version; }
+
+	/**
+	 * \struct Arc
+	 * \brief Un arc sortant tel que stocké dans les listes d'adjacence: sa destination et ses pondérations
+	 */
 	struct Arc
 	{
 		size_t destination;
@@ -139,15 +179,83 @@ private:
 		Arc(size_t dest, Ponderations p) : destination(dest), poids(p) {}
 	};
 
+	/**
+	 * \class PlageArcs
+	 * \brief Vue sur les arcs sortants d'un sommet, lus directement dans la liste d'adjacence (aucune copie).
+	 *  La vue est invalidée par toute modification des arcs du sommet.
+	 */
+	class PlageArcs
+	{
+	public:
+		using const_iterator = std::list<Arc>::const_iterator;
+
+		PlageArcs(const_iterator debut, const_iterator fin) : debut(debut), fin(fin) {}
+
+		const_iterator begin() const { return debut; }
+		const_iterator end() const { return fin; }
+		bool empty() const { return debut == fin; }
+
+	private:
+		const_iterator debut;
+		const_iterator fin;
+	};
+
+	/**
+	 * \struct NouvelArc
+	 * \brief Un arc à ajouter par ajouterArcs
+	 */
+	struct NouvelArc
+	{
+		size_t source;
+		size_t destination;
+		Ponderations poids;
+	};
+
+	// Ajoute un lot d'arcs, dans l'ordre du vecteur. Tout le lot est validé avant le premier ajout. O(V + E + lot).
+	// Exception logic_error si une source ou une destination est supérieure à nbSommets
+	// Exception logic_error si un arc du lot existe déjà dans le graphe ou apparaît deux fois dans le lot
+	void ajouterArcs(const std::vector<NouvelArc>& arcs);
+
+	// Retourne le numéro du sommet portant ce nom, ou taille() s'il n'existe pas. O(1), sans allocation.
+	size_t chercherSommet(std::string_view nom) const;
+
+	// Retourne une vue sur les arcs sortants d'un sommet, sans allocation
+	// Exception logic_error si sommet supérieur à nbSommets
+	PlageArcs voisins(size_t sommet) const;
+
+	// Active ou désactive le suivi des arcs entrants (désactivé par défaut). L'arité d'entrée est toujours suivie.
+	void suivreArcsEntrants(bool actif);
+
+	// Indique si les arcs entrants sont suivis
+	bool suitArcsEntrants() const;
+
+	// Retourne une vue sur les arcs entrants d'un sommet (le champ destination donne la source), sans allocation
+	// Exception logic_error si sommet supérieur à nbSommets
+	// Exception logic_error si les arcs entrants ne sont pas suivis
+	PlageArcs arcsEntrants(size_t sommet) const;
+
+private:
+
+	DictionnaireNoms noms; /*!< les noms des sommets, internés et indexés par nom */
+
 	std::vector<std::list<Arc> > listesAdj; /*!< les listes d'adjacence */
 
 
 	size_t nbSommets;	// Le nombre de sommets dans le graphe
 	size_t nbArcs;		// Le nombre des arcs dans le graphe
 
+	std::vector<size_t> aritesEntree;				/*!< l'arité d'entrée de chaque sommet */
+	std::vector<std::list<Arc> > listesEntrantes;	/*!< les arcs entrants de chaque sommet (destination = source de l'arc), si suiviEntrants */
+	bool suiviEntrants;								// Les listes entrantes sont-elles tenues à jour?
+	std::uint64_t version;							// La version du contenu (voir getVersion)
+
 
 	//Vous pouvez ajoutez des méthodes privées si vous sentez leur nécessité
 
+	std::vector<size_t> ordreKahn(std::vector<size_t>& ariteRestante) const;
+
+	static bool effacerArc(std::list<Arc>& liste, size_t extremite);
+
 
 
 };
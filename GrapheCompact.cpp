@@ -0,0 +1,612 @@
+/**
+ * \file GrapheCompact.cpp
+ * \brief Implémentation de l'instantané figé (CSR) d'un graphe.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "GrapheCompact.h"
+#include "Graphe.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TP2_PROJECTION_MEMOIRE 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace TP2
+{
+    namespace
+    {
+        const char SIGNATURE[8] = {'T', 'P', '2', 'C', 'S', 'R', '\0', '\0'};
+        const std::uint32_t VERSION_INSTANTANE = 1;
+        const std::uint32_t TEMOIN_BOUTISME = 0x01020304u;
+
+        /**
+         * \struct Entete
+         * \brief L'entête d'un fichier d'instantané (64 octets)
+         */
+        struct Entete
+        {
+            char signature[8];
+            std::uint32_t version;
+            std::uint32_t boutisme;
+            std::uint64_t nbSommets;
+            std::uint64_t nbArcs;
+            std::uint64_t nbAlveoles;
+            std::uint64_t octetsNoms;
+            std::uint64_t octetsEtiquette;
+            std::uint64_t tailleFichier;
+        };
+        static_assert(sizeof(Entete) == 64, "L'entête d'un instantané doit faire 64 octets");
+
+        /**
+         * \struct Sections
+         * \brief La position de chaque section d'un fichier d'instantané, déduite des nombres de l'entête
+         */
+        struct Sections
+        {
+            size_t etiquette, debutsNoms, octetsNoms, alveoles;
+            size_t debuts[2], voisins[2], durees[2], couts[2];
+            size_t fin;
+        };
+
+        size_t aligner(size_t position) {
+            return (position + 7) & ~static_cast<size_t>(7);
+        }
+
+        Sections disposer(const Entete& entete) {
+            const size_t n = entete.nbSommets, m = entete.nbArcs;
+            Sections s;
+            size_t position = sizeof(Entete);
+            auto reserver = [&position](size_t& section, size_t octets) {
+                section = position;
+                position = aligner(position + octets);
+            };
+
+            reserver(s.etiquette, entete.octetsEtiquette);
+            reserver(s.debutsNoms, (n + 1) * sizeof(std::uint32_t));
+            reserver(s.octetsNoms, entete.octetsNoms);
+            reserver(s.alveoles, 2 * entete.nbAlveoles * sizeof(std::uint32_t));
+            for (int sens = 0; sens < 2; ++sens) {
+                reserver(s.debuts[sens], (n + 1) * sizeof(std::uint32_t));
+                reserver(s.voisins[sens], m * sizeof(std::uint32_t));
+                reserver(s.durees[sens], m * sizeof(float));
+                reserver(s.couts[sens], m * sizeof(float));
+            }
+            s.fin = position;
+            return s;
+        }
+
+        /**
+         * \class Projection
+         * \brief Un fichier projeté en lecture seule en mémoire (mmap), ou lu en entier là où mmap n'existe pas.
+         *  Sert de propriétaire aux tableaux d'un instantané chargé.
+         */
+        class Projection
+        {
+        public:
+            explicit Projection(const std::string& fichier);
+            ~Projection();
+            Projection(const Projection&) = delete;
+            Projection& operator=(const Projection&) = delete;
+
+            const char* donnees() const { return adresse; }
+            size_t taille() const { return octets; }
+
+        private:
+            const char* adresse = nullptr;
+            size_t octets = 0;
+#ifndef TP2_PROJECTION_MEMOIRE
+            std::vector<std::uint64_t> copie;	// alignée sur 8 octets, comme une page projetée
+#endif
+        };
+
+#ifdef TP2_PROJECTION_MEMOIRE
+        Projection::Projection(const std::string& fichier) {
+            int descripteur = ::open(fichier.c_str(), O_RDONLY);
+            if (descripteur < 0) throw std::logic_error("GrapheCompact::charger : impossible d'ouvrir " + fichier);
+
+            struct stat etat;
+            if (::fstat(descripteur, &etat) != 0 || etat.st_size < static_cast<off_t>(sizeof(Entete))) {
+                ::close(descripteur);
+                throw std::logic_error("GrapheCompact::charger : " + fichier + " n'est pas un instantané");
+            }
+            octets = static_cast<size_t>(etat.st_size);
+
+            void* projection = ::mmap(nullptr, octets, PROT_READ, MAP_PRIVATE, descripteur, 0);
+            ::close(descripteur);
+            if (projection == MAP_FAILED) throw std::logic_error("GrapheCompact::charger : impossible de projeter " + fichier);
+            adresse = static_cast<const char*>(projection);
+        }
+
+        Projection::~Projection() {
+            ::munmap(const_cast<char*>(adresse), octets);
+        }
+#else
+        Projection::Projection(const std::string& fichier) {
+            std::ifstream entree(fichier, std::ios::binary | std::ios::ate);
+            if (!entree) throw std::logic_error("GrapheCompact::charger : impossible d'ouvrir " + fichier);
+
+            octets = static_cast<size_t>(entree.tellg());
+            copie.resize((octets + 7) / 8);
+            entree.seekg(0);
+            if (!entree.read(reinterpret_cast<char*>(copie.data()), static_cast<std::streamsize>(octets)))
+                throw std::logic_error("GrapheCompact::charger : lecture incomplète de " + fichier);
+            adresse = reinterpret_cast<const char*>(copie.data());
+        }
+
+        Projection::~Projection() {
+        }
+#endif
+    }
+
+    /**
+    * \fn GrapheCompact::GrapheCompact()
+    * \brief Constructeur par défaut: un graphe sans sommet
+    */
+    GrapheCompact::GrapheCompact() : GrapheCompact(std::make_shared<Stockage>()) {
+    }
+
+    /**
+    * \fn GrapheCompact::GrapheCompact(std::shared_ptr<const Stockage> stockage)
+    * \brief Constructeur à partir de tableaux en mémoire. Des tableaux vides donnent un graphe sans sommet.
+    * \param[in] stockage les tableaux des arcs sortants et entrants
+    */
+    GrapheCompact::GrapheCompact(std::shared_ptr<const Stockage> stockage) : nbSommets(0), nbArcs(0), version(nouvelleVersion()) {
+        static const std::uint32_t AUCUN_ARC[1] = {0};
+
+        Sens* sens[2] = {&sortants, &entrants};
+        for (int i = 0; i < 2; ++i) {
+            sens[i]->debuts = stockage->debuts[i].empty() ? AUCUN_ARC : stockage->debuts[i].data();
+            sens[i]->voisins = stockage->voisins[i].data();
+            sens[i]->durees = stockage->durees[i].data();
+            sens[i]->couts = stockage->couts[i].data();
+        }
+        noms.debuts = stockage->debutsNoms.empty() ? AUCUN_ARC : stockage->debutsNoms.data();
+        noms.octets = stockage->octetsNoms.data();
+        noms.alveoles = stockage->alveolesNoms.data();
+        noms.nbAlveoles = stockage->alveolesNoms.size() / 2;
+        if (!stockage->debuts[0].empty()) nbSommets = stockage->debuts[0].size() - 1;
+        nbArcs = stockage->voisins[0].size();
+        proprietaire = std::move(stockage);
+    }
+
+    /**
+    * \fn std::uint64_t GrapheCompact::nouvelleVersion()
+    * \brief Donne un numéro de version unique, tiré d'un compteur commun à tous les graphes et à tous les fils
+    * \return std::uint64_t la nouvelle version
+    */
+    std::uint64_t GrapheCompact::nouvelleVersion() {
+        static std::atomic<std::uint64_t> compteur(0);
+        return ++compteur;
+    }
+
+    /**
+    * \fn Ponderations GrapheCompact::getPonderations(size_t arc) const
+    * \brief Donne les pondérations d'un arc sortant
+    * \param[in] arc l'indice de l'arc
+    * \return Ponderations la durée et le coût de l'arc
+    */
+    Ponderations GrapheCompact::getPonderations(size_t arc) const {
+        Ponderations p;
+        p.duree = sortants.durees[arc];
+        p.cout = sortants.couts[arc];
+        return p;
+    }
+
+    /**
+    * \fn Ponderations GrapheCompact::getPonderationsEntrant(size_t arc) const
+    * \brief Donne les pondérations d'un arc entrant
+    * \param[in] arc l'indice de l'arc dans l'espace des arcs entrants
+    * \return Ponderations la durée et le coût de l'arc
+    */
+    Ponderations GrapheCompact::getPonderationsEntrant(size_t arc) const {
+        Ponderations p;
+        p.duree = entrants.durees[arc];
+        p.cout = entrants.couts[arc];
+        return p;
+    }
+
+    /**
+    * \fn void GrapheCompact::modifierPonderations(size_t source, size_t destination, float duree, float cout)
+    * \brief Change les pondérations d'un arc dans les deux espaces d'arcs.  Si les pondérations ne sont pas encore
+    * propres à cet instantané (tableaux de Stockage ou du fichier projeté, ou copie partagée avec un autre instantané),
+    * les quatre tableaux sont d'abord recopiés; les autres copies de l'instantané gardent les anciennes pondérations.
+    * \param[in] source le sommet source de l'arc
+    * \param[in] destination le sommet destination de l'arc
+    * \param[in] duree la nouvelle durée de l'arc
+    * \param[in] cout le nouveau coût de l'arc
+    * \exception logic_error si la source ou la destination n'existe pas
+    * \exception logic_error si l'arc n'existe pas
+    */
+    void GrapheCompact::modifierPonderations(size_t source, size_t destination, float duree, float cout) {
+        if (source >= taille()) throw std::logic_error("GrapheCompact::modifierPonderations : la source est invalide");
+        if (destination >= taille()) throw std::logic_error("GrapheCompact::modifierPonderations : la destination est invalide");
+
+        size_t arcSortant = finArcs(source), arcEntrant = finArcsEntrants(destination);
+        for (auto arc = debutArcs(source); arc < finArcs(source); ++arc)
+            if (sortants.voisins[arc] == destination) { arcSortant = arc; break; }
+        for (auto arc = debutArcsEntrants(destination); arc < finArcsEntrants(destination); ++arc)
+            if (entrants.voisins[arc] == source) { arcEntrant = arc; break; }
+        if (arcSortant == finArcs(source) || arcEntrant == finArcsEntrants(destination))
+            throw std::logic_error("GrapheCompact::modifierPonderations : l'arc n'existe pas dans le graphe");
+
+        Sens* sens[2] = {&sortants, &entrants};
+        if (!ponderationsPropres || ponderationsPropres.use_count() > 1) {
+            auto copie = std::make_shared<PonderationsPropres>();
+            for (int i = 0; i < 2; ++i) {
+                copie->durees[i].assign(sens[i]->durees, sens[i]->durees + nbArcs);
+                copie->couts[i].assign(sens[i]->couts, sens[i]->couts + nbArcs);
+                sens[i]->durees = copie->durees[i].data();
+                sens[i]->couts = copie->couts[i].data();
+            }
+            ponderationsPropres = std::move(copie);
+        }
+
+        //Les tableaux appartiennent à ponderationsPropres, dont cet instantané est le seul détenteur
+        const size_t arcs[2] = {arcSortant, arcEntrant};
+        for (int i = 0; i < 2; ++i) {
+            const_cast<float*>(sens[i]->durees)[arcs[i]] = duree;
+            const_cast<float*>(sens[i]->couts)[arcs[i]] = cout;
+        }
+        version = nouvelleVersion();
+    }
+
+    /**
+    * \fn std::string_view GrapheCompact::nom(size_t sommet) const
+    * \brief Donne le nom d'un sommet, sans copie
+    * \param[in] sommet le sommet (doit être inférieur à taille())
+    * \return std::string_view une vue sur le nom dans la table des noms
+    */
+    std::string_view GrapheCompact::nom(size_t sommet) const {
+        return std::string_view(noms.octets + noms.debuts[sommet], noms.debuts[sommet + 1] - noms.debuts[sommet]);
+    }
+
+    /**
+    * \fn size_t GrapheCompact::chercherSommet(std::string_view nom) const
+    * \brief Cherche le numéro du sommet portant un nom, par l'index des noms.  Comme dans DictionnaireNoms, les sommets
+    * sans nom ne sont pas indexés: chercher le nom vide balaye les sommets.
+    * \param[in] nom le nom recherché
+    * \return size_t le plus petit numéro de sommet portant ce nom, ou taille() si aucun
+    */
+    size_t GrapheCompact::chercherSommet(std::string_view nom) const {
+        if (nom.empty()) {
+            for (size_t s = 0; s < taille(); ++s)
+                if (noms.debuts[s] == noms.debuts[s + 1]) return s;
+            return taille();
+        }
+        if (noms.nbAlveoles == 0) return taille();
+
+        const auto code = DictionnaireNoms::hacher(nom);
+        const auto empreinte = static_cast<std::uint32_t>(code);
+        const size_t masque = noms.nbAlveoles - 1;
+        for (size_t i = code & masque; ; i = (i + 1) & masque) {
+            auto numero = noms.alveoles[2 * i];
+            if (numero == AUCUN) return taille();
+            if (noms.alveoles[2 * i + 1] == empreinte && this->nom(numero) == nom) return numero;
+        }
+    }
+
+    /**
+    * \fn size_t GrapheCompact::ariteSortie(size_t sommet) const
+    * \brief Donne l'arité de sortie d'un sommet
+    * \param[in] sommet le sommet
+    * \exception logic_error si le sommet n'existe pas
+    * \return size_t l'arité de sortie
+    */
+    size_t GrapheCompact::ariteSortie(size_t sommet) const {
+        if (sommet >= taille()) throw std::logic_error("GrapheCompact::ariteSortie : le sommet est invalide");
+        return finArcs(sommet) - debutArcs(sommet);
+    }
+
+    /**
+    * \fn size_t GrapheCompact::ariteEntree(size_t sommet) const
+    * \brief Donne l'arité d'entrée d'un sommet
+    * \param[in] sommet le sommet
+    * \exception logic_error si le sommet n'existe pas
+    * \return size_t l'arité d'entrée
+    */
+    size_t GrapheCompact::ariteEntree(size_t sommet) const {
+        if (sommet >= taille()) throw std::logic_error("GrapheCompact::ariteEntree : le sommet est invalide");
+        return finArcsEntrants(sommet) - debutArcsEntrants(sommet);
+    }
+
+    /**
+    * \fn std::uint64_t GrapheCompact::empreinte() const
+    * \brief Donne l'empreinte FNV-1a des tableaux des arcs sortants (débuts, destinations, durées, coûts), hachés mot par
+    * mot.  Les arcs entrants en sont tirés et n'ajoutent rien.
+    * \return std::uint64_t l'empreinte
+    */
+    std::uint64_t GrapheCompact::empreinte() const {
+        std::uint64_t h = 14695981039346656037ull;
+        auto melanger = [&h](const void* tableau, size_t nombre) {
+            const char* octets = static_cast<const char*>(tableau);
+            for (size_t i = 0; i < nombre; ++i) {
+                std::uint32_t mot;
+                std::memcpy(&mot, octets + i * sizeof(mot), sizeof(mot));
+                h ^= mot;
+                h *= 1099511628211ull;
+            }
+        };
+        static_assert(sizeof(float) == sizeof(std::uint32_t), "les pondérations sont hachées comme des mots de 32 bits");
+        const std::uint64_t dimensions[2] = {nbSommets, nbArcs};
+        melanger(dimensions, 4);
+        melanger(sortants.debuts, nbSommets + 1);
+        melanger(sortants.voisins, nbArcs);
+        melanger(sortants.durees, nbArcs);
+        melanger(sortants.couts, nbArcs);
+        return h;
+    }
+
+    /**
+    * \fn GrapheCompact GrapheCompact::inverse() const
+    * \brief Donne le graphe inverse, qui partage les mêmes tableaux: ses arcs sortants sont nos arcs entrants
+    * \return GrapheCompact le graphe inversé
+    */
+    GrapheCompact GrapheCompact::inverse() const {
+        GrapheCompact inv(*this);
+        std::swap(inv.sortants, inv.entrants);
+        return inv;
+    }
+
+    /**
+    * \fn void GrapheCompact::Stockage::transposer(size_t nbSommets)
+    * \brief Construit les tableaux des arcs entrants à partir des arcs sortants, par un tri par dénombrement des arcs
+    * selon leur destination. Les arcs entrants d'un sommet y apparaissent par ordre croissant de source.
+    * \param[in] nbSommets le nombre de sommets
+    */
+    void GrapheCompact::Stockage::transposer(size_t nbSommets) {
+        const size_t nbArcs = voisins[0].size();
+        debuts[1].assign(nbSommets + 1, 0);
+        voisins[1].resize(nbArcs);
+        durees[1].resize(nbArcs);
+        couts[1].resize(nbArcs);
+
+        for (auto d: voisins[0]) ++debuts[1][d + 1];
+        for (size_t s = 0; s < nbSommets; ++s) debuts[1][s + 1] += debuts[1][s];
+
+        std::vector<std::uint32_t> prochain(debuts[1].begin(), debuts[1].end() - 1);
+        for (size_t s = 0; s < nbSommets; ++s) {
+            for (size_t arc = debuts[0][s]; arc < debuts[0][s + 1]; ++arc) {
+                auto position = prochain[voisins[0][arc]]++;
+                voisins[1][position] = static_cast<std::uint32_t>(s);
+                durees[1][position] = durees[0][arc];
+                couts[1][position] = couts[0][arc];
+            }
+        }
+    }
+
+    /**
+    * \fn void GrapheCompact::Stockage::indexerNoms(size_t nbSommets)
+    * \brief Construit l'index des noms (au moins deux alvéoles par sommet).  Les sommets sont indexés par numéro croissant,
+    * de sorte qu'un nom porté plusieurs fois reste associé au plus petit numéro.
+    * \param[in] nbSommets le nombre de sommets
+    */
+    void GrapheCompact::Stockage::indexerNoms(size_t nbSommets) {
+        size_t capacite = 16;
+        while (capacite < 2 * nbSommets) capacite *= 2;
+        alveolesNoms.assign(2 * capacite, AUCUN);
+
+        const size_t masque = capacite - 1;
+        for (size_t s = 0; s < nbSommets; ++s) {
+            std::string_view nom(octetsNoms.data() + debutsNoms[s], debutsNoms[s + 1] - debutsNoms[s]);
+            if (nom.empty()) continue;
+
+            const auto code = DictionnaireNoms::hacher(nom);
+            for (size_t i = code & masque; ; i = (i + 1) & masque) {
+                auto numero = alveolesNoms[2 * i];
+                if (numero == AUCUN) {
+                    alveolesNoms[2 * i] = static_cast<std::uint32_t>(s);
+                    alveolesNoms[2 * i + 1] = static_cast<std::uint32_t>(code);
+                    break;
+                }
+                if (alveolesNoms[2 * i + 1] == static_cast<std::uint32_t>(code)
+                    && std::string_view(octetsNoms.data() + debutsNoms[numero], debutsNoms[numero + 1] - debutsNoms[numero]) == nom) break;
+            }
+        }
+    }
+
+    /**
+    * \fn Composantes GrapheCompact::composantesFortementConnexes() const
+    * \brief Algorithme de Tarjan.  La récursion est remplacée par une pile explicite de (sommet, prochain arc), ce qui
+    * permet de traiter de très longues chaînes sans déborder la pile d'appels.  Une composante est fermée lorsque son
+    * premier sommet visité est abandonné avec lien[s] == ordre[s]; elle reçoit alors le prochain numéro, d'où
+    * la numérotation en ordre topologique inverse.
+    * \return Composantes le numéro de composante de chaque sommet et le nombre de composantes
+    */
+    Composantes GrapheCompact::composantesFortementConnexes() const {
+        const std::uint32_t NON_VISITE = std::numeric_limits<std::uint32_t>::max();
+
+        Composantes resultat;
+        resultat.numeros.assign(taille(), 0);
+
+        std::vector<std::uint32_t> ordre(taille(), NON_VISITE);	// rang de découverte
+        std::vector<std::uint32_t> lien(taille(), 0);				// plus petit rang atteignable encore sur la pile
+        std::vector<bool> surPile(taille(), false);
+        std::vector<std::uint32_t> pile;							// sommets des composantes non fermées
+        std::vector<std::pair<std::uint32_t, std::uint32_t> > appels;	// (sommet, prochain arc à examiner)
+        std::uint32_t rang = 0;
+
+        auto decouvrir = [&](std::uint32_t sommet) {
+            ordre[sommet] = lien[sommet] = rang++;
+            pile.push_back(sommet);
+            surPile[sommet] = true;
+            appels.emplace_back(sommet, sortants.debuts[sommet]);
+        };
+
+        for (std::uint32_t racine = 0; racine < taille(); ++racine) {
+            if (ordre[racine] != NON_VISITE) continue;
+            decouvrir(racine);
+
+            while (!appels.empty()) {
+                auto sommet = appels.back().first;
+                auto arc = appels.back().second;
+
+                if (arc < sortants.debuts[sommet + 1]) {
+                    ++appels.back().second;
+                    auto voisin = sortants.voisins[arc];
+                    if (ordre[voisin] == NON_VISITE) decouvrir(voisin);
+                    else if (surPile[voisin]) lien[sommet] = std::min(lien[sommet], ordre[voisin]);
+                    continue;
+                }
+
+                if (lien[sommet] == ordre[sommet]) {
+                    std::uint32_t membre;
+                    do {
+                        membre = pile.back();
+                        pile.pop_back();
+                        surPile[membre] = false;
+                        resultat.numeros[membre] = resultat.nombre;
+                    } while (membre != sommet);
+                    ++resultat.nombre;
+                }
+
+                appels.pop_back();
+                if (!appels.empty()) {
+                    auto parent = appels.back().first;
+                    lien[parent] = std::min(lien[parent], lien[sommet]);
+                }
+            }
+        }
+        return resultat;
+    }
+
+    /**
+    * \fn void GrapheCompact::sauvegarder(const std::string& fichier, std::string_view etiquette) const
+    * \brief Écrit l'instantané dans un fichier binaire (voir le format dans GrapheCompact.h).  Les tableaux sont écrits
+    * tels quels, un bloc par section.
+    * \param[in] fichier le chemin du fichier à écrire (remplacé s'il existe)
+    * \param[in] etiquette le texte libre conservé avec l'instantané
+    * \exception logic_error si le fichier ne peut pas être écrit
+    */
+    void GrapheCompact::sauvegarder(const std::string& fichier, std::string_view etiquette) const {
+        Entete entete;
+        std::memcpy(entete.signature, SIGNATURE, sizeof(SIGNATURE));
+        entete.version = VERSION_INSTANTANE;
+        entete.boutisme = TEMOIN_BOUTISME;
+        entete.nbSommets = nbSommets;
+        entete.nbArcs = nbArcs;
+        entete.nbAlveoles = noms.nbAlveoles;
+        entete.octetsNoms = noms.debuts[nbSommets];
+        entete.octetsEtiquette = etiquette.size();
+        entete.tailleFichier = 0;
+        entete.tailleFichier = disposer(entete).fin;
+
+        std::ofstream sortie(fichier, std::ios::binary | std::ios::trunc);
+        if (!sortie) throw std::logic_error("GrapheCompact::sauvegarder : impossible d'ouvrir " + fichier);
+
+        size_t position = 0;
+        auto ecrire = [&sortie, &position](const void* donnees, size_t octets) {
+            static const char ZEROS[8] = {};
+            sortie.write(static_cast<const char*>(donnees), static_cast<std::streamsize>(octets));
+            position += octets;
+            sortie.write(ZEROS, static_cast<std::streamsize>(aligner(position) - position));
+            position = aligner(position);
+        };
+
+        const size_t n = nbSommets, m = nbArcs;
+        ecrire(&entete, sizeof(entete));
+        ecrire(etiquette.data(), etiquette.size());
+        ecrire(noms.debuts, (n + 1) * sizeof(std::uint32_t));
+        ecrire(noms.octets, entete.octetsNoms);
+        ecrire(noms.alveoles, 2 * noms.nbAlveoles * sizeof(std::uint32_t));
+        for (const Sens* sens: {&sortants, &entrants}) {
+            ecrire(sens->debuts, (n + 1) * sizeof(std::uint32_t));
+            ecrire(sens->voisins, m * sizeof(std::uint32_t));
+            ecrire(sens->durees, m * sizeof(float));
+            ecrire(sens->couts, m * sizeof(float));
+        }
+
+        if (!sortie.flush()) throw std::logic_error("GrapheCompact::sauvegarder : écriture incomplète de " + fichier);
+    }
+
+    /**
+    * \fn GrapheCompact GrapheCompact::charger(const std::string& fichier, std::string& etiquette)
+    * \brief Projette en mémoire un fichier écrit par sauvegarder().  Après l'entête et la cohérence des tailles, une seule
+    * passe linéaire sur les tableaux projetés vérifie tout ce que les requêtes supposent sans le vérifier: positions
+    * croissantes, voisins et numéros de l'index des noms inférieurs au nombre de sommets, au moins une alvéole libre
+    * (sans quoi chercherSommet bouclerait).  Rien n'est copié: les tableaux sont lus directement dans les pages du
+    * fichier.  Le fichier reste projeté tant qu'une copie de l'instantané existe.
+    * \param[in] fichier le chemin du fichier à lire
+    * \param[out] etiquette reçoit l'étiquette conservée avec l'instantané
+    * \exception logic_error si le fichier ne peut pas être lu, si ce n'est pas un instantané, si sa version n'est pas
+    * prise en charge ou s'il a été écrit sur une machine de boutisme différent
+    * \exception logic_error si un tableau de l'instantané est incohérent
+    * \return GrapheCompact l'instantané, qui partage la projection du fichier
+    */
+    GrapheCompact GrapheCompact::charger(const std::string& fichier, std::string& etiquette) {
+        auto projection = std::make_shared<const Projection>(fichier);
+        const char* base = projection->donnees();
+        if (projection->taille() < sizeof(Entete)) throw std::logic_error("GrapheCompact::charger : " + fichier + " n'est pas un instantané");
+
+        Entete entete;
+        std::memcpy(&entete, base, sizeof(entete));
+        if (std::memcmp(entete.signature, SIGNATURE, sizeof(SIGNATURE)) != 0)
+            throw std::logic_error("GrapheCompact::charger : " + fichier + " n'est pas un instantané");
+        if (entete.version != VERSION_INSTANTANE)
+            throw std::logic_error("GrapheCompact::charger : version d'instantané non prise en charge (" + std::to_string(entete.version) + ")");
+        if (entete.boutisme != TEMOIN_BOUTISME)
+            throw std::logic_error("GrapheCompact::charger : instantané écrit sur une machine de boutisme différent");
+
+        const size_t limite = std::numeric_limits<std::uint32_t>::max();
+        if (entete.nbSommets >= limite || entete.nbArcs >= limite || entete.octetsNoms > limite || entete.nbAlveoles > limite
+            || entete.octetsEtiquette > projection->taille() || (entete.nbAlveoles & (entete.nbAlveoles - 1)) != 0
+            || entete.tailleFichier != projection->taille() || disposer(entete).fin != projection->taille())
+            throw std::logic_error("GrapheCompact::charger : " + fichier + " est tronqué ou corrompu");
+
+        const auto sections = disposer(entete);
+        auto tableau = [base](size_t section) { return reinterpret_cast<const std::uint32_t*>(base + section); };
+
+        const auto corrompu = [&fichier]() { return std::logic_error("GrapheCompact::charger : " + fichier + " est tronqué ou corrompu"); };
+        auto croissantes = [](const std::uint32_t* debuts, size_t nombre) {
+            for (size_t i = 0; i < nombre; ++i)
+                if (debuts[i] > debuts[i + 1]) return false;
+            return true;
+        };
+
+        GrapheCompact graphe;
+        graphe.nbSommets = entete.nbSommets;
+        graphe.nbArcs = entete.nbArcs;
+        graphe.noms.debuts = tableau(sections.debutsNoms);
+        graphe.noms.octets = base + sections.octetsNoms;
+        graphe.noms.alveoles = tableau(sections.alveoles);
+        graphe.noms.nbAlveoles = entete.nbAlveoles;
+        Sens* sens[2] = {&graphe.sortants, &graphe.entrants};
+        for (int i = 0; i < 2; ++i) {
+            sens[i]->debuts = tableau(sections.debuts[i]);
+            sens[i]->voisins = tableau(sections.voisins[i]);
+            sens[i]->durees = reinterpret_cast<const float*>(base + sections.durees[i]);
+            sens[i]->couts = reinterpret_cast<const float*>(base + sections.couts[i]);
+            if (sens[i]->debuts[0] != 0 || sens[i]->debuts[graphe.nbSommets] != graphe.nbArcs) throw corrompu();
+            if (!croissantes(sens[i]->debuts, graphe.nbSommets)) throw corrompu();
+            for (size_t arc = 0; arc < graphe.nbArcs; ++arc)
+                if (sens[i]->voisins[arc] >= graphe.nbSommets) throw corrompu();
+        }
+        if (graphe.noms.debuts[0] != 0 || graphe.noms.debuts[graphe.nbSommets] != entete.octetsNoms) throw corrompu();
+        if (!croissantes(graphe.noms.debuts, graphe.nbSommets)) throw corrompu();
+        bool alveoleLibre = graphe.noms.nbAlveoles == 0;
+        for (size_t i = 0; i < graphe.noms.nbAlveoles; ++i) {
+            auto numero = graphe.noms.alveoles[2 * i];
+            if (numero == AUCUN) alveoleLibre = true;
+            else if (numero >= graphe.nbSommets) throw corrompu();
+        }
+        if (!alveoleLibre) throw corrompu();
+
+        etiquette.assign(base + sections.etiquette, entete.octetsEtiquette);
+        graphe.proprietaire = std::move(projection);
+        return graphe;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,234 @@
+/**
+ * \file GrapheCompact.h
+ * \brief Instantané figé (CSR) d'un graphe, pour les requêtes en lecture seule.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _GRAPHECOMPACT__H
+#define _GRAPHECOMPACT__H
+
+namespace TP2
+{
+
+struct Ponderations;
+
+/**
+ * \struct Composantes
+ * \brief Les composantes fortement connexes d'un graphe, données par le numéro de composante de chaque sommet.
+ *
+ *  Les composantes sont numérotées dans l'ordre topologique inverse du graphe condensé: si un arc relie un sommet
+ *  de la composante a à un sommet de la composante b != a, alors a > b.
+ */
+struct Composantes
+{
+	std::vector<size_t> numeros;	// numeros[s] est la composante du sommet s
+	size_t nombre = 0;				// Le nombre de composantes
+};
+
+/**
+ * \class GrapheCompact
+ * \brief Représentation immuable d'un graphe en lignes creuses compressées (CSR).
+ *
+ *  Les arcs sortants du sommet s occupent les indices [debutArcs(s), finArcs(s)) des tableaux destinations,
+ *  durees et couts, dans l'ordre des listes d'adjacence du Graphe dont l'instantané est tiré.  Un parcours des
+ *  voisins lit donc des cases contiguës plutôt que des noeuds de liste dispersés dans le tas.
+ *  Les arcs entrants sont stockés de la même façon, dans leur propre espace d'indices
+ *  [debutArcsEntrants(s), finArcsEntrants(s)), ce qui rend le graphe inverse gratuit.
+ *
+ *  Le nom de chaque sommet est conservé dans une table de chaînes, avec son propre index de hachage, de sorte que
+ *  l'instantané se suffit à lui-même pour répondre aux requêtes.
+ *
+ *  Les tableaux sont partagés: copier un GrapheCompact ou en prendre l'inverse est O(1).
+ *  S'obtient par Graphe::figer(), ou par GrapheCompact::charger() depuis un fichier écrit par sauvegarder().
+ *
+ *  Format du fichier (version 1, boutisme de la machine, chaque section alignée sur 8 octets):
+ *  une entête de 64 octets (signature, version, témoin de boutisme, nombres de sommets, d'arcs, d'alvéoles, d'octets
+ *  des noms et de l'étiquette, taille du fichier), puis l'étiquette, les positions et les octets des noms, l'index des
+ *  noms, et enfin debuts, voisins, durees et couts des arcs sortants puis des arcs entrants.  Le fichier est projeté
+ *  en mémoire (mmap) et les tableaux sont lus sur place: le chargement ne copie ni n'alloue rien par arc, il les
+ *  valide seulement en une passe.
+ */
+class GrapheCompact
+{
+public:
+
+	// Construit un graphe compact vide
+	GrapheCompact();
+
+	// Retourne le nombre de sommets
+	size_t taille() const { return nbSommets; }
+
+	// Retourne le nombre d'arcs
+	size_t getNombreArcs() const { return nbArcs; }
+
+	// Retourne la version du graphe dont l'instantané est tiré (voir Graphe::getVersion). Deux instantanés de même
+	// version ont les mêmes sommets, noms et arcs; un instantané chargé ou construit autrement reçoit une version neuve.
+	std::uint64_t getVersion() const { return version; }
+
+	// Retourne l'indice du premier arc sortant du sommet (sommet < taille())
+	size_t debutArcs(size_t sommet) const { return sortants.debuts[sommet]; }
+
+	// Retourne l'indice suivant le dernier arc sortant du sommet (sommet < taille())
+	size_t finArcs(size_t sommet) const { return sortants.debuts[sommet + 1]; }
+
+	// Retourne la destination d'un arc sortant (arc < getNombreArcs())
+	size_t destination(size_t arc) const { return sortants.voisins[arc]; }
+
+	// Retourne la durée d'un arc sortant (arc < getNombreArcs())
+	float duree(size_t arc) const { return sortants.durees[arc]; }
+
+	// Retourne le coût d'un arc sortant (arc < getNombreArcs())
+	float cout(size_t arc) const { return sortants.couts[arc]; }
+
+	// Retourne la durée si dureeCout = true, le coût sinon
+	float poids(size_t arc, bool dureeCout) const { return dureeCout ? sortants.durees[arc] : sortants.couts[arc]; }
+
+	// Retourne les pondérations d'un arc sortant
+	Ponderations getPonderations(size_t arc) const;
+
+	// Retourne l'indice du premier arc entrant du sommet (sommet < taille())
+	size_t debutArcsEntrants(size_t sommet) const { return entrants.debuts[sommet]; }
+
+	// Retourne l'indice suivant le dernier arc entrant du sommet (sommet < taille())
+	size_t finArcsEntrants(size_t sommet) const { return entrants.debuts[sommet + 1]; }
+
+	// Retourne la source d'un arc entrant (arc < getNombreArcs())
+	size_t source(size_t arc) const { return entrants.voisins[arc]; }
+
+	// Retourne la durée (dureeCout = true) ou le coût d'un arc entrant
+	float poidsEntrant(size_t arc, bool dureeCout) const { return dureeCout ? entrants.durees[arc] : entrants.couts[arc]; }
+
+	// Retourne les pondérations d'un arc entrant
+	Ponderations getPonderationsEntrant(size_t arc) const;
+
+	// Change les pondérations de l'arc source -> destination, dans les arcs sortants et entrants, et donne une version
+	// neuve à l'instantané.  Les tableaux de pondérations sont copiés (copie sur écriture) à la première modification ou
+	// s'ils sont partagés avec une autre copie de l'instantané; ensuite, ils sont modifiés sur place en
+	// O(ariteSortie(source) + ariteEntree(destination)).  Les débuts, les voisins et les noms restent partagés.
+	// Exception logic_error si source ou destination supérieur à taille()
+	// Exception logic_error si l'arc n'existe pas
+	void modifierPonderations(size_t source, size_t destination, float duree, float cout);
+
+	// Retourne le nom d'un sommet (sommet < taille()). La vue reste valide tant qu'une copie de l'instantané existe.
+	std::string_view nom(size_t sommet) const;
+
+	// Retourne le numéro du sommet portant ce nom (le plus petit s'il y en a plusieurs), ou taille() si aucun
+	size_t chercherSommet(std::string_view nom) const;
+
+	// Retourne l'arité de sortie d'un sommet
+	// Exception logic_error si sommet supérieur à taille()
+	size_t ariteSortie(size_t sommet) const;
+
+	// Retourne l'arité d'entrée d'un sommet
+	// Exception logic_error si sommet supérieur à taille()
+	size_t ariteEntree(size_t sommet) const;
+
+	// Retourne une empreinte 64 bits des arcs sortants et de leurs deux pondérations (FNV-1a, mot par mot). Deux
+	// instantanés de mêmes arcs et pondérations ont la même empreinte, quelle que soit leur version. O(V + E).
+	std::uint64_t empreinte() const;
+
+	// Retourne le graphe compact dont tous les arcs sont inversés. O(1): les arcs sortants et entrants sont échangés.
+	GrapheCompact inverse() const;
+
+	// Trouve les composantes fortement connexes avec l'algorithme de Tarjan, en une seule passe itérative. O(V + E).
+	Composantes composantesFortementConnexes() const;
+
+	// Écrit l'instantané dans un fichier binaire, accompagné d'une étiquette libre (ex.: le nom du réseau)
+	// Exception logic_error si le fichier ne peut pas être écrit
+	void sauvegarder(const std::string& fichier, std::string_view etiquette) const;
+
+	// Projette en mémoire un fichier écrit par sauvegarder() et retourne l'instantané qu'il contient, sans copie
+	// Exception logic_error si le fichier ne peut pas être lu, ou s'il n'est pas un instantané valide pour cette machine
+	static GrapheCompact charger(const std::string& fichier, std::string& etiquette);
+
+private:
+
+	friend class Graphe;
+
+	/**
+	 * \struct Sens
+	 * \brief Les tableaux CSR d'un sens de parcours. Pour les arcs sortants, voisins donne les destinations;
+	 *  pour les arcs entrants, les sources.
+	 */
+	struct Sens
+	{
+		const std::uint32_t* debuts = nullptr;	/*!< taille() + 1 positions */
+		const std::uint32_t* voisins = nullptr;
+		const float* durees = nullptr;
+		const float* couts = nullptr;
+	};
+
+	/**
+	 * \struct TableNoms
+	 * \brief Les noms des sommets mis bout à bout, et l'index nom -> numéro (sondage linéaire).  L'alvéole i occupe
+	 *  alveoles[2i] (numéro du sommet, AUCUN si libre) et alveoles[2i + 1] (32 bits de poids faible du hachage).
+	 */
+	struct TableNoms
+	{
+		const std::uint32_t* debuts = nullptr;	/*!< taille() + 1 positions dans octets */
+		const char* octets = nullptr;
+		const std::uint32_t* alveoles = nullptr;
+		size_t nbAlveoles = 0;					/*!< 0 ou une puissance de 2 */
+	};
+
+	/**
+	 * \struct Stockage
+	 * \brief Propriétaire des tableaux d'un instantané construit en mémoire
+	 */
+	struct Stockage
+	{
+		std::vector<std::uint32_t> debuts[2];	// [0]: arcs sortants, [1]: arcs entrants
+		std::vector<std::uint32_t> voisins[2];
+		std::vector<float> durees[2];
+		std::vector<float> couts[2];
+		std::vector<std::uint32_t> debutsNoms;
+		std::string octetsNoms;
+		std::vector<std::uint32_t> alveolesNoms;
+
+		void transposer(size_t nbSommets);
+		void indexerNoms(size_t nbSommets);
+	};
+
+	/**
+	 * \struct PonderationsPropres
+	 * \brief Les pondérations recopiées par modifierPonderations, propres à l'instantané tant qu'il n'est pas copié:
+	 *  [0] pour sortants, [1] pour entrants, dans l'ordre de l'instantané qui les a recopiées
+	 */
+	struct PonderationsPropres
+	{
+		std::vector<float> durees[2];
+		std::vector<float> couts[2];
+	};
+
+	static constexpr std::uint32_t AUCUN = 0xFFFFFFFFu;
+
+	explicit GrapheCompact(std::shared_ptr<const Stockage> stockage);
+
+	// Retourne un numéro de version jamais donné auparavant dans ce programme
+	static std::uint64_t nouvelleVersion();
+
+	std::shared_ptr<const void> proprietaire;	/*!< garde les tableaux en vie (Stockage ou fichier projeté) */
+	std::shared_ptr<PonderationsPropres> ponderationsPropres;	/*!< nul tant que les pondérations sont celles de proprietaire */
+	Sens sortants;
+	Sens entrants;
+	TableNoms noms;
+	size_t nbSommets;
+	size_t nbArcs;
+	std::uint64_t version;
+};
+
+}//Fin du namespace
+
+#endif
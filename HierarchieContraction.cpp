@@ -0,0 +1,578 @@
+/**
+ * \file HierarchieContraction.cpp
+ * \brief Implémentation de la hiérarchie de contraction.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "HierarchieContraction.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include "Parallele.h"
+
+namespace TP2
+{
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+        const std::uint32_t AUCUN = 0xFFFFFFFFu;
+        const size_t LIMITE_TEMOINS = 500;		// sommets résolus au plus par une recherche de témoin avant une contraction
+        const size_t LIMITE_ESTIMATION = 50;	// la même limite pour estimer l'importance d'un sommet
+
+        using Entree = std::pair<float, std::uint32_t>;
+        const std::greater<Entree> PRIORITE;
+
+        /**
+        * \struct ArcTravail
+        * \brief Un arc du graphe en cours de contraction
+        */
+        struct ArcTravail
+        {
+            std::uint32_t voisin;
+            std::uint32_t milieu;
+            float poids;
+        };
+
+        /**
+        * \struct Raccourci
+        * \brief Un raccourci source -> destination remplaçant source -> milieu -> destination
+        */
+        struct Raccourci
+        {
+            std::uint32_t source;
+            std::uint32_t destination;
+            float poids;
+        };
+
+        /**
+        * \class Contraction
+        * \brief Le graphe restant pendant la contraction, et les tableaux de la recherche de témoins
+        */
+        class Contraction
+        {
+        public:
+            std::vector<std::vector<ArcTravail> > sortants, entrants;
+            std::vector<bool> contractes;
+            std::vector<std::uint32_t> voisinsContractes;
+
+            Contraction(const GrapheCompact& graphe, bool dureeCout);
+
+            int priorite(std::uint32_t sommet);
+            void raccourcis(std::uint32_t sommet, size_t limite, std::vector<Raccourci>* sortie);
+            void ajouter(const Raccourci& raccourci, std::uint32_t milieu);
+            void retirer(std::uint32_t sommet);
+
+        private:
+            std::vector<float> distances;
+            std::vector<std::uint32_t> estampilles;
+            std::vector<std::uint32_t> cibles;		// estampillé generation: un voisin sortant du sommet contracté
+            std::uint32_t generation;
+            std::vector<Entree> tas;
+
+            void chercherTemoins(std::uint32_t depart, std::uint32_t exclu, float borne, size_t limite);
+            float distance(std::uint32_t sommet) const { return estampilles[sommet] == generation ? distances[sommet] : INFINI; }
+        };
+
+        /**
+        * \fn Contraction::Contraction(const GrapheCompact& graphe, bool dureeCout)
+        * \brief Copie les arcs du graphe (sans les boucles, qui ne servent à aucun plus court chemin)
+        */
+        Contraction::Contraction(const GrapheCompact& graphe, bool dureeCout)
+            : sortants(graphe.taille()), entrants(graphe.taille()), contractes(graphe.taille(), false),
+              voisinsContractes(graphe.taille(), 0), distances(graphe.taille()), estampilles(graphe.taille(), 0), cibles(graphe.taille(), 0), generation(0) {
+            for (std::uint32_t s = 0; s < graphe.taille(); ++s) {
+                for (auto arc = graphe.debutArcs(s); arc < graphe.finArcs(s); ++arc) {
+                    auto d = static_cast<std::uint32_t>(graphe.destination(arc));
+                    if (d == s) continue;
+                    sortants[s].push_back(ArcTravail{d, AUCUN, graphe.poids(arc, dureeCout)});
+                    entrants[d].push_back(ArcTravail{s, AUCUN, graphe.poids(arc, dureeCout)});
+                }
+            }
+        }
+
+        /**
+        * \fn void Contraction::chercherTemoins(std::uint32_t depart, std::uint32_t exclu, float borne, size_t limite)
+        * \brief Dijkstra local depuis depart dans le graphe restant privé de exclu, jusqu'à ce que tous les voisins sortants
+        * de exclu soient résolus, ou la borne ou limite sommets résolus atteintes.  Une distance non trouvée est considérée
+        * infinie: au pire, un raccourci inutile est ajouté.
+        */
+        void Contraction::chercherTemoins(std::uint32_t depart, std::uint32_t exclu, float borne, size_t limite) {
+            if (++generation == 0) {
+                std::fill(estampilles.begin(), estampilles.end(), 0);
+                std::fill(cibles.begin(), cibles.end(), 0);
+                generation = 1;
+            }
+            size_t ciblesRestantes = 0;
+            for (const auto& arc: sortants[exclu])
+                if (arc.voisin != depart) {
+                    cibles[arc.voisin] = generation;
+                    ++ciblesRestantes;
+                }
+            tas.clear();
+            estampilles[depart] = generation;
+            distances[depart] = 0;
+            tas.emplace_back(0.f, depart);
+
+            for (size_t resolus = 0; !tas.empty() && resolus < limite; ++resolus) {
+                std::pop_heap(tas.begin(), tas.end(), PRIORITE);
+                auto entree = tas.back();
+                tas.pop_back();
+                if (entree.first > distance(entree.second)) continue;
+                if (entree.first > borne) break;
+                if (cibles[entree.second] == generation && --ciblesRestantes == 0) break;
+
+                for (const auto& arc: sortants[entree.second]) {
+                    if (arc.voisin == exclu) continue;
+                    float d = entree.first + arc.poids;
+                    if (d < distance(arc.voisin)) {
+                        estampilles[arc.voisin] = generation;
+                        distances[arc.voisin] = d;
+                        tas.emplace_back(d, arc.voisin);
+                        std::push_heap(tas.begin(), tas.end(), PRIORITE);
+                    }
+                }
+            }
+        }
+
+        /**
+        * \fn void Contraction::raccourcis(std::uint32_t sommet, size_t limite, std::vector<Raccourci>* sortie)
+        * \brief Trouve les raccourcis qu'exigerait la contraction de sommet: u -> w est nécessaire si aucun chemin de u à w
+        * évitant sommet n'est au plus aussi court que u -> sommet -> w
+        * \param[out] sortie reçoit les raccourcis
+        */
+        void Contraction::raccourcis(std::uint32_t sommet, size_t limite, std::vector<Raccourci>* sortie) {
+            for (const auto& entrant: entrants[sommet]) {
+                float plusLong = -1;
+                for (const auto& sortant: sortants[sommet])
+                    if (sortant.voisin != entrant.voisin) plusLong = std::max(plusLong, entrant.poids + sortant.poids);
+                if (plusLong < 0) continue;
+
+                chercherTemoins(entrant.voisin, sommet, plusLong, limite);
+                for (const auto& sortant: sortants[sommet]) {
+                    if (sortant.voisin == entrant.voisin) continue;
+                    float parSommet = entrant.poids + sortant.poids;
+                    if (distance(sortant.voisin) > parSommet) sortie->push_back(Raccourci{entrant.voisin, sortant.voisin, parSommet});
+                }
+            }
+        }
+
+        /**
+        * \fn int Contraction::priorite(std::uint32_t sommet)
+        * \brief L'importance d'un sommet: différence d'arcs de sa contraction plus le nombre de voisins déjà contractés
+        */
+        int Contraction::priorite(std::uint32_t sommet) {
+            static thread_local std::vector<Raccourci> simules;
+            simules.clear();
+            raccourcis(sommet, LIMITE_ESTIMATION, &simules);
+            int difference = static_cast<int>(simules.size()) - static_cast<int>(sortants[sommet].size() + entrants[sommet].size());
+            return difference + static_cast<int>(voisinsContractes[sommet]);
+        }
+
+        /**
+        * \fn void Contraction::ajouter(const Raccourci& raccourci, std::uint32_t milieu)
+        * \brief Ajoute un raccourci, ou raccourcit l'arc existant entre les mêmes sommets
+        */
+        void Contraction::ajouter(const Raccourci& raccourci, std::uint32_t milieu) {
+            auto mettreAJour = [&](std::vector<ArcTravail>& arcs, std::uint32_t voisin) {
+                for (auto& arc: arcs) {
+                    if (arc.voisin != voisin) continue;
+                    if (raccourci.poids < arc.poids) {
+                        arc.poids = raccourci.poids;
+                        arc.milieu = milieu;
+                    }
+                    return;
+                }
+                arcs.push_back(ArcTravail{voisin, milieu, raccourci.poids});
+            };
+            mettreAJour(sortants[raccourci.source], raccourci.destination);
+            mettreAJour(entrants[raccourci.destination], raccourci.source);
+        }
+
+        /**
+        * \fn void Contraction::retirer(std::uint32_t sommet)
+        * \brief Retire un sommet contracté des listes de ses voisins
+        */
+        void Contraction::retirer(std::uint32_t sommet) {
+            auto effacer = [sommet](std::vector<ArcTravail>& arcs) {
+                arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [sommet](const ArcTravail& a) { return a.voisin == sommet; }), arcs.end());
+            };
+            for (const auto& arc: sortants[sommet]) {
+                effacer(entrants[arc.voisin]);
+                ++voisinsContractes[arc.voisin];
+            }
+            for (const auto& arc: entrants[sommet]) {
+                effacer(sortants[arc.voisin]);
+                ++voisinsContractes[arc.voisin];
+            }
+            contractes[sommet] = true;
+            std::vector<ArcTravail>().swap(sortants[sommet]);
+            std::vector<ArcTravail>().swap(entrants[sommet]);
+        }
+
+        /**
+        * \struct Brouillon
+        * \brief Les tableaux de travail des requêtes d'un fil d'exécution, remis à zéro par estampilles.  Indice 0: recherche
+        * depuis la source, 1: recherche depuis la cible.
+        */
+        struct Brouillon
+        {
+            std::vector<float> distances[2];
+            std::vector<std::uint32_t> parents[2];	// le sommet précédent (0) ou suivant (1) sur le chemin
+            std::vector<std::uint32_t> milieux[2];	// le milieu de l'arc menant au parent
+            std::vector<std::uint32_t> estampilles[2];
+            std::vector<Entree> tas[2];
+            std::uint32_t generation = 0;
+
+            void preparer(size_t taille) {
+                if (estampilles[0].size() < taille) {
+                    for (int sens = 0; sens < 2; ++sens) {
+                        distances[sens].resize(taille);
+                        parents[sens].resize(taille);
+                        milieux[sens].resize(taille);
+                        estampilles[sens].assign(taille, 0);
+                    }
+                    generation = 0;
+                }
+                if (++generation == 0) {
+                    for (auto& e: estampilles) std::fill(e.begin(), e.end(), 0);
+                    generation = 1;
+                }
+                tas[0].clear();
+                tas[1].clear();
+            }
+
+            float distance(int sens, std::uint32_t sommet) const {
+                return estampilles[sens][sommet] == generation ? distances[sens][sommet] : INFINI;
+            }
+        };
+
+        /**
+        * \fn Brouillon& brouillonDuFil()
+        * \brief Donne les tableaux de travail du fil d'exécution courant, partagés par toutes les hiérarchies
+        */
+        Brouillon& brouillonDuFil() {
+            static thread_local Brouillon brouillon;
+            return brouillon;
+        }
+    }
+
+    /**
+    * \fn HierarchieContraction::HierarchieContraction()
+    * \brief Constructeur par défaut: une hiérarchie vide
+    */
+    HierarchieContraction::HierarchieContraction() : dureeCout(true), nbRaccourcis(0), debutsMonte(1, 0), debutsDescend(1, 0) {
+    }
+
+    /**
+    * \fn HierarchieContraction::HierarchieContraction(const Graphe& graphe, bool dureeCout)
+    * \brief Construit la hiérarchie d'un graphe, par son instantané compact
+    * \param[in] graphe le graphe
+    * \param[in] dureeCout le critère: la durée si true, le coût sinon
+    */
+    HierarchieContraction::HierarchieContraction(const Graphe& graphe, bool dureeCout) : HierarchieContraction(graphe.figer(), dureeCout) {
+    }
+
+    /**
+    * \fn HierarchieContraction::HierarchieContraction(const GrapheCompact& graphe, bool dureeCout)
+    * \brief Contracte tous les sommets dans l'ordre de leur importance.  Au moment où un sommet est contracté, ses arcs
+    * restants mènent tous à des sommets plus importants: ce sont ses arcs montants et descendants dans la hiérarchie.
+    * \param[in] graphe le graphe
+    * \param[in] dureeCout le critère: la durée si true, le coût sinon
+    * \exception length_error si le graphe compte 2^32 - 1 sommets ou arcs et plus
+    */
+    HierarchieContraction::HierarchieContraction(const GrapheCompact& graphe, bool dureeCout)
+        : dureeCout(dureeCout), nbRaccourcis(0), rangs(graphe.taille(), 0) {
+        const size_t n = graphe.taille();
+        if (n >= AUCUN || graphe.getNombreArcs() >= AUCUN)
+            throw std::length_error("HierarchieContraction::HierarchieContraction : graphe trop grand");
+        Contraction contraction(graphe, dureeCout);
+
+        std::vector<std::pair<int, std::uint32_t> > file;
+        for (std::uint32_t v = 0; v < n; ++v) file.emplace_back(contraction.priorite(v), v);
+        std::make_heap(file.begin(), file.end(), std::greater<std::pair<int, std::uint32_t> >());
+
+        std::vector<std::vector<ArcHierarchie> > montants(n), descendants(n);
+        std::vector<Raccourci> nouveaux;
+        std::uint32_t prochainRang = 0;
+        while (!file.empty()) {
+            std::pop_heap(file.begin(), file.end(), std::greater<std::pair<int, std::uint32_t> >());
+            auto sommet = file.back().second;
+            file.pop_back();
+
+            //Mise à jour paresseuse: si l'importance a augmenté au-delà du suivant, le sommet attend son tour
+            int importance = contraction.priorite(sommet);
+            if (!file.empty() && importance > file.front().first) {
+                file.emplace_back(importance, sommet);
+                std::push_heap(file.begin(), file.end(), std::greater<std::pair<int, std::uint32_t> >());
+                continue;
+            }
+
+            rangs[sommet] = prochainRang++;
+            for (const auto& arc: contraction.sortants[sommet]) montants[sommet].push_back(ArcHierarchie{arc.voisin, arc.milieu, arc.poids});
+            for (const auto& arc: contraction.entrants[sommet]) descendants[sommet].push_back(ArcHierarchie{arc.voisin, arc.milieu, arc.poids});
+
+            nouveaux.clear();
+            contraction.raccourcis(sommet, LIMITE_TEMOINS, &nouveaux);
+            contraction.retirer(sommet);
+            for (const auto& raccourci: nouveaux) contraction.ajouter(raccourci, sommet);
+            nbRaccourcis += nouveaux.size();
+        }
+
+        auto compacter = [n](std::vector<std::vector<ArcHierarchie> >& listes, std::vector<std::uint32_t>& debuts, std::vector<ArcHierarchie>& arcs) {
+            debuts.assign(n + 1, 0);
+            for (size_t v = 0; v < n; ++v) debuts[v + 1] = debuts[v] + static_cast<std::uint32_t>(listes[v].size());
+            arcs.reserve(debuts[n]);
+            for (auto& liste: listes) {
+                arcs.insert(arcs.end(), liste.begin(), liste.end());
+                std::vector<ArcHierarchie>().swap(liste);
+            }
+        };
+        compacter(montants, debutsMonte, monte);
+        compacter(descendants, debutsDescend, descend);
+    }
+
+    /**
+    * \fn std::vector<size_t> HierarchieContraction::chercherChemin(size_t source, size_t cible, float& longueur) const
+    * \brief Cherche un plus court chemin, sans instrumentation
+    */
+    std::vector<size_t> HierarchieContraction::chercherChemin(size_t source, size_t cible, float& longueur) const {
+        StatistiquesRequete statistiques;
+        return chercherChemin(source, cible, longueur, statistiques);
+    }
+
+    /**
+    * \fn std::vector<size_t> HierarchieContraction::chercherChemin(size_t source, size_t cible, float& longueur, StatistiquesRequete& statistiques) const
+    * \brief Requête bidirectionnelle montante.  Les deux recherches avancent à tour de rôle; une direction s'arrête dès
+    * que son minimum atteint la meilleure longueur trouvée.  Le chemin est ensuite reconstitué jusqu'au sommet de
+    * rencontre de chaque côté, puis chaque raccourci est déplié.
+    * \param[in] source le sommet de départ
+    * \param[in] cible le sommet d'arrivée
+    * \param[out] longueur la longueur du chemin, infinie s'il n'y en a pas
+    * \param[out] statistiques les compteurs de la recherche (TP2_INSTRUMENTATION)
+    * \return std::vector<size_t> les sommets du chemin, vide si aucun chemin ou si source == cible
+    */
+    std::vector<size_t> HierarchieContraction::chercherChemin(size_t source, size_t cible, float& longueur, [[maybe_unused]] StatistiquesRequete& statistiques) const {
+        longueur = INFINI;
+        std::vector<size_t> trajet;
+        if (source >= taille() || cible >= taille()) throw std::logic_error("HierarchieContraction::chercherChemin : sommet invalide");
+        if (source == cible) return trajet;
+
+        auto& brouillon = brouillonDuFil();
+        brouillon.preparer(taille());
+        auto atteindre = [&](int sens, std::uint32_t sommet, float distance, std::uint32_t parent, std::uint32_t milieu) {
+            brouillon.estampilles[sens][sommet] = brouillon.generation;
+            brouillon.distances[sens][sommet] = distance;
+            brouillon.parents[sens][sommet] = parent;
+            brouillon.milieux[sens][sommet] = milieu;
+            brouillon.tas[sens].emplace_back(distance, sommet);
+            std::push_heap(brouillon.tas[sens].begin(), brouillon.tas[sens].end(), PRIORITE);
+            TP2_INSTRUMENTER(++statistiques.insertionsTas;)
+        };
+        atteindre(0, static_cast<std::uint32_t>(source), 0, AUCUN, AUCUN);
+        atteindre(1, static_cast<std::uint32_t>(cible), 0, AUCUN, AUCUN);
+
+        std::uint32_t rencontre = AUCUN;
+        for (int sens = 0; ; sens = 1 - sens) {
+            bool actif[2];
+            for (int s = 0; s < 2; ++s) actif[s] = !brouillon.tas[s].empty() && brouillon.tas[s].front().first < longueur;
+            if (!actif[0] && !actif[1]) break;
+            if (!actif[sens]) sens = 1 - sens;
+
+            auto& tas = brouillon.tas[sens];
+            std::pop_heap(tas.begin(), tas.end(), PRIORITE);
+            auto entree = tas.back();
+            tas.pop_back();
+            TP2_INSTRUMENTER(++statistiques.retraitsTas;)
+            auto courant = entree.second;
+            if (entree.first > brouillon.distance(sens, courant)) continue;
+            TP2_INSTRUMENTER(++statistiques.sommetsResolus;)
+
+            float total = entree.first + brouillon.distance(1 - sens, courant);
+            if (total < longueur) {
+                longueur = total;
+                rencontre = courant;
+            }
+
+            //Vers l'avant, on monte par les arcs sortants et on vérifie les arcs entrants (descendants), et inversement
+            const auto& debutsSuivre = sens == 0 ? debutsMonte : debutsDescend;
+            const auto& suivre = sens == 0 ? monte : descend;
+            const auto& debutsVerifier = sens == 0 ? debutsDescend : debutsMonte;
+            const auto& verifier = sens == 0 ? descend : monte;
+
+            bool bloque = false;
+            for (auto i = debutsVerifier[courant]; i < debutsVerifier[courant + 1] && !bloque; ++i)
+                bloque = brouillon.distance(sens, verifier[i].voisin) + verifier[i].poids < entree.first;
+            if (bloque) continue;
+
+            for (auto i = debutsSuivre[courant]; i < debutsSuivre[courant + 1]; ++i) {
+                const auto& arc = suivre[i];
+                float distance = entree.first + arc.poids;
+                TP2_INSTRUMENTER(++statistiques.arcsExamines;)
+                if (distance < brouillon.distance(sens, arc.voisin)) {
+                    TP2_INSTRUMENTER(++statistiques.relaxationsReussies;)
+                    atteindre(sens, arc.voisin, distance, courant, arc.milieu);
+                }
+            }
+        }
+        if (rencontre == AUCUN) return trajet;
+
+        //Arcs de la hiérarchie de source à rencontre, puis de rencontre à cible
+        std::vector<std::uint32_t> sommetsAvant;
+        for (auto v = rencontre; v != AUCUN; v = brouillon.parents[0][v]) sommetsAvant.push_back(v);
+        std::reverse(sommetsAvant.begin(), sommetsAvant.end());
+
+        trajet.push_back(source);
+        for (size_t i = 1; i < sommetsAvant.size(); ++i)
+            deplier(sommetsAvant[i - 1], sommetsAvant[i], brouillon.milieux[0][sommetsAvant[i]], trajet);
+        for (auto v = rencontre; brouillon.parents[1][v] != AUCUN; v = brouillon.parents[1][v])
+            deplier(v, brouillon.parents[1][v], brouillon.milieux[1][v], trajet);
+
+        return trajet;
+    }
+
+    /**
+    * \fn std::vector<float> HierarchieContraction::distances(const std::vector<size_t>& sources, const std::vector<size_t>& cibles, unsigned nbFils) const
+    * \brief Calcule toutes les distances de sources à cibles par seaux (many-to-many).  Une recherche montante complète
+    * depuis chaque cible, sur les arcs entrants, dépose (cible, distance) dans le seau de chaque sommet résolu.  Une
+    * recherche montante depuis chaque source lit ensuite les seaux des sommets qu'elle résout: d(s, t) est le minimum
+    * de d(s, v) + d(v, t) sur ces sommets.  Les recherches sont réparties entre les fils d'exécution.
+    * \param[in] sources les sommets de départ
+    * \param[in] cibles les sommets d'arrivée
+    * \param[in] nbFils le nombre de fils d'exécution, 0 pour autant que de coeurs
+    * \exception logic_error si un sommet est invalide
+    * \return std::vector<float> sources.size() lignes de cibles.size() distances, infinies pour les cibles non atteintes
+    */
+    std::vector<float> HierarchieContraction::distances(const std::vector<size_t>& sources, const std::vector<size_t>& cibles, unsigned nbFils) const {
+        for (auto sommet: sources)
+            if (sommet >= taille()) throw std::logic_error("HierarchieContraction::distances : sommet invalide");
+        for (auto sommet: cibles)
+            if (sommet >= taille()) throw std::logic_error("HierarchieContraction::distances : sommet invalide");
+
+        const size_t nbCibles = cibles.size();
+        std::vector<float> resultat(sources.size() * nbCibles, INFINI);
+        if (resultat.empty()) return resultat;
+
+        //Espaces de recherche des cibles, puis seaux indexés par sommet (tri par dénombrement)
+        std::vector<std::vector<Entree> > espaces(nbCibles);
+        repartir(nbCibles, nbFils, [&](size_t j, unsigned) { espaceMontant(static_cast<std::uint32_t>(cibles[j]), 1, espaces[j]); });
+
+        std::vector<std::uint32_t> debutsSeaux(taille() + 1, 0);
+        for (const auto& espace: espaces)
+            for (const auto& entree: espace) ++debutsSeaux[entree.second + 1];
+        for (size_t v = 0; v < taille(); ++v) debutsSeaux[v + 1] += debutsSeaux[v];
+        std::vector<std::pair<float, std::uint32_t> > seaux(debutsSeaux[taille()]);
+        {
+            std::vector<std::uint32_t> positions(debutsSeaux.begin(), debutsSeaux.end() - 1);
+            for (size_t j = 0; j < nbCibles; ++j) {
+                for (const auto& entree: espaces[j]) seaux[positions[entree.second]++] = std::make_pair(entree.first, static_cast<std::uint32_t>(j));
+                std::vector<Entree>().swap(espaces[j]);
+            }
+        }
+
+        repartir(sources.size(), nbFils, [&](size_t i, unsigned) {
+            std::vector<Entree> espace;
+            espaceMontant(static_cast<std::uint32_t>(sources[i]), 0, espace);
+            float* ligne = resultat.data() + i * nbCibles;
+            for (const auto& entree: espace)
+                for (auto k = debutsSeaux[entree.second]; k < debutsSeaux[entree.second + 1]; ++k)
+                    ligne[seaux[k].second] = std::min(ligne[seaux[k].second], entree.first + seaux[k].first);
+        });
+        return resultat;
+    }
+
+    /**
+    * \fn void HierarchieContraction::espaceMontant(std::uint32_t depart, int sens, std::vector<std::pair<float, std::uint32_t> >& espace) const
+    * \brief Recherche montante complète depuis depart, sur les arcs sortants (sens 0) ou entrants (sens 1).  Les sommets
+    * bloqués (stall-on-demand) n'ont pas leur vraie distance et sont laissés de côté: aucun plus court chemin n'a son
+    * sommet le plus important parmi eux.
+    * \param[in] depart le sommet de départ
+    * \param[in] sens 0 vers l'avant, 1 vers l'arrière
+    * \param[out] espace reçoit (distance, sommet) pour chaque sommet résolu et non bloqué
+    */
+    void HierarchieContraction::espaceMontant(std::uint32_t depart, int sens, std::vector<std::pair<float, std::uint32_t> >& espace) const {
+        auto& brouillon = brouillonDuFil();
+        brouillon.preparer(taille());
+        auto& tas = brouillon.tas[sens];
+        const auto& debutsSuivre = sens == 0 ? debutsMonte : debutsDescend;
+        const auto& suivre = sens == 0 ? monte : descend;
+        const auto& debutsVerifier = sens == 0 ? debutsDescend : debutsMonte;
+        const auto& verifier = sens == 0 ? descend : monte;
+
+        espace.clear();
+        brouillon.estampilles[sens][depart] = brouillon.generation;
+        brouillon.distances[sens][depart] = 0;
+        tas.emplace_back(0.f, depart);
+        while (!tas.empty()) {
+            std::pop_heap(tas.begin(), tas.end(), PRIORITE);
+            auto entree = tas.back();
+            tas.pop_back();
+            auto courant = entree.second;
+            if (entree.first > brouillon.distance(sens, courant)) continue;
+
+            bool bloque = false;
+            for (auto i = debutsVerifier[courant]; i < debutsVerifier[courant + 1] && !bloque; ++i)
+                bloque = brouillon.distance(sens, verifier[i].voisin) + verifier[i].poids < entree.first;
+            if (bloque) continue;
+            espace.push_back(entree);
+
+            for (auto i = debutsSuivre[courant]; i < debutsSuivre[courant + 1]; ++i) {
+                const auto& arc = suivre[i];
+                float distance = entree.first + arc.poids;
+                if (distance < brouillon.distance(sens, arc.voisin)) {
+                    brouillon.estampilles[sens][arc.voisin] = brouillon.generation;
+                    brouillon.distances[sens][arc.voisin] = distance;
+                    tas.emplace_back(distance, arc.voisin);
+                    std::push_heap(tas.begin(), tas.end(), PRIORITE);
+                }
+            }
+        }
+    }
+
+    /**
+    * \fn std::uint32_t HierarchieContraction::milieuArc(std::uint32_t source, std::uint32_t destination, std::uint32_t sommetContracte) const
+    * \brief Donne le milieu de l'arc source -> destination, dont l'une des extrémités est sommetContracte, le moins
+    * important des deux: l'arc est parmi ses arcs montants (source == sommetContracte) ou descendants.
+    */
+    std::uint32_t HierarchieContraction::milieuArc(std::uint32_t source, std::uint32_t destination, std::uint32_t sommetContracte) const {
+        if (source == sommetContracte) {
+            for (auto i = debutsMonte[source]; i < debutsMonte[source + 1]; ++i)
+                if (monte[i].voisin == destination) return monte[i].milieu;
+        }
+        else {
+            for (auto i = debutsDescend[destination]; i < debutsDescend[destination + 1]; ++i)
+                if (descend[i].voisin == source) return descend[i].milieu;
+        }
+        throw std::logic_error("HierarchieContraction::milieuArc : arc absent de la hiérarchie");
+    }
+
+    /**
+    * \fn void HierarchieContraction::deplier(std::uint32_t source, std::uint32_t destination, std::uint32_t milieu, std::vector<size_t>& trajet) const
+    * \brief Déplie l'arc source -> destination et ajoute au trajet les sommets qui suivent source, jusqu'à destination.
+    * Un raccourci source -> destination par milieu se déplie en source -> milieu -> destination; milieu étant moins
+    * important que les deux, ces deux arcs sont ses arcs descendant et montant.  Une pile évite la récursion.
+    */
+    void HierarchieContraction::deplier(std::uint32_t source, std::uint32_t destination, std::uint32_t milieu, std::vector<size_t>& trajet) const {
+        struct Segment { std::uint32_t source, destination, milieu; };
+        std::vector<Segment> pile;
+        pile.push_back(Segment{source, destination, milieu});
+
+        while (!pile.empty()) {
+            auto segment = pile.back();
+            pile.pop_back();
+            if (segment.milieu == AUCUN) {
+                trajet.push_back(segment.destination);
+                continue;
+            }
+            auto m = segment.milieu;
+            pile.push_back(Segment{m, segment.destination, milieuArc(m, segment.destination, m)});
+            pile.push_back(Segment{segment.source, m, milieuArc(segment.source, m, m)});
+        }
+    }
+
+}//Fin du namespace
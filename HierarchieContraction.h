@@ -0,0 +1,105 @@
+/**
+ * \file HierarchieContraction.h
+ * \brief Hiérarchie de contraction (Contraction Hierarchies) pour les recherches de plus court chemin point à point.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Graphe.h"
+#include "GrapheCompact.h"
+#include "Instrumentation.h"
+
+#ifndef _HIERARCHIECONTRACTION__H
+#define _HIERARCHIECONTRACTION__H
+
+namespace TP2
+{
+
+/**
+ * \class HierarchieContraction
+ * \brief Hiérarchie de contraction d'un graphe, pour un critère (durée ou coût).
+ *
+ *  Prétraitement: les sommets sont contractés un à un, du moins important au plus important.  Contracter v retire v du
+ *  graphe; pour chaque paire u -> v -> w dont le chemin par v est le seul plus court (aucun témoin trouvé par une
+ *  recherche locale bornée), un raccourci u -> w est ajouté, qui retient v pour pouvoir être déplié.  L'importance d'un
+ *  sommet est sa différence d'arcs (raccourcis ajoutés moins arcs retirés) plus le nombre de ses voisins déjà
+ *  contractés; elle est réévaluée paresseusement au moment de le contracter.
+ *
+ *  Requête: deux recherches de Dijkstra qui ne montent que vers des sommets plus importants, l'une depuis la source sur
+ *  les arcs sortants, l'autre depuis la cible sur les arcs entrants.  Le plus court chemin passe par le sommet le plus
+ *  important du chemin, où les deux recherches se rencontrent.  Un sommet atteint plus court par un arc descendant est
+ *  ignoré (stall-on-demand).  Les tableaux de travail d'une requête sont propres à chaque fil d'exécution et remis à
+ *  zéro par estampilles: une requête ne coûte rien en O(V).
+ */
+class HierarchieContraction
+{
+public:
+
+	// Construit une hiérarchie vide (taille() == 0)
+	HierarchieContraction();
+
+	// Construit la hiérarchie du graphe pour la durée (dureeCout = true) ou le coût
+	// Exception length_error si le graphe compte 2^32 - 1 sommets ou arcs et plus
+	HierarchieContraction(const GrapheCompact& graphe, bool dureeCout);
+	HierarchieContraction(const Graphe& graphe, bool dureeCout);
+
+	// Retourne le nombre de sommets (0 pour une hiérarchie vide)
+	size_t taille() const { return rangs.size(); }
+
+	// Retourne le critère de la hiérarchie
+	bool getDureeCout() const { return dureeCout; }
+
+	// Retourne le nombre de raccourcis ajoutés
+	size_t getNombreRaccourcis() const { return nbRaccourcis; }
+
+	// Retourne le rang de contraction d'un sommet (0: contracté en premier)
+	size_t rang(size_t sommet) const { return rangs[sommet]; }
+
+	// Retourne les sommets d'un plus court chemin de source à cible, source et cible comprises, une fois les raccourcis
+	// dépliés; vide si cible n'est pas atteignable ou si source == cible. La longueur du chemin est mise dans longueur.
+	std::vector<size_t> chercherChemin(size_t source, size_t cible, float& longueur) const;
+	std::vector<size_t> chercherChemin(size_t source, size_t cible, float& longueur, StatistiquesRequete& statistiques) const;
+
+	// Retourne les distances de chaque source à chaque cible, ligne par source (sources.size() x cibles.size()), infinies
+	// pour les cibles non atteintes; les recherches sont réparties sur nbFils fils d'exécution (0: autant que de coeurs)
+	// Exception logic_error si un sommet est invalide
+	std::vector<float> distances(const std::vector<size_t>& sources, const std::vector<size_t>& cibles, unsigned nbFils = 0) const;
+
+private:
+
+	/**
+	 * \struct ArcHierarchie
+	 * \brief Un arc vers un sommet plus important.  milieu est le sommet contracté remplacé par un raccourci, AUCUN
+	 *  pour un arc du graphe d'origine.
+	 */
+	struct ArcHierarchie
+	{
+		std::uint32_t voisin;
+		std::uint32_t milieu;
+		float poids;
+	};
+
+	static constexpr std::uint32_t AUCUN = 0xFFFFFFFFu;
+
+	bool dureeCout;
+	size_t nbRaccourcis;
+	std::vector<std::uint32_t> rangs;
+	// monte: arcs v -> voisin, voisin plus important que v; descend: arcs voisin -> v, voisin plus important que v
+	std::vector<std::uint32_t> debutsMonte, debutsDescend;
+	std::vector<ArcHierarchie> monte, descend;
+
+	std::uint32_t milieuArc(std::uint32_t source, std::uint32_t destination, std::uint32_t sommetContracte) const;
+	void espaceMontant(std::uint32_t depart, int sens, std::vector<std::pair<float, std::uint32_t> >& espace) const;
+	void deplier(std::uint32_t source, std::uint32_t destination, std::uint32_t milieu, std::vector<size_t>& trajet) const;
+};
+
+}//Fin du namespace
+
+#endif
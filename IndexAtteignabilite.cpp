@@ -0,0 +1,211 @@
+/**
+ * \file IndexAtteignabilite.cpp
+ * \brief Implémentation de l'index d'atteignabilité par étiquettes d'intervalles.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "IndexAtteignabilite.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace TP2
+{
+    namespace
+    {
+        const std::uint32_t NON_VISITE = 0xFFFFFFFFu;
+
+        /**
+        * \struct Brouillon
+        * \brief Les tableaux de travail des parcours d'un fil d'exécution, remis à zéro par estampilles
+        */
+        struct Brouillon
+        {
+            std::vector<std::uint32_t> marques;		// estampille: composante déjà empilée
+            std::vector<std::uint32_t> pile;
+            std::uint32_t generation = 0;
+
+            void preparer(size_t taille) {
+                if (marques.size() < taille) {
+                    marques.assign(taille, 0);
+                    generation = 0;
+                }
+                if (++generation == 0) {
+                    std::fill(marques.begin(), marques.end(), 0);
+                    generation = 1;
+                }
+                pile.clear();
+            }
+        };
+
+        /**
+        * \fn Brouillon& brouillonDuFil()
+        * \brief Donne les tableaux de travail du fil d'exécution courant
+        */
+        Brouillon& brouillonDuFil() {
+            static thread_local Brouillon brouillon;
+            return brouillon;
+        }
+    }
+
+    /**
+    * \fn IndexAtteignabilite::IndexAtteignabilite()
+    * \brief Construit un index vide
+    */
+    IndexAtteignabilite::IndexAtteignabilite() : nbEtiquettes(0) {
+    }
+
+    /**
+    * \fn IndexAtteignabilite::IndexAtteignabilite(const GrapheCompact& graphe, size_t nbEtiquettes)
+    * \brief Construit l'index: composantes par Tarjan, graphe condensé en lignes creuses (les membres de chaque composante
+    * sont regroupés par un tri par dénombrement, et les arcs en double sont écartés par estampille), puis un parcours
+    * d'étiquetage par étiquette
+    * \param[in] graphe l'instantané du réseau
+    * \param[in] nbEtiquettes le nombre de parcours d'étiquetage
+    * \exception logic_error si nbEtiquettes vaut 0
+    */
+    IndexAtteignabilite::IndexAtteignabilite(const GrapheCompact& graphe, size_t nbEtiquettes) : nbEtiquettes(nbEtiquettes) {
+        if (nbEtiquettes == 0) throw std::logic_error("IndexAtteignabilite::IndexAtteignabilite : il faut au moins une étiquette");
+
+        auto cfc = graphe.composantesFortementConnexes();
+        const auto nbComposantes = cfc.nombre;
+        composantes.resize(graphe.taille());
+        std::vector<std::uint32_t> premiers(nbComposantes + 1, 0);
+        for (size_t sommet = 0; sommet < graphe.taille(); ++sommet) {
+            composantes[sommet] = static_cast<std::uint32_t>(cfc.numeros[sommet]);
+            ++premiers[composantes[sommet] + 1];
+        }
+        std::partial_sum(premiers.begin(), premiers.end(), premiers.begin());
+        std::vector<std::uint32_t> membres(graphe.taille());
+        {
+            auto places = premiers;
+            for (size_t sommet = 0; sommet < graphe.taille(); ++sommet) membres[places[composantes[sommet]]++] = static_cast<std::uint32_t>(sommet);
+        }
+
+        debuts.assign(nbComposantes + 1, 0);
+        std::vector<std::uint32_t> derniere(nbComposantes, NON_VISITE);	// dernière composante reliée à celle-ci
+        for (std::uint32_t c = 0; c < nbComposantes; ++c) {
+            debuts[c] = static_cast<std::uint32_t>(successeurs.size());
+            for (auto i = premiers[c]; i < premiers[c + 1]; ++i) {
+                for (auto arc = graphe.debutArcs(membres[i]); arc < graphe.finArcs(membres[i]); ++arc) {
+                    auto d = composantes[graphe.destination(arc)];
+                    if (d == c || derniere[d] == c) continue;
+                    derniere[d] = c;
+                    successeurs.push_back(d);
+                }
+            }
+        }
+        debuts[nbComposantes] = static_cast<std::uint32_t>(successeurs.size());
+        successeurs.shrink_to_fit();
+
+        bas.assign(nbComposantes * nbEtiquettes, 0);
+        hauts.assign(nbComposantes * nbEtiquettes, 0);
+        for (size_t parcours = 0; parcours < nbEtiquettes; ++parcours) etiqueter(parcours, 0x9E3779B97F4A7C15ull * (parcours + 1));
+    }
+
+    /**
+    * \fn void IndexAtteignabilite::etiqueter(size_t parcours, std::uint64_t graine)
+    * \brief Un parcours en profondeur itératif du graphe condensé, qui donne à chaque composante son rang postfixe et le
+    * plus petit rang postfixe de ses descendants.  Le premier parcours suit l'ordre des numéros; les suivants tirent
+    * l'ordre des racines et le premier successeur visité de chaque composante, pour que leurs intervalles diffèrent.
+    * \param[in] parcours le numéro de l'étiquette calculée
+    * \param[in] graine la graine du tirage
+    */
+    void IndexAtteignabilite::etiqueter(size_t parcours, std::uint64_t graine) {
+        const auto nbComposantes = static_cast<std::uint32_t>(nombreComposantes());
+        std::mt19937_64 alea(graine);
+        std::vector<std::uint32_t> racines(nbComposantes);
+        std::iota(racines.begin(), racines.end(), 0u);
+        if (parcours > 0) std::shuffle(racines.begin(), racines.end(), alea);
+
+        std::vector<std::uint32_t> decalages(nbComposantes, NON_VISITE);	// NON_VISITE: composante pas encore visitée
+        std::vector<std::pair<std::uint32_t, std::uint32_t> > pile;		// composante, successeurs déjà vus
+        std::uint32_t rang = 0;
+        auto visiter = [&](std::uint32_t c) {
+            auto degre = debuts[c + 1] - debuts[c];
+            decalages[c] = parcours == 0 || degre == 0 ? 0 : static_cast<std::uint32_t>(alea() % degre);
+            bas[c * nbEtiquettes + parcours] = NON_VISITE;
+            pile.emplace_back(c, 0u);
+        };
+
+        for (auto racine: racines) {
+            if (decalages[racine] != NON_VISITE) continue;
+            visiter(racine);
+            while (!pile.empty()) {
+                auto c = pile.back().first;
+                auto degre = debuts[c + 1] - debuts[c];
+                auto& plusBas = bas[c * nbEtiquettes + parcours];
+                if (pile.back().second < degre) {
+                    auto suivant = successeurs[debuts[c] + (pile.back().second++ + decalages[c]) % degre];
+                    if (decalages[suivant] == NON_VISITE) visiter(suivant);
+                    else plusBas = std::min(plusBas, bas[suivant * nbEtiquettes + parcours]);	// acyclique: déjà terminée
+                    continue;
+                }
+                hauts[c * nbEtiquettes + parcours] = rang;
+                plusBas = std::min(plusBas, rang++);
+                pile.pop_back();
+                if (!pile.empty()) {
+                    auto& parent = bas[pile.back().first * nbEtiquettes + parcours];
+                    parent = std::min(parent, plusBas);
+                }
+            }
+        }
+    }
+
+    /**
+    * \fn bool IndexAtteignabilite::contient(std::uint32_t c, std::uint32_t d) const
+    * \brief Vrai si chaque intervalle de d est inclus dans celui de c: condition nécessaire pour que c mène à d
+    */
+    bool IndexAtteignabilite::contient(std::uint32_t c, std::uint32_t d) const {
+        const auto* basC = &bas[c * nbEtiquettes];
+        const auto* basD = &bas[d * nbEtiquettes];
+        const auto* hautsC = &hauts[c * nbEtiquettes];
+        const auto* hautsD = &hauts[d * nbEtiquettes];
+        for (size_t i = 0; i < nbEtiquettes; ++i)
+            if (basD[i] < basC[i] || hautsD[i] > hautsC[i]) return false;
+        return true;
+    }
+
+    /**
+    * \fn bool IndexAtteignabilite::atteint(size_t source, size_t cible) const
+    * \brief Décide si cible est atteignable depuis source: même composante, filtres (numéros et intervalles), puis au
+    * besoin un parcours en profondeur du graphe condensé qui n'empile que les composantes que les filtres n'excluent pas
+    * \param[in] source le sommet de départ
+    * \param[in] cible le sommet d'arrivée
+    * \exception logic_error si source ou cible n'est pas un sommet du graphe indexé
+    * \return bool true si un chemin mène de source à cible
+    */
+    bool IndexAtteignabilite::atteint(size_t source, size_t cible) const {
+        if (source >= taille()) throw std::logic_error("IndexAtteignabilite::atteint : la source est invalide");
+        if (cible >= taille()) throw std::logic_error("IndexAtteignabilite::atteint : la cible est invalide");
+
+        const auto depart = composantes[source], arrivee = composantes[cible];
+        if (depart == arrivee) return true;
+        if (depart < arrivee || !contient(depart, arrivee)) return false;
+
+        auto& brouillon = brouillonDuFil();
+        brouillon.preparer(nombreComposantes());
+        brouillon.marques[depart] = brouillon.generation;
+        brouillon.pile.push_back(depart);
+        while (!brouillon.pile.empty()) {
+            auto c = brouillon.pile.back();
+            brouillon.pile.pop_back();
+            for (auto i = debuts[c]; i < debuts[c + 1]; ++i) {
+                auto suivant = successeurs[i];
+                if (suivant == arrivee) return true;
+                if (suivant < arrivee || brouillon.marques[suivant] == brouillon.generation || !contient(suivant, arrivee)) continue;
+                brouillon.marques[suivant] = brouillon.generation;
+                brouillon.pile.push_back(suivant);
+            }
+        }
+        return false;
+    }
+
+}//Fin du namespace
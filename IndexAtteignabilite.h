@@ -0,0 +1,81 @@
+/**
+ * \file IndexAtteignabilite.h
+ * \brief Index d'atteignabilité sur le graphe condensé des composantes fortement connexes.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <cstdint>
+#include <vector>
+#include "GrapheCompact.h"
+
+#ifndef _INDEXATTEIGNABILITE__H
+#define _INDEXATTEIGNABILITE__H
+
+namespace TP2
+{
+
+/**
+ * \class IndexAtteignabilite
+ * \brief Répond à « la ville a mène-t-elle à la ville b ? » sans parcourir le réseau.
+ *
+ *  Le graphe est réduit à ses composantes fortement connexes (Tarjan), puis le graphe condensé, acyclique, reçoit des
+ *  étiquettes d'intervalles (GRAIL): chaque parcours en profondeur donne à une composante c l'intervalle
+ *  [plus petit rang postfixe de ses descendants, son rang postfixe].  Si c mène à d, l'intervalle de d est inclus dans
+ *  celui de c, pour chaque parcours; une seule non-inclusion prouve donc que d n'est pas atteignable.  Le numéro de
+ *  composante (ordre topologique inverse) sert de filtre supplémentaire: c ne peut mener qu'à des composantes de
+ *  numéro inférieur.
+ *
+ *  Une requête est résolue en O(1) si les deux sommets sont dans la même composante, en O(nbEtiquettes) si un filtre
+ *  l'exclut, et sinon par un parcours du graphe condensé élagué par ces mêmes filtres.  Les tableaux de travail du
+ *  parcours sont propres à chaque fil d'exécution: les requêtes peuvent être faites en parallèle.
+ *  L'index occupe 4 octets par sommet, 4 par arc condensé et 8 x nbEtiquettes par composante.
+ */
+class IndexAtteignabilite
+{
+public:
+
+	// Construit un index vide (taille() == 0)
+	IndexAtteignabilite();
+
+	// Calcule les composantes du graphe, son graphe condensé (arcs sans doublon) et nbEtiquettes parcours d'étiquetage.
+	// O(nbEtiquettes x (V + E)).
+	// Exception logic_error si nbEtiquettes vaut 0
+	explicit IndexAtteignabilite(const GrapheCompact& graphe, size_t nbEtiquettes = 4);
+
+	// Retourne le nombre de sommets du graphe indexé
+	size_t taille() const { return composantes.size(); }
+
+	// Retourne le nombre de composantes fortement connexes du graphe indexé
+	size_t nombreComposantes() const { return debuts.empty() ? 0 : debuts.size() - 1; }
+
+	// Retourne le nombre d'arcs du graphe condensé
+	size_t getNombreArcs() const { return successeurs.size(); }
+
+	// Retourne la composante d'un sommet (sommet < taille()), numérotée comme GrapheCompact::composantesFortementConnexes
+	size_t composante(size_t sommet) const { return composantes[sommet]; }
+
+	// Retourne true si cible est atteignable depuis source (toujours vrai si source == cible)
+	// Exception logic_error si source ou cible n'est pas un sommet du graphe indexé
+	bool atteint(size_t source, size_t cible) const;
+
+private:
+
+	std::vector<std::uint32_t> composantes;	// par sommet
+	std::vector<std::uint32_t> debuts;		// arcs condensés de c: successeurs[debuts[c], debuts[c + 1])
+	std::vector<std::uint32_t> successeurs;
+	size_t nbEtiquettes;
+	// Intervalle du parcours i pour la composante c: [bas[c * nbEtiquettes + i], hauts[c * nbEtiquettes + i]]
+	std::vector<std::uint32_t> bas, hauts;
+
+	bool contient(std::uint32_t c, std::uint32_t d) const;
+	void etiqueter(size_t parcours, std::uint64_t graine);
+};
+
+}//Fin du namespace
+
+#endif
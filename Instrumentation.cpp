@@ -0,0 +1,167 @@
+/**
+ * \file Instrumentation.cpp
+ * \brief Implémentation des compteurs et histogrammes de latence.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "Instrumentation.h"
+#include <algorithm>
+#include <cmath>
+
+namespace TP2
+{
+    /**
+    * \fn StatistiquesRequete& StatistiquesRequete::operator+=(const StatistiquesRequete& autre)
+    * \brief Additionne les compteurs et les durées d'une autre recherche
+    * \param[in] autre les statistiques à ajouter
+    * \return StatistiquesRequete& les statistiques cumulées
+    */
+    StatistiquesRequete& StatistiquesRequete::operator+=(const StatistiquesRequete& autre) {
+        sommetsResolus += autre.sommetsResolus;
+        arcsExamines += autre.arcsExamines;
+        relaxationsReussies += autre.relaxationsReussies;
+        insertionsTas += autre.insertionsTas;
+        retraitsTas += autre.retraitsTas;
+        allocations += autre.allocations;
+        secondes += autre.secondes;
+        return *this;
+    }
+
+    /**
+    * \fn StatistiquesComposantes& StatistiquesComposantes::operator+=(const StatistiquesComposantes& autre)
+    * \brief Additionne les durées des phases d'une autre recherche de composantes
+    * \param[in] autre les statistiques à ajouter
+    * \return StatistiquesComposantes& les statistiques cumulées
+    */
+    StatistiquesComposantes& StatistiquesComposantes::operator+=(const StatistiquesComposantes& autre) {
+        secondesTransposition += autre.secondesTransposition;
+        secondesPremierParcours += autre.secondesPremierParcours;
+        secondesSecondParcours += autre.secondesSecondParcours;
+        secondes += autre.secondes;
+        composantes += autre.composantes;
+        return *this;
+    }
+
+    /**
+    * \fn void HistogrammeLatences::enregistrer(double secondes)
+    * \brief Ajoute une mesure dans la classe correspondant à sa durée en microsecondes
+    * \param[in] secondes la durée mesurée
+    */
+    void HistogrammeLatences::enregistrer(double secondes) {
+        double microsecondes = secondes * 1e6;
+        size_t classe = 0;
+        if (microsecondes >= 1) {
+            int exposant;
+            std::frexp(microsecondes, &exposant);	// microsecondes dans [2^(exposant-1), 2^exposant)
+            classe = std::min<size_t>(static_cast<size_t>(exposant), NB_CLASSES - 1);
+        }
+
+        ++compteurs[classe];
+        ++nbMesures;
+        total += secondes;
+        if (secondes > plusLongue) plusLongue = secondes;
+    }
+
+    /**
+    * \fn double HistogrammeLatences::borneSuperieure(size_t classe)
+    * \brief Donne la borne supérieure (exclue) d'une classe
+    * \param[in] classe la classe
+    * \return double 2^classe microsecondes, en secondes
+    */
+    double HistogrammeLatences::borneSuperieure(size_t classe) {
+        return std::ldexp(1e-6, static_cast<int>(classe));
+    }
+
+    /**
+    * \fn double HistogrammeLatences::centile(double rang) const
+    * \brief Estime un centile: la borne supérieure de la première classe où le cumul des mesures atteint le rang demandé
+    * \param[in] rang le centile voulu, de 0 à 100
+    * \return double le centile estimé en secondes, ou 0 s'il n'y a aucune mesure
+    */
+    double HistogrammeLatences::centile(double rang) const {
+        if (nbMesures == 0) return 0;
+        auto seuil = static_cast<std::uint64_t>(std::ceil(rang / 100 * nbMesures));
+        if (seuil == 0) seuil = 1;
+
+        std::uint64_t cumul = 0;
+        for (size_t classe = 0; classe < NB_CLASSES; ++classe) {
+            cumul += compteurs[classe];
+            if (cumul >= seuil) return std::min(borneSuperieure(classe), plusLongue);
+        }
+        return plusLongue;
+    }
+
+    /**
+    * \fn Instrumentation::Instrumentation(const Instrumentation& autre)
+    * \brief Constructeur de copie: copie les données, pas le verrou
+    * \param[in] autre l'instrumentation à copier
+    */
+    Instrumentation::Instrumentation(const Instrumentation& autre) : bilan(autre.instantane()) {
+    }
+
+    /**
+    * \fn Instrumentation& Instrumentation::operator=(const Instrumentation& autre)
+    * \brief Affectation: copie les données, pas le verrou
+    * \param[in] autre l'instrumentation à copier
+    * \return Instrumentation& l'objet courant
+    */
+    Instrumentation& Instrumentation::operator=(const Instrumentation& autre) {
+        if (this != &autre) {
+            auto copie = autre.instantane();
+            std::lock_guard<std::mutex> garde(verrou);
+            bilan = copie;
+        }
+        return *this;
+    }
+
+    /**
+    * \fn void Instrumentation::enregistrerRecherche(const StatistiquesRequete& statistiques)
+    * \brief Ajoute une recherche de chemin terminée aux cumuls et à l'histogramme
+    * \param[in] statistiques les compteurs de la recherche
+    */
+    void Instrumentation::enregistrerRecherche(const StatistiquesRequete& statistiques) {
+        std::lock_guard<std::mutex> garde(verrou);
+        ++bilan.nbRecherches;
+        bilan.cumulRecherches += statistiques;
+        bilan.derniereRecherche = statistiques;
+        bilan.latencesRecherches.enregistrer(statistiques.secondes);
+    }
+
+    /**
+    * \fn void Instrumentation::enregistrerComposantes(const StatistiquesComposantes& statistiques)
+    * \brief Ajoute une recherche de composantes terminée aux cumuls et à l'histogramme
+    * \param[in] statistiques les durées des phases de la recherche
+    */
+    void Instrumentation::enregistrerComposantes(const StatistiquesComposantes& statistiques) {
+        std::lock_guard<std::mutex> garde(verrou);
+        ++bilan.nbComposantes;
+        bilan.cumulComposantes += statistiques;
+        bilan.dernieresComposantes = statistiques;
+        bilan.latencesComposantes.enregistrer(statistiques.secondes);
+    }
+
+    /**
+    * \fn BilanInstrumentation Instrumentation::instantane() const
+    * \brief Donne une copie des données accumulées, prise sous le verrou
+    * \return BilanInstrumentation la copie
+    */
+    BilanInstrumentation Instrumentation::instantane() const {
+        std::lock_guard<std::mutex> garde(verrou);
+        return bilan;
+    }
+
+    /**
+    * \fn void Instrumentation::reinitialiser()
+    * \brief Remet les compteurs, les durées et les histogrammes à zéro
+    */
+    void Instrumentation::reinitialiser() {
+        std::lock_guard<std::mutex> garde(verrou);
+        bilan = BilanInstrumentation();
+    }
+
+}//Fin du namespace
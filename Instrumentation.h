@@ -0,0 +1,150 @@
+/**
+ * \file Instrumentation.h
+ * \brief Compteurs et histogrammes de latence des recherches de chemin et de composantes.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ *  L'instrumentation est optionnelle: elle n'est compilée que si la macro TP2_INSTRUMENTATION est définie
+ *  (ex.: g++ -DTP2_INSTRUMENTATION ...).  Sans elle, TP2_INSTRUMENTER(...) ne produit aucun code, les recherches ne
+ *  comptent ni ne chronomètrent rien, et ReseauInterurbain::getInstrumentation() retourne un bilan vide.
+ *
+ */
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+#ifndef _INSTRUMENTATION__H
+#define _INSTRUMENTATION__H
+
+#ifdef TP2_INSTRUMENTATION
+#define TP2_INSTRUMENTER(...) __VA_ARGS__
+#else
+#define TP2_INSTRUMENTER(...)
+#endif
+
+namespace TP2
+{
+
+/**
+ * \struct StatistiquesRequete
+ * \brief Le travail fait par une recherche de chemin (ou la somme sur plusieurs recherches)
+ */
+struct StatistiquesRequete
+{
+	std::uint64_t sommetsResolus = 0;		// Sommets dont la distance est devenue définitive
+	std::uint64_t arcsExamines = 0;			// Arcs sortants examinés (tentatives de relaxation)
+	std::uint64_t relaxationsReussies = 0;	// Relaxations qui ont amélioré une distance
+	std::uint64_t insertionsTas = 0;
+	std::uint64_t retraitsTas = 0;
+	std::uint64_t allocations = 0;			// Tableaux de travail alloués, y compris les agrandissements du tas
+	double secondes = 0;					// Durée de la recherche, de la résolution des noms au chemin construit
+
+	StatistiquesRequete& operator+=(const StatistiquesRequete& autre);
+};
+
+/**
+ * \struct StatistiquesComposantes
+ * \brief Les durées des phases d'une recherche de composantes fortement connexes (ou leur somme).
+ *  Avec Kosaraju: transposition du graphe, parcours du graphe inverse, puis parcours du graphe dans l'ordre d'abandon.
+ *  Avec Tarjan, il n'y a pas de transposition: le premier parcours est la passe de Tarjan, le second le nommage des villes.
+ */
+struct StatistiquesComposantes
+{
+	double secondesTransposition = 0;
+	double secondesPremierParcours = 0;
+	double secondesSecondParcours = 0;
+	double secondes = 0;					// Durée totale
+	std::uint64_t composantes = 0;
+
+	StatistiquesComposantes& operator+=(const StatistiquesComposantes& autre);
+};
+
+/**
+ * \class HistogrammeLatences
+ * \brief Histogramme de latences à classes logarithmiques: la classe 0 compte les mesures de moins d'une microseconde,
+ *  la classe k >= 1 celles de [2^(k-1), 2^k) microsecondes.  Les centiles sont donc estimés à un facteur 2 près.
+ */
+class HistogrammeLatences
+{
+public:
+
+	static constexpr size_t NB_CLASSES = 40;
+
+	// Ajoute une mesure, en secondes
+	void enregistrer(double secondes);
+
+	// Retourne le nombre de mesures
+	std::uint64_t nombre() const { return nbMesures; }
+
+	// Retourne le nombre de mesures de la classe k (k < NB_CLASSES)
+	std::uint64_t compte(size_t classe) const { return compteurs[classe]; }
+
+	// Retourne la borne supérieure de la classe k, en secondes
+	static double borneSuperieure(size_t classe);
+
+	// Retourne la borne supérieure de la classe contenant le centile demandé (0 à 100), en secondes; 0 si aucune mesure
+	double centile(double rang) const;
+
+	// Retourne la moyenne et le maximum des mesures, en secondes
+	double moyenne() const { return nbMesures ? total / nbMesures : 0; }
+	double maximum() const { return plusLongue; }
+
+private:
+	std::array<std::uint64_t, NB_CLASSES> compteurs{};
+	std::uint64_t nbMesures = 0;
+	double total = 0;
+	double plusLongue = 0;
+};
+
+/**
+ * \struct BilanInstrumentation
+ * \brief Copie des données d'instrumentation à un instant donné
+ */
+struct BilanInstrumentation
+{
+	std::uint64_t nbRecherches = 0;
+	StatistiquesRequete cumulRecherches;
+	StatistiquesRequete derniereRecherche;
+	HistogrammeLatences latencesRecherches;
+
+	std::uint64_t nbComposantes = 0;
+	StatistiquesComposantes cumulComposantes;
+	StatistiquesComposantes dernieresComposantes;
+	HistogrammeLatences latencesComposantes;
+};
+
+/**
+ * \class Instrumentation
+ * \brief Accumule les statistiques des recherches.  Chaque recherche compte dans ses propres variables locales et
+ *  n'entre dans l'accumulateur qu'une fois terminée, sous un verrou: des recherches concurrentes peuvent donc
+ *  s'y enregistrer sans se gêner dans leurs boucles.
+ */
+class Instrumentation
+{
+public:
+
+	Instrumentation() = default;
+	Instrumentation(const Instrumentation& autre);
+	Instrumentation& operator=(const Instrumentation& autre);
+
+	void enregistrerRecherche(const StatistiquesRequete& statistiques);
+	void enregistrerComposantes(const StatistiquesComposantes& statistiques);
+
+	// Retourne une copie cohérente des données accumulées
+	BilanInstrumentation instantane() const;
+
+	// Remet toutes les données à zéro
+	void reinitialiser();
+
+private:
+	mutable std::mutex verrou;
+	BilanInstrumentation bilan;
+};
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,241 @@
+/**
+ * \file Parallele.h
+ * \brief Répartition de tâches indépendantes entre des fils d'exécution.
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef _PARALLELE__H
+#define _PARALLELE__H
+
+namespace TP2
+{
+
+/**
+ * \fn unsigned nombreFils(unsigned nbFils, size_t nbTaches)
+ * \brief Donne le nombre de fils qu'utilisera repartir: nbFils (0: autant que de coeurs), sans dépasser le nombre de
+ *  tâches, et au moins 1
+ */
+inline unsigned nombreFils(unsigned nbFils, size_t nbTaches)
+{
+	if (nbFils == 0) nbFils = std::max(1u, std::thread::hardware_concurrency());
+	return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(nbFils, nbTaches)));
+}
+
+/**
+ * \class Repartition
+ * \brief Le vol de travail d'une répartition: chaque fil reçoit une plage contiguë de tâches qu'il exécute dans l'ordre;
+ *  un fil dont la plage est épuisée vole la seconde moitié de la plage d'un autre fil.  Les fils ne partagent donc aucun
+ *  compteur, et des tâches de durées inégales restent équilibrées.  Chaque fil appelle travailler(fil) une fois, puis
+ *  le fil appelant appelle terminer() quand tous ont fini.
+ */
+template <typename Travail>
+class Repartition
+{
+public:
+
+	Repartition(size_t nbTaches, unsigned nbFils, Travail& travail) : plages(nbFils), nbFils(nbFils), travail(travail), arret(false) {
+		for (unsigned f = 0; f < nbFils; ++f) {
+			plages[f].debut = nbTaches * f / nbFils;
+			plages[f].fin = nbTaches * (f + 1) / nbFils;
+		}
+	}
+
+	// Exécute les tâches de la plage du fil, puis celles qu'il vole, jusqu'à ce qu'il n'en reste plus
+	void travailler(unsigned fil) {
+		size_t tache;
+		while (!arret) {
+			if (!prendre(fil, tache)) {
+				if (voler(fil)) continue;
+				return;
+			}
+			try {
+				travail(tache, fil);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> garde(verrouErreur);
+				if (!erreur) erreur = std::current_exception();
+				arret = true;
+			}
+		}
+	}
+
+	// Relance la première exception levée par une tâche
+	void terminer() {
+		if (erreur) std::rethrow_exception(erreur);
+	}
+
+private:
+
+	/**
+	 * \struct Plage
+	 * \brief Les tâches [debut, fin) qui restent à un fil, sur sa propre ligne de cache
+	 */
+	struct alignas(64) Plage
+	{
+		std::mutex verrou;
+		size_t debut = 0;
+		size_t fin = 0;
+	};
+
+	std::vector<Plage> plages;
+	unsigned nbFils;
+	Travail& travail;
+	std::atomic<bool> arret;
+	std::exception_ptr erreur;
+	std::mutex verrouErreur;
+
+	bool prendre(unsigned fil, size_t& tache) {
+		std::lock_guard<std::mutex> garde(plages[fil].verrou);
+		if (plages[fil].debut == plages[fil].fin) return false;
+		tache = plages[fil].debut++;
+		return true;
+	}
+
+	bool voler(unsigned fil) {
+		for (unsigned i = 1; i < nbFils; ++i) {
+			auto& victime = plages[(fil + i) % nbFils];
+			size_t debut, fin;
+			{
+				std::lock_guard<std::mutex> garde(victime.verrou);
+				size_t reste = victime.fin - victime.debut;
+				if (reste == 0) continue;
+				debut = victime.fin - (reste + 1) / 2;
+				fin = victime.fin;
+				victime.fin = debut;
+			}
+			std::lock_guard<std::mutex> garde(plages[fil].verrou);
+			plages[fil].debut = debut;
+			plages[fil].fin = fin;
+			return true;
+		}
+		return false;
+	}
+};
+
+/**
+ * \fn void repartir(size_t nbTaches, unsigned nbFils, Travail travail)
+ * \brief Exécute travail(tache, fil) pour chaque tâche de [0, nbTaches) sur nombreFils(nbFils, nbTaches) fils, par vol
+ *  de travail (voir Repartition).  Le fil appelant est le fil 0 et fil < nombreFils(...), ce qui permet à chaque fil
+ *  d'avoir ses propres tableaux de travail.  Les fils sont créés pour cet appel: un calcul qui répartit souvent de
+ *  petits lots garde plutôt une EquipeFils.
+ * \exception la première exception levée par une tâche, relancée dans le fil appelant une fois tous les fils terminés
+ *  (les tâches restantes ne sont pas commencées)
+ */
+template <typename Travail>
+void repartir(size_t nbTaches, unsigned nbFils, Travail travail)
+{
+	nbFils = nombreFils(nbFils, nbTaches);
+	Repartition<Travail> repartition(nbTaches, nbFils, travail);
+
+	std::vector<std::thread> fils;
+	for (unsigned i = 1; i < nbFils; ++i) fils.emplace_back([&repartition, i]() { repartition.travailler(i); });
+	repartition.travailler(0);
+	for (auto& f: fils) f.join();
+	repartition.terminer();
+}
+
+/**
+ * \class EquipeFils
+ * \brief Des fils d'exécution créés une fois et gardés en attente entre les répartitions, pour les calculs qui
+ *  répartissent de nombreux lots courts: créer et joindre les fils à chaque lot coûterait plus que le lot lui-même.
+ *  Les répartitions d'une équipe se font l'une après l'autre; le fil qui en lance une en est le fil 0.
+ */
+class EquipeFils
+{
+public:
+
+	// Crée nombreFils(nbFils, ...) - 1 fils en attente; le fil appelant est le fil 0 de chaque répartition
+	explicit EquipeFils(unsigned nbFils) : generation(0), nbParticipants(0), nbActifs(0), fin(false) {
+		nbFils = nombreFils(nbFils, std::numeric_limits<unsigned>::max());
+		for (unsigned i = 1; i < nbFils; ++i) fils.emplace_back([this, i]() { attendre(i); });
+	}
+
+	EquipeFils(const EquipeFils&) = delete;
+	EquipeFils& operator=(const EquipeFils&) = delete;
+
+	~EquipeFils() {
+		{
+			std::lock_guard<std::mutex> garde(verrou);
+			fin = true;
+		}
+		reveil.notify_all();
+		for (auto& f: fils) f.join();
+	}
+
+	// Retourne le nombre de fils, le fil appelant compris
+	unsigned taille() const { return static_cast<unsigned>(fils.size()) + 1; }
+
+	// Comme la fonction repartir, sur min(taille(), nbTaches) fils de l'équipe
+	template <typename Travail>
+	void repartir(size_t nbTaches, Travail travail) {
+		const unsigned nbFils = nombreFils(taille(), nbTaches);
+		Repartition<Travail> repartition(nbTaches, nbFils, travail);
+		if (nbFils > 1) {
+			std::function<void(unsigned)> tache = [&repartition](unsigned fil) { repartition.travailler(fil); };
+			{
+				std::lock_guard<std::mutex> garde(verrou);
+				courante = &tache;
+				nbParticipants = nbFils;
+				nbActifs = nbFils - 1;
+				++generation;
+			}
+			reveil.notify_all();
+			repartition.travailler(0);
+			std::unique_lock<std::mutex> garde(verrou);
+			fini.wait(garde, [this]() { return nbActifs == 0; });
+			courante = nullptr;
+		}
+		else repartition.travailler(0);
+		repartition.terminer();
+	}
+
+private:
+
+	std::vector<std::thread> fils;
+	std::mutex verrou;
+	std::condition_variable reveil, fini;
+	const std::function<void(unsigned)>* courante = nullptr;	// la répartition en cours
+	std::uint64_t generation;	// nombre de répartitions lancées
+	unsigned nbParticipants;	// fils de la répartition en cours, le fil appelant compris
+	unsigned nbActifs;			// fils de la répartition en cours qui n'ont pas fini
+	bool fin;
+
+	// Boucle d'un fil: attend chaque répartition et y participe s'il en fait partie
+	void attendre(unsigned fil) {
+		std::uint64_t vue = 0;
+		while (true) {
+			const std::function<void(unsigned)>* tache;
+			{
+				std::unique_lock<std::mutex> garde(verrou);
+				reveil.wait(garde, [&]() { return fin || generation != vue; });
+				if (fin) return;
+				vue = generation;
+				if (fil >= nbParticipants) continue;
+				tache = courante;
+			}
+			(*tache)(fil);
+			std::lock_guard<std::mutex> garde(verrou);
+			if (--nbActifs == 0) fini.notify_one();
+		}
+	}
+};
+
+}//Fin du namespace
+
+#endif
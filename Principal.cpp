@@ -9,7 +9,7 @@
 
 #include <iostream>
 #include <fstream>
-#include <ctime>
+#include <chrono>
 
 #include "ReseauInterurbain.h"
 
@@ -25,7 +25,8 @@ int main()
 	ReseauInterurbain reseau("");	//Le reseau utilisé pour les tests.
 	ifstream EntreeFichier;		//Flux d'entrée
 	ofstream SortieFichier;		//Flux d'entrée
-	clock_t startTime, endTime;  	//Pour mesurer l'efficacité des algorithmes
+	chrono::steady_clock::time_point startTime, endTime;  	//Pour mesurer l'efficacité des algorithmes (horloge monotone)
+	const int nbRepetitions = 100;	//Nombre d'exécutions mesurées par les options 4 et 5
 
 
 	cout << "Bienvenu dans votre reseau de transport interurbain !" << endl;
@@ -74,8 +75,11 @@ int main()
 					cin >> villeDepart;
 					cout << "Entrez la ville de destination:? ";
 					cin >> villeDestination;
-					Chemin ch1_dijkstra = reseau.rechercheCheminDijkstra(villeDepart, villeDestination, true);
-					Chemin ch2_dijkstra = reseau.rechercheCheminDijkstra(villeDepart, villeDestination, false);
+					//Une seule recherche: le plus rapide et le moins cher sont les deux bouts du front de Pareto
+					std::vector<Chemin> front = reseau.rechercheCheminsPareto(villeDepart, villeDestination);
+					Chemin aucun = {{}, 0, 0, false};
+					Chemin ch1_dijkstra = front.empty() ? aucun : front.front();
+					Chemin ch2_dijkstra = front.empty() ? aucun : front.back();
 					if(ch1_dijkstra.reussi)
 					{
 						cout << "Liste des villes du plus court chemin en utilisant la duree du trajet:" << endl;
@@ -112,21 +116,25 @@ int main()
 				case 4: //Mesurer le temps d'exécution de Dijkstra.
 				{
 					cout << "Mesurer le temps d'execution de Dijkstra." << endl;
-					startTime = clock();
-					for(int i=0; i<100; i++)
+					startTime = chrono::steady_clock::now();
+					for(int i=0; i<nbRepetitions; i++)
 						Chemin bench_qt_dikstra = reseau.rechercheCheminDijkstra("Quebec-Centre-Ville", "Montreal-Aeroport-Trudeau", true);
-					endTime = clock();
-					cout << "Temps d'execution: " << endTime - startTime << " microsecondes" << endl;
+					endTime = chrono::steady_clock::now();
+					auto total = chrono::duration<double, micro>(endTime - startTime).count();
+					cout << "Temps d'execution (" << nbRepetitions << " executions): " << total << " microsecondes, soit "
+						 << total / nbRepetitions << " microsecondes par execution" << endl;
 					break;
 				}
 				case 5: //Mesurer le temps d'exécution de Kosaraju.
 				{
 					cout << "Mesurer le temps d'execution de Kosaraju." << endl;
-					startTime = clock();
-					for(int i=0; i<100; i++)
+					startTime = chrono::steady_clock::now();
+					for(int i=0; i<nbRepetitions; i++)
 						std::vector<std::vector<std::string> > bench_qt_Kosaraju = reseau.algorithmeKosaraju();
-					endTime = clock();
-					cout << "Temps d'execution: " << endTime - startTime << " microsecondes" << endl;
+					endTime = chrono::steady_clock::now();
+					auto total = chrono::duration<double, micro>(endTime - startTime).count();
+					cout << "Temps d'execution (" << nbRepetitions << " executions): " << total << " microsecondes, soit "
+						 << total / nbRepetitions << " microsecondes par execution" << endl;
 					break;
 				}
 			}
@@ -0,0 +1,228 @@
+/**
+ * \file Reperes.cpp
+ * \brief Implémentation des points de repère pour la recherche A* (ALT).
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include "Reperes.h"
+#include "Parallele.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace TP2
+{
+    namespace
+    {
+        const char SIGNATURE[8] = {'T', 'P', '2', 'A', 'L', 'T', '\0', '\0'};
+        const std::uint64_t VERSION_REPERES = 2;
+
+        /**
+        * \fn void calculerDistances(const GrapheCompact& graphe, size_t source, bool dureeCout, float* distances)
+        * \brief Dijkstra complet depuis source (tas binaire, suppression paresseuse)
+        * \param[in] graphe le graphe parcouru (l'inverse pour les distances vers source)
+        * \param[in] source le sommet de départ
+        * \param[in] dureeCout le critère
+        * \param[out] distances graphe.taille() cases, infinies pour les sommets non atteints
+        */
+        void calculerDistances(const GrapheCompact& graphe, size_t source, bool dureeCout, float* distances) {
+            using Entree = std::pair<float, std::uint32_t>;
+            const std::greater<Entree> priorite;
+            std::fill(distances, distances + graphe.taille(), std::numeric_limits<float>::infinity());
+
+            std::vector<Entree> tas;
+            distances[source] = 0;
+            tas.emplace_back(0.f, static_cast<std::uint32_t>(source));
+            while (!tas.empty()) {
+                std::pop_heap(tas.begin(), tas.end(), priorite);
+                auto entree = tas.back();
+                tas.pop_back();
+                if (entree.first > distances[entree.second]) continue;
+
+                for (auto arc = graphe.debutArcs(entree.second); arc < graphe.finArcs(entree.second); ++arc) {
+                    auto voisin = graphe.destination(arc);
+                    float distance = entree.first + graphe.poids(arc, dureeCout);
+                    if (distance < distances[voisin]) {
+                        distances[voisin] = distance;
+                        tas.emplace_back(distance, static_cast<std::uint32_t>(voisin));
+                        std::push_heap(tas.begin(), tas.end(), priorite);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+    * \fn Reperes::Reperes()
+    * \brief Constructeur par défaut: aucun repère
+    */
+    Reperes::Reperes() : nbSommets(0), nbArcs(0), empreinte(0) {
+    }
+
+    /**
+    * \fn Reperes Reperes::preparer(const GrapheCompact& graphe, size_t nbReperes, unsigned nbFils)
+    * \brief Choisit les repères puis calcule leurs tables.  Le choix est séquentiel: chaque repère est le sommet le plus
+    * éloigné des précédents selon les distances en durée depuis ceux-ci, qui forment la première table de chaque repère.
+    * Les trois autres tables (durée vers le repère, coût depuis et vers) sont des Dijkstra indépendants, répartis entre
+    * les fils d'exécution.
+    * \param[in] graphe le graphe
+    * \param[in] nbReperes le nombre de repères voulu (au plus taille())
+    * \param[in] nbFils le nombre de fils d'exécution, 0 pour std::thread::hardware_concurrency()
+    * \return Reperes les repères et leurs tables
+    */
+    Reperes Reperes::preparer(const GrapheCompact& graphe, size_t nbReperes, unsigned nbFils) {
+        Reperes resultat;
+        const size_t n = graphe.taille();
+        resultat.nbSommets = n;
+        resultat.nbArcs = graphe.getNombreArcs();
+        resultat.empreinte = graphe.empreinte();
+        nbReperes = std::min(nbReperes, n);
+        if (nbReperes == 0) return resultat;
+
+        for (auto& critere: resultat.distances)
+            for (auto& table: critere) table.resize(nbReperes * n);
+
+        //Choix des repères, par le sommet le plus éloigné; un sommet non atteint est infiniment éloigné
+        std::vector<float> eloignement(n, std::numeric_limits<float>::infinity());
+        auto plusEloigne = [&](const float* distances) {
+            size_t choisi = 0;
+            for (size_t v = 1; v < n; ++v)
+                if (distances[v] > distances[choisi]) choisi = v;
+            return choisi;
+        };
+        {
+            std::vector<float> depuisZero(n);
+            calculerDistances(graphe, 0, true, depuisZero.data());
+            resultat.reperes.push_back(static_cast<std::uint32_t>(plusEloigne(depuisZero.data())));
+        }
+        for (size_t r = 0; r < nbReperes; ++r) {
+            float* table = resultat.distances[0][0].data() + r * n;
+            calculerDistances(graphe, resultat.reperes[r], true, table);
+            for (size_t v = 0; v < n; ++v) eloignement[v] = std::min(eloignement[v], table[v]);
+            for (auto repere: resultat.reperes) eloignement[repere] = -1;
+            if (r + 1 < nbReperes) resultat.reperes.push_back(static_cast<std::uint32_t>(plusEloigne(eloignement.data())));
+        }
+
+        //Les autres tables, en parallèle
+        const GrapheCompact inverse = graphe.inverse();
+        const int CRITERES[3] = {0, 1, 1};	// tâches de chaque repère: (durée, vers), (coût, depuis), (coût, vers)
+        const int SENS[3] = {1, 0, 1};
+        repartir(3 * nbReperes, nbFils, [&](size_t tache, unsigned) {
+            size_t r = tache / 3;
+            int critere = CRITERES[tache % 3], sens = SENS[tache % 3];
+            float* table = resultat.distances[critere][sens].data() + r * n;
+            calculerDistances(sens == 0 ? graphe : inverse, resultat.reperes[r], critere == 0, table);
+        });
+
+        //Les tables ont été remplies par repère; borne() les lit par sommet
+        std::vector<float> transposee(nbReperes * n);
+        for (auto& critere: resultat.distances)
+            for (auto& table: critere) {
+                for (size_t r = 0; r < nbReperes; ++r)
+                    for (size_t v = 0; v < n; ++v) transposee[v * nbReperes + r] = table[r * n + v];
+                table.swap(transposee);
+            }
+
+        return resultat;
+    }
+
+    /**
+    * \fn float Reperes::borne(size_t sommet, size_t cible, bool dureeCout) const
+    * \brief Donne la meilleure borne inférieure de d(sommet, cible) que fournissent les repères.  Une différence indéfinie
+    * (infini moins infini) ne borne rien et est ignorée.
+    * \param[in] sommet le sommet de départ
+    * \param[in] cible le sommet d'arrivée
+    * \param[in] dureeCout le critère
+    * \return float la borne, au moins 0, infinie si cible n'est pas atteignable depuis sommet
+    */
+    float Reperes::borne(size_t sommet, size_t cible, bool dureeCout) const {
+        const auto& depuis = distances[dureeCout ? 0 : 1][0];
+        const auto& vers = distances[dureeCout ? 0 : 1][1];
+
+        const size_t k = reperes.size();
+        const float* depuisSommet = depuis.data() + sommet * k;
+        const float* depuisCible = depuis.data() + cible * k;
+        const float* versSommet = vers.data() + sommet * k;
+        const float* versCible = vers.data() + cible * k;
+
+        float meilleure = 0;
+        for (size_t r = 0; r < k; ++r) {
+            float avant = depuisCible[r] - depuisSommet[r];
+            float arriere = versSommet[r] - versCible[r];
+            if (avant > meilleure) meilleure = avant;
+            if (arriere > meilleure) meilleure = arriere;
+        }
+        return meilleure;
+    }
+
+    /**
+    * \fn void Reperes::sauvegarder(const std::string& fichier) const
+    * \brief Écrit les repères: signature, version, nombres de sommets, d'arcs et de repères, empreinte du graphe, les
+    * repères, puis les quatre tables (durée depuis, durée vers, coût depuis, coût vers)
+    * \param[in] fichier le chemin du fichier
+    * \exception logic_error si le fichier ne peut pas être écrit
+    */
+    void Reperes::sauvegarder(const std::string& fichier) const {
+        std::ofstream sortie(fichier, std::ios::binary | std::ios::trunc);
+        if (!sortie) throw std::logic_error("Reperes::sauvegarder : impossible d'ouvrir " + fichier);
+
+        const std::uint64_t entete[5] = {VERSION_REPERES, nbSommets, nbArcs, reperes.size(), empreinte};
+        sortie.write(SIGNATURE, sizeof(SIGNATURE));
+        sortie.write(reinterpret_cast<const char*>(entete), sizeof(entete));
+        sortie.write(reinterpret_cast<const char*>(reperes.data()), static_cast<std::streamsize>(reperes.size() * sizeof(std::uint32_t)));
+        for (const auto& critere: distances)
+            for (const auto& table: critere)
+                sortie.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(float)));
+
+        if (!sortie.flush()) throw std::logic_error("Reperes::sauvegarder : écriture incomplète de " + fichier);
+    }
+
+    /**
+    * \fn Reperes Reperes::charger(const std::string& fichier)
+    * \brief Relit un fichier écrit par sauvegarder
+    * \param[in] fichier le chemin du fichier
+    * \exception logic_error si le fichier ne peut pas être lu, n'est pas un fichier de repères ou est tronqué
+    * \return Reperes les repères relus
+    */
+    Reperes Reperes::charger(const std::string& fichier) {
+        std::ifstream entree(fichier, std::ios::binary);
+        if (!entree) throw std::logic_error("Reperes::charger : impossible d'ouvrir " + fichier);
+
+        char signature[sizeof(SIGNATURE)];
+        std::uint64_t entete[5];
+        entree.read(signature, sizeof(signature));
+        entree.read(reinterpret_cast<char*>(entete), sizeof(entete));
+        if (!entree || std::memcmp(signature, SIGNATURE, sizeof(SIGNATURE)) != 0)
+            throw std::logic_error("Reperes::charger : " + fichier + " n'est pas un fichier de repères");
+        if (entete[0] != VERSION_REPERES)
+            throw std::logic_error("Reperes::charger : version non prise en charge (" + std::to_string(entete[0]) + ")");
+        if (entete[3] > entete[1] || entete[1] >= std::numeric_limits<std::uint32_t>::max())
+            throw std::logic_error("Reperes::charger : " + fichier + " est corrompu");
+
+        Reperes resultat;
+        resultat.nbSommets = entete[1];
+        resultat.nbArcs = entete[2];
+        resultat.empreinte = entete[4];
+        resultat.reperes.resize(entete[3]);
+        entree.read(reinterpret_cast<char*>(resultat.reperes.data()), static_cast<std::streamsize>(resultat.reperes.size() * sizeof(std::uint32_t)));
+        for (auto& critere: resultat.distances)
+            for (auto& table: critere) {
+                table.resize(resultat.reperes.size() * resultat.nbSommets);
+                entree.read(reinterpret_cast<char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(float)));
+            }
+        if (!entree) throw std::logic_error("Reperes::charger : " + fichier + " est tronqué");
+        for (auto repere: resultat.reperes)
+            if (repere >= resultat.nbSommets) throw std::logic_error("Reperes::charger : " + fichier + " est corrompu");
+
+        return resultat;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,86 @@
+/**
+ * \file Reperes.h
+ * \brief Points de repère (landmarks) et bornes inférieures de distance pour la recherche A* (ALT).
+ * \author Olivier Caron
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *  Travail pratique numéro 2
+ *
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GrapheCompact.h"
+
+#ifndef _REPERES__H
+#define _REPERES__H
+
+namespace TP2
+{
+
+/**
+ * \class Reperes
+ * \brief Distances exactes depuis et vers quelques sommets choisis (les repères), pour les deux critères.
+ *
+ *  Par l'inégalité du triangle, pour tout repère L: d(v, t) >= d(L, t) - d(L, v) et d(v, t) >= d(v, L) - d(t, L).
+ *  La plus grande de ces bornes guide la recherche A* vers la destination.  Une borne infinie prouve que t n'est pas
+ *  atteignable depuis v.
+ *
+ *  Les repères sont choisis par le sommet le plus éloigné (en durée) des repères déjà choisis, en commençant par le
+ *  sommet le plus éloigné du sommet 0; les sommets qu'aucun repère n'atteint passent en premier.  Les tables occupent
+ *  16 octets par sommet et par repère (2 sens x 2 critères).
+ */
+class Reperes
+{
+public:
+
+	// Construit un ensemble vide de repères: borne() vaut toujours 0
+	Reperes();
+
+	// Choisit nbReperes repères et calcule leurs tables, sur nbFils fils d'exécution (0: autant que de coeurs)
+	static Reperes preparer(const GrapheCompact& graphe, size_t nbReperes, unsigned nbFils = 0);
+
+	// Retourne le nombre de repères
+	size_t nombre() const { return reperes.size(); }
+
+	// Retourne le nombre de sommets du graphe pour lequel les tables ont été calculées
+	size_t taille() const { return nbSommets; }
+
+	// Retourne le nombre d'arcs du graphe pour lequel les tables ont été calculées
+	size_t getNombreArcs() const { return nbArcs; }
+
+	// Retourne l'empreinte (GrapheCompact::empreinte) du graphe pour lequel les tables ont été calculées
+	std::uint64_t getEmpreinte() const { return empreinte; }
+
+	// Retourne les sommets choisis comme repères, dans l'ordre du choix
+	const std::vector<std::uint32_t>& getSommets() const { return reperes; }
+
+	// Retourne une borne inférieure de la distance de sommet à cible (durée si dureeCout, coût sinon),
+	// possiblement infinie si cible n'est pas atteignable depuis sommet
+	float borne(size_t sommet, size_t cible, bool dureeCout) const;
+
+	// Écrit les repères et leurs tables dans un fichier binaire
+	// Exception logic_error si le fichier ne peut pas être écrit
+	void sauvegarder(const std::string& fichier) const;
+
+	// Relit un fichier écrit par sauvegarder
+	// Exception logic_error si le fichier ne peut pas être lu ou n'est pas un fichier de repères valide
+	static Reperes charger(const std::string& fichier);
+
+private:
+
+	std::vector<std::uint32_t> reperes;
+	size_t nbSommets;
+	size_t nbArcs;
+	std::uint64_t empreinte;
+
+	// distances[critere][sens][v * nombre() + r], critere 0: durée, 1: coût; sens 0: d(repère r, v), sens 1: d(v, repère r).
+	// Les distances d'un sommet à tous les repères sont contiguës: une borne lit deux lignes de nombre() cases par table.
+	std::vector<float> distances[2][2];
+};
+
+}//Fin du namespace
+
+#endif
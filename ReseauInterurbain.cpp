@@ -10,7 +10,12 @@
  */
 #include <sstream>
 #include <fstream>
+#include <charconv>
+#include <chrono>
+#include <string_view>
+#include <thread>
 #include "ReseauInterurbain.h"
+#include "Parallele.h"
 //vous pouvez inclure d'autres librairies si c'est nécessaire
 
 namespace TP2
@@ -23,7 +28,7 @@ namespace TP2
     * \param[in] nbVilles le nombre de villes du réseau
     * \return Un objet Graphe
     */
-    ReseauInterurbain::ReseauInterurbain(std::string nomReseau, size_t nbVilles) : nomReseau(nomReseau), unReseau(nbVilles){
+    ReseauInterurbain::ReseauInterurbain(std::string nomReseau, size_t nbVilles) : nomReseau(nomReseau), unReseau(nbVilles), reseauFige(unReseau.figer()), grapheAJour(true), moteur(MoteurRecherche::Tas), moteurComposantes(MoteurComposantes::Tarjan), nbFilsComposantes(0), moteurArbres(MoteurArbres::Dijkstra), nbFilsArbres(0), suiviComposantes(false), suiviArbres(false){
     }
 
     /**
@@ -40,69 +45,187 @@ namespace TP2
     * \param[in] nouvelleTaille la nouvelle taille du réseau
     */
     void ReseauInterurbain::resize(size_t nouvelleTaille){
+        degeler();
         unReseau.resize(nouvelleTaille);
+        reseauFige = unReseau.figer();
+        etatInstantane.aJour = true;
+        oublierPretraitements();
+        arreterSuiviComposantes();
+        arreterSuiviArbres();
     }
 
     /**
     * \fn void chargerReseau(std::ifstream & fichierEntree)
-    * \brief Fonction servant à charger un réseau.
+    * \brief Fonction servant à charger un réseau.  Le reste du fichier est lu par blocs dans un seul tampon, puis découpé
+    * en lignes sans copie; les nombres sont lus avec std::from_chars et les villes retrouvées par l'index des noms.  Les
+    * trajets sont ajoutés d'un coup par Graphe::ajouterArcs, qui détecte les doublons en une seule passe.  Le débit du
+    * chargement est conservé (voir getStatistiquesChargement).  Le réseau est lu dans un graphe à part, qui ne remplace
+    * le réseau courant qu'une fois le fichier entièrement lu: si le fichier est invalide, le réseau reste inchangé.
     * \param[in] fichierEntree le fichier contenant toutes les villes du réseau
      * \exception logic_error si le fichier n'est pas ouvert correctement
+     * \exception logic_error si une ville d'un trajet est inconnue ou si un trajet est mal formé
+     * \exception logic_error si un trajet apparaît deux fois
     */
-    // Méthode fournie
     void ReseauInterurbain::chargerReseau(std::ifstream & fichierEntree)
     {
         if (!fichierEntree.is_open())
             throw std::logic_error("ReseauInterurbain::chargerReseau: Le fichier n'est pas ouvert !");
 
-        std::string buff;
+        auto debut = std::chrono::steady_clock::now();
 
-        getline(fichierEntree, nomReseau);
-        nomReseau.erase(0, 20); // Enlève: Reseau Interurbain:
+        //Lecture par blocs de 1 Mo dans un seul tampon
+        std::string tampon;
+        const std::streamsize BLOC = 1 << 20;
+        for (std::streamsize lus = BLOC; lus == BLOC; ) {
+            auto taille = tampon.size();
+            tampon.resize(taille + BLOC);
+            lus = fichierEntree.rdbuf()->sgetn(&tampon[taille], BLOC);
+            tampon.resize(taille + static_cast<size_t>(lus));
+        }
 
-        int nbVilles;
+        size_t position = 0;
+        size_t lignes = 0;
+        auto prochaineLigne = [&](std::string_view& ligne) {
+            if (position >= tampon.size()) return false;
+            auto fin = tampon.find('\n', position);
+            if (fin == std::string::npos) fin = tampon.size();
+            ligne = std::string_view(tampon.data() + position, fin - position);
+            if (!ligne.empty() && ligne.back() == '\r') ligne.remove_suffix(1);
+            position = fin + 1;
+            ++lignes;
+            return true;
+        };
+        auto lireNombre = [](std::string_view& texte, auto& valeur) {
+            while (!texte.empty() && (texte.front() == ' ' || texte.front() == '\t')) texte.remove_prefix(1);
+            auto resultat = std::from_chars(texte.data(), texte.data() + texte.size(), valeur);
+            if (resultat.ec != std::errc()) return false;
+            texte.remove_prefix(static_cast<size_t>(resultat.ptr - texte.data()));
+            return true;
+        };
 
-        fichierEntree >> nbVilles;
-        getline(fichierEntree, buff); //villes
+        std::string_view ligne;
 
-        unReseau.resize(nbVilles);
+        prochaineLigne(ligne);
+        std::string nouveauNom(ligne.substr(std::min<size_t>(20, ligne.size()))); // Enlève: Reseau Interurbain:
 
-        getline(fichierEntree, buff); //Liste des villes
+        size_t nbVilles = 0;
+        prochaineLigne(ligne); //villes
+        lireNombre(ligne, nbVilles);
 
-        size_t i = 0;
+        Graphe nouveauReseau(nbVilles);
 
-        getline(fichierEntree, buff); //Premiere ville
+        prochaineLigne(ligne); //Liste des villes
 
-        while(buff != "Liste des trajets:")
-        {
-            unReseau.nommer(i, buff);
-            getline(fichierEntree, buff);
-            i++;
+        std::string nom;
+        for (size_t i = 0; prochaineLigne(ligne) && ligne != "Liste des trajets:"; ++i) {
+            nom.assign(ligne);
+            nouveauReseau.nommer(i, nom);
         }
 
-        while(!fichierEntree.eof())
+        std::vector<Graphe::NouvelArc> trajets;
+        trajets.reserve(tampon.size() / 32);
+        std::string_view source, destination;
+        while (prochaineLigne(source))
         {
-            getline(fichierEntree, buff);
-            std::string source = buff;
-            getline(fichierEntree, buff);
-            std::string destination = buff;
+            if (source.empty()) continue;
+            if (!prochaineLigne(destination) || !prochaineLigne(ligne))
+                throw std::logic_error("ReseauInterurbain::chargerReseau: trajet incomplet ligne " + std::to_string(lignes));
+
+            Graphe::NouvelArc trajet;
+            trajet.source = nouveauReseau.chercherSommet(source);
+            trajet.destination = nouveauReseau.chercherSommet(destination);
+            if (!nouveauReseau.sommetExiste(trajet.source) || !nouveauReseau.sommetExiste(trajet.destination))
+                throw std::logic_error("ReseauInterurbain::chargerReseau: ville inconnue dans le trajet se terminant ligne " + std::to_string(lignes));
+            if (!lireNombre(ligne, trajet.poids.duree) || !lireNombre(ligne, trajet.poids.cout))
+                throw std::logic_error("ReseauInterurbain::chargerReseau: pondérations mal formées ligne " + std::to_string(lignes));
 
-            getline(fichierEntree, buff);
-            std::istringstream iss(buff);
+            trajets.push_back(trajet);
+        }
+        nouveauReseau.ajouterArcs(trajets);
 
-            float duree;
-            iss >> duree;
+        //Le fichier est valide: le nouveau réseau remplace l'ancien, et les recherches se font sur son instantané compact
+        reseauFige = nouveauReseau.figer();
+        unReseau = std::move(nouveauReseau);
+        nomReseau = std::move(nouveauNom);
+        etatInstantane.aJour = true;
+        grapheAJour = true;
+        oublierPretraitements();
+        arreterSuiviComposantes();
+        arreterSuiviArbres();
 
-            float cout;
-            iss >> cout;
+        statistiquesChargement.lignes = lignes;
+        statistiquesChargement.octets = tampon.size();
+        statistiquesChargement.secondes = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+        statistiquesChargement.lignesParSeconde = statistiquesChargement.secondes > 0 ? lignes / statistiquesChargement.secondes : 0;
+        statistiquesChargement.megaoctetsParSeconde = statistiquesChargement.secondes > 0 ? tampon.size() / 1e6 / statistiquesChargement.secondes : 0;
+    }
 
-            unReseau.ajouterArc(unReseau.getNumeroSommet(source), unReseau.getNumeroSommet(destination), duree, cout);
-        }
+    /**
+    * \fn StatistiquesChargement getStatistiquesChargement() const
+    * \brief Donne les statistiques du dernier appel à chargerReseau
+    * \return StatistiquesChargement les lignes et octets lus, la durée et le débit du chargement
+    */
+    StatistiquesChargement ReseauInterurbain::getStatistiquesChargement() const {
+        return statistiquesChargement;
+    }
+
+    /**
+    * \fn void sauvegarderInstantane(const std::string& fichier) const
+    * \brief Fonction servant à écrire le réseau dans un instantané binaire.  L'instantané compact est écrit tel quel, avec
+    * le nom du réseau comme étiquette.
+    * \param[in] fichier le chemin du fichier à écrire
+    * \exception logic_error si le fichier ne peut pas être écrit
+    */
+    void ReseauInterurbain::sauvegarderInstantane(const std::string& fichier) const {
+        rafraichir();
+        reseauFige.sauvegarder(fichier, nomReseau);
+    }
+
+    /**
+    * \fn void chargerInstantane(const std::string& fichier)
+    * \brief Fonction servant à charger un réseau depuis un instantané binaire.  Le fichier est projeté en mémoire et
+    * devient l'instantané compact sur lequel se font les recherches; rien n'est copié ni alloué par trajet.  Le graphe
+    * modifiable est vidé et ne sera reconstruit que si le réseau doit changer (voir degeler).
+    * \param[in] fichier le chemin de l'instantané
+    * \exception logic_error si le fichier ne peut pas être lu ou n'est pas un instantané valide
+    */
+    void ReseauInterurbain::chargerInstantane(const std::string& fichier) {
+        auto debut = std::chrono::steady_clock::now();
+
+        std::string nom;
+        reseauFige = GrapheCompact::charger(fichier, nom);
+        etatInstantane.aJour = true;
+        nomReseau = std::move(nom);
+        unReseau = Graphe(0);
+        grapheAJour = false;
+        oublierPretraitements();
+        arreterSuiviComposantes();
+        arreterSuiviArbres();
+
+        statistiquesChargement = StatistiquesChargement();
+        statistiquesChargement.secondes = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+    }
+
+    /**
+    * \fn void degeler()
+    * \brief Fonction auxiliaire servant à reconstruire le graphe modifiable à partir de l'instantané, si celui-ci provient
+    * d'un fichier.  Appelée avant toute modification du réseau.
+    */
+    void ReseauInterurbain::degeler() {
+        if (grapheAJour) return;
+        unReseau = Graphe(reseauFige);
+        grapheAJour = true;
     }
 
     /**
     * \fn Chemin rechercheCheminDijkstra(const std::string& origine, const std::string& destination, bool dureeCout) const
-    * \brief Fonction servant à trouver les trajets les plus courts ou les moins coûteux en partant d'un sommet de départ vers une destination en utilisant l'agorithme de Dijkstra
+    * \brief Fonction servant à trouver les trajets les plus courts ou les moins coûteux en partant d'un sommet de départ vers une destination en utilisant l'agorithme de Dijkstra.
+    * Le cache des résultats, s'il est activé, est consulté dès que les noms sont résolus; un chemin calculé y est ensuite
+    * ajouté, estampillé par la version de l'instantané.  Si l'index d'atteignabilité est déjà construit (par estAtteignable
+    * ou sontAtteignables), il écarte ensuite les destinations hors d'atteinte, que le moteur n'aurait rejetées qu'après
+    * avoir résolu tout ce qu'atteint l'origine; la recherche ne le construit jamais elle-même, ce qui coûterait bien plus
+    * qu'elle après chaque ajout ou retrait de trajet.  Un chemin du cache est celui qu'a donné le moteur courant (le
+    * cache est vidé quand le moteur change).
     * \param[in] origine le sommet de départ du trajet
     * \param[in] destination le sommet de destination du trajet
     * \param[in] dureeCout booléen déterminant si la pondération à choisir doit être la durée ou le coût du trajet
@@ -112,83 +235,1096 @@ namespace TP2
     */
     Chemin ReseauInterurbain::rechercheCheminDijkstra(const std::string& origine, const std::string& destination, bool dureeCout) const
     {
-        if(!unReseau.sommetExiste(unReseau.getNumeroSommet(origine))) throw std::logic_error("ReseauInterurbain::rechercheCheminDijkstra : le sommet origine est invalide");
-        if(!unReseau.sommetExiste(unReseau.getNumeroSommet(destination))) throw std::logic_error("ReseauInterurbain::rechercheCheminDijkstra : le sommet destination est invalide");
+        rafraichir();
+        TP2_INSTRUMENTER(auto debutRecherche = std::chrono::steady_clock::now();)
+        StatistiquesRequete statistiques;
+
+        //Les noms sont résolus une seule fois, tout le reste de la recherche travaille sur les numéros de sommets
+        auto source = reseauFige.chercherSommet(origine);
+        auto cible = reseauFige.chercherSommet(destination);
+        if(source == reseauFige.taille()) throw std::logic_error("ReseauInterurbain::rechercheCheminDijkstra : le sommet origine est invalide");
+        if(cible == reseauFige.taille()) throw std::logic_error("ReseauInterurbain::rechercheCheminDijkstra : le sommet destination est invalide");
+
+        if (auto enCache = cacheResultats.trouver(source, cible, dureeCout, reseauFige.getVersion())) return *enCache;
+        auto index = std::atomic_load(&indexAtteignabilite);
+        const bool atteignable = !index || index->atteint(source, cible);
 
         Chemin cheminTrouve;
         //Initialisation de la struct cheminTrouve
         cheminTrouve.coutTotal = 0;
         cheminTrouve.dureeTotale = 0;
-        cheminTrouve.listeVilles.push_back(origine);
         cheminTrouve.reussi = false;
 
-        //Initialisation des vecteurs servant à retenir les informations
-        std::vector<size_t> nonResolus;
-        for (size_t i = 0; i < unReseau.taille(); ++i) {
-            nonResolus.push_back(i);
+        //La hiérarchie ne touche que les sommets qu'elle résout: pas de tableaux en O(V) par recherche
+        const auto& hierarchie = hierarchies[dureeCout ? 0 : 1];
+        if (!atteignable) {
+            //L'index prouve que la destination est hors d'atteinte: aucune recherche
+        }
+        else if (moteur == MoteurRecherche::Hierarchie && hierarchie.taille() == reseauFige.taille() && reseauFige.taille() > 0) {
+            float longueur;
+            construireCheminHierarchie(hierarchie.chercherChemin(source, cible, longueur, statistiques), dureeCout, cheminTrouve);
         }
+        else if (moteur == MoteurRecherche::Lineaire) {
+            //Les tableaux de travail de ce fil servent d'une recherche à l'autre, comme pour le moteur Tas
+            static thread_local EspaceRecherche espace;
+            dijkstraLineaire(source, espace, dureeCout, statistiques);
 
-        std::vector<std::string> listeVilles(unReseau.taille(), "");
-        std::vector<float> ponderations(unReseau.taille(), std::numeric_limits<float>::infinity());
-        ponderations.at(unReseau.getNumeroSommet(origine)) = 0;
+            //Mise à jour de la liste des villes, du booléen reussi et des totaux de la struct cheminTrouve
+            if (espace.atteint(cible))
+                construireChemin(source, cible, espace.predecesseurs, espace.arcsPrecedents, dureeCout, cheminTrouve);
+        }
+        else if (moteur == MoteurRecherche::Bidirectionnel) {
+            //Une paire de tableaux de travail par fil (avant et arrière), réutilisée d'une recherche à l'autre
+            static thread_local EspaceRecherche avant, arriere;
+            dijkstraBidirectionnel(source, cible, avant, arriere, dureeCout, statistiques);
+            if (avant.atteint(cible))
+                construireChemin(source, cible, avant.predecesseurs, avant.arcsPrecedents, dureeCout, cheminTrouve);
+        }
+        else {
+            //Tas et ALT: les tableaux de travail de ce fil servent d'une recherche à l'autre
+            static thread_local EspaceRecherche espace;
+            dijkstraTas(source, cible, moteur == MoteurRecherche::ALT && reperes.nombre() > 0, espace, dureeCout, statistiques);
+            if (espace.atteint(cible))
+                construireChemin(source, cible, espace.predecesseurs, espace.arcsPrecedents, dureeCout, cheminTrouve);
+        }
 
-        while (!nonResolus.empty()) {
+        TP2_INSTRUMENTER(
+            statistiques.secondes = std::chrono::duration<double>(std::chrono::steady_clock::now() - debutRecherche).count();
+            instrumentation.enregistrerRecherche(statistiques);
+        )
 
-            auto courant = localiserSommetMinimal(nonResolus, ponderations);
+        cacheResultats.ajouter(source, cible, dureeCout, reseauFige.getVersion(), cheminTrouve);
+        return cheminTrouve;
+    }
 
-            nonResolus.erase(std::find(nonResolus.begin(), nonResolus.end(),courant));
-            for (auto voisin: unReseau.listerSommetsAdjacents(courant)) {
-                relaxer(voisin, courant, ponderations, listeVilles, dureeCout);
-            }
+
+    /**
+    * \fn std::vector<Chemin> rechercheCheminsPareto(const std::string& origine, const std::string& destination, size_t limiteEtiquettes) const
+    * \brief Fonction servant à trouver les trajets Pareto-optimaux selon la durée et le coût par une seule recherche
+    * multicritère sur l'instantané (voir FrontPareto).  Comme pour rechercheCheminDijkstra, l'index d'atteignabilité
+    * n'est consulté que s'il est déjà construit.
+    * \param[in] origine le nom de la ville de départ
+    * \param[in] destination le nom de la ville d'arrivée
+    * \param[in] limiteEtiquettes le nombre maximal d'étiquettes fixées par ville, 0 pour un front exact
+    * \exception logic_error si origine et/ou destination absent du réseau
+    * \return std::vector<Chemin> les trajets par durée croissante (coût décroissant), chacun avec ses deux totaux
+    */
+    std::vector<Chemin> ReseauInterurbain::rechercheCheminsPareto(const std::string& origine, const std::string& destination, size_t limiteEtiquettes) const
+    {
+        rafraichir();
+        auto source = reseauFige.chercherSommet(origine);
+        auto cible = reseauFige.chercherSommet(destination);
+        if(source == reseauFige.taille()) throw std::logic_error("ReseauInterurbain::rechercheCheminsPareto : le sommet origine est invalide");
+        if(cible == reseauFige.taille()) throw std::logic_error("ReseauInterurbain::rechercheCheminsPareto : le sommet destination est invalide");
+        auto index = std::atomic_load(&indexAtteignabilite);
+        if (index && !index->atteint(source, cible)) return {};
+
+        FrontPareto front(reseauFige, source, cible, limiteEtiquettes);
+        std::vector<Chemin> chemins(front.taille());
+        for (size_t i = 0; i < front.taille(); ++i) {
+            for (auto sommet: front.sommets(i)) chemins[i].listeVilles.emplace_back(reseauFige.nom(sommet));
+            chemins[i].dureeTotale = front.duree(i);
+            chemins[i].coutTotal = front.cout(i);
+            chemins[i].reussi = true;
+        }
+        return chemins;
+    }
+
+    /**
+    * \fn std::shared_ptr<const ArbreChemins> arbreChemins(const std::string& origine, bool dureeCout) const
+    * \brief Fonction servant à obtenir l'arbre des plus courts chemins d'une origine: depuis le cache s'il s'y trouve, sinon
+    * repris d'un arbre suivi s'il l'est, sinon par un Dijkstra complet (ou par delta-stepping, selon le moteur choisi);
+    * l'arbre est ensuite mis en cache
+    * \param[in] origine le nom de la ville d'origine
+    * \param[in] dureeCout le critère: la durée si true, le coût sinon
+    * \exception logic_error si origine est absente du réseau
+    * \return std::shared_ptr<const ArbreChemins> l'arbre, partagé avec le cache
+    */
+    std::shared_ptr<const ArbreChemins> ReseauInterurbain::arbreChemins(const std::string& origine, bool dureeCout) const
+    {
+        rafraichir();
+        auto source = reseauFige.chercherSommet(origine);
+        if (source == reseauFige.taille()) throw std::logic_error("ReseauInterurbain::arbreChemins : le sommet origine est invalide");
+
+        auto arbre = cacheArbres.trouver(source, dureeCout);
+        if (arbre) return arbre;
+        auto suivi = suiviArbres ? arbresSuivis.trouver(source, dureeCout) : ArbresDynamiques::AUCUN;
+        if (suivi != ArbresDynamiques::AUCUN) {
+            arbre = std::make_shared<const ArbreChemins>(reseauFige, source, dureeCout, arbresSuivis.distances(suivi), arbresSuivis.predecesseurs(suivi));
+            cacheArbres.ajouter(arbre);
+            return arbre;
         }
+        if (moteurArbres == MoteurArbres::DeltaStepping) arbre = std::make_shared<const ArbreChemins>(reseauFige, source, dureeCout, nbFilsArbres);
+        else arbre = std::make_shared<const ArbreChemins>(reseauFige, source, dureeCout);
+        cacheArbres.ajouter(arbre);
+        return arbre;
+    }
 
-        //Mise à jour de la liste des villes de la struct cheminTrouve
-        cheminTrouve.listeVilles = construireChemin(origine, destination, listeVilles, cheminTrouve);
+    /**
+    * \fn bool estAtteignable(const std::string& origine, const std::string& destination) const
+    * \brief Fonction servant à savoir si une ville mène à une autre, par l'index d'atteignabilité
+    * \param[in] origine le nom de la ville de départ
+    * \param[in] destination le nom de la ville d'arrivée
+    * \exception logic_error si origine et/ou destination absent du réseau
+    * \return bool true si un trajet mène de origine à destination
+    */
+    bool ReseauInterurbain::estAtteignable(const std::string& origine, const std::string& destination) const
+    {
+        rafraichir();
+        auto source = reseauFige.chercherSommet(origine);
+        auto cible = reseauFige.chercherSommet(destination);
+        if(source == reseauFige.taille()) throw std::logic_error("ReseauInterurbain::estAtteignable : le sommet origine est invalide");
+        if(cible == reseauFige.taille()) throw std::logic_error("ReseauInterurbain::estAtteignable : le sommet destination est invalide");
+        return indexer()->atteint(source, cible);
+    }
 
-        //Mise à jour des floats dureeTotale et coutTotal
-        if (cheminTrouve.reussi)
-        {
-            for (int i = 0; i < cheminTrouve.listeVilles.size() - 1; ++i) {
-                if (dureeCout)
-                {
-                    cheminTrouve.dureeTotale += unReseau.getPonderationsArc(unReseau.getNumeroSommet(cheminTrouve.listeVilles[i]), unReseau.getNumeroSommet(cheminTrouve.listeVilles[i +1])).duree;
-                }
-                else{
-                    cheminTrouve.coutTotal += unReseau.getPonderationsArc(unReseau.getNumeroSommet(cheminTrouve.listeVilles[i]), unReseau.getNumeroSommet(cheminTrouve.listeVilles[i +1])).cout;
-                }
-            }
+    ReseauInterurbain::EquipeLots::EquipeLots() = default;
+
+    ReseauInterurbain::EquipeLots::~EquipeLots() = default;
+
+    /**
+    * \fn void repartirLot(size_t nbTaches, unsigned nbFils, Travail travail) const
+    * \brief Comme repartir, mais sur l'équipe de fils gardée d'un lot à l'autre (voir EquipeLots), créée ou refaite ici
+    * si elle n'a pas nombreFils(nbFils, ...) fils.  Si un autre lot occupe déjà l'équipe, les fils sont créés pour ce lot.
+    * \param[in] nbTaches le nombre de tâches
+    * \param[in] nbFils le nombre de fils d'exécution, 0 pour autant que de coeurs
+    * \param[in] travail la fonction travail(tache, fil), avec fil < nombreFils(nbFils, nbTaches)
+    * \exception la première exception levée par une tâche
+    */
+    template <typename Travail>
+    void ReseauInterurbain::repartirLot(size_t nbTaches, unsigned nbFils, Travail travail) const
+    {
+        nbFils = nombreFils(nbFils, std::numeric_limits<unsigned>::max());
+        std::unique_lock<std::mutex> garde(equipeLots.verrou, std::try_to_lock);
+        if (!garde.owns_lock() || nbFils == 1) {
+            repartir(nbTaches, nbFils, travail);
+            return;
+        }
+        auto& equipe = equipeLots.equipe;
+        if (!equipe || equipe->taille() != nbFils) {
+            equipe.reset();
+            equipe = std::make_unique<EquipeFils>(nbFils);
         }
+        equipe->repartir(nbTaches, travail);
+    }
 
-        return cheminTrouve;
+    /**
+    * \fn std::vector<bool> sontAtteignables(const std::vector<std::pair<std::string, std::string> >& paires, unsigned nbFils) const
+    * \brief Fonction servant à vérifier l'atteignabilité d'un lot de paires de villes.  Les noms sont tous résolus avant
+    * la première question; les questions sont ensuite réparties par vol de travail entre les fils d'exécution gardés d'un
+    * lot à l'autre (voir repartirLot).
+    * \param[in] paires les paires (origine, destination)
+    * \param[in] nbFils le nombre de fils d'exécution, 0 pour autant que de coeurs
+    * \exception logic_error si une origine ou une destination est absente du réseau
+    * \return std::vector<bool> la réponse de chaque paire, dans l'ordre des paires
+    */
+    std::vector<bool> ReseauInterurbain::sontAtteignables(const std::vector<std::pair<std::string, std::string> >& paires, unsigned nbFils) const
+    {
+        rafraichir();
+        std::vector<std::pair<size_t, size_t> > sommets;
+        sommets.reserve(paires.size());
+        for (const auto& paire: paires) {
+            sommets.emplace_back(reseauFige.chercherSommet(paire.first), reseauFige.chercherSommet(paire.second));
+            if (sommets.back().first == reseauFige.taille())
+                throw std::logic_error("ReseauInterurbain::sontAtteignables : l'origine " + paire.first + " est invalide");
+            if (sommets.back().second == reseauFige.taille())
+                throw std::logic_error("ReseauInterurbain::sontAtteignables : la destination " + paire.second + " est invalide");
+        }
+
+        auto index = indexer();
+        std::vector<char> reponses(paires.size(), 0);	// un octet par réponse: les fils n'écrivent pas dans le même mot
+        repartirLot(sommets.size(), nbFils, [&](size_t i, unsigned) {
+            reponses[i] = index->atteint(sommets[i].first, sommets[i].second);
+        });
+        return std::vector<bool>(reponses.begin(), reponses.end());
+    }
+
+    /**
+    * \fn void dimensionnerCacheArbres(size_t capacite)
+    * \brief Fonction servant à changer le nombre d'arbres gardés en cache par arbreChemins
+    * \param[in] capacite le nombre maximal d'arbres, 0 pour n'en garder aucun
+    */
+    void ReseauInterurbain::dimensionnerCacheArbres(size_t capacite) {
+        cacheArbres.dimensionner(capacite);
+    }
+
+    /**
+    * \fn void dimensionnerCacheResultats(size_t capacite)
+    * \brief Fonction servant à activer (capacite > 0), redimensionner ou désactiver (0) le cache des chemins trouvés par
+    * rechercheCheminDijkstra
+    * \param[in] capacite le nombre maximal de chemins gardés
+    */
+    void ReseauInterurbain::dimensionnerCacheResultats(size_t capacite) {
+        cacheResultats.dimensionner(capacite);
+    }
+
+    /**
+    * \fn StatistiquesCacheResultats getStatistiquesCacheResultats() const
+    * \brief Donne les compteurs du cache des résultats
+    * \return StatistiquesCacheResultats une copie des compteurs
+    */
+    StatistiquesCacheResultats ReseauInterurbain::getStatistiquesCacheResultats() const {
+        return cacheResultats.getStatistiques();
+    }
+
+    /**
+    * \fn void reinitialiserStatistiquesCacheResultats()
+    * \brief Remet les compteurs du cache des résultats à zéro
+    */
+    void ReseauInterurbain::reinitialiserStatistiquesCacheResultats() {
+        cacheResultats.reinitialiserStatistiques();
+    }
+
+    /**
+    * \fn std::vector<Chemin> rechercheCheminsLot(const std::vector<RequeteChemin>& requetes, unsigned nbFils) const
+    * \brief Fonction servant à exécuter un lot de recherches de chemin.  Les requêtes sont réparties par vol de travail
+    * entre des fils gardés d'un lot à l'autre (voir repartirLot).  Les tableaux de travail des moteurs sont thread_local:
+    * chaque fil garde les siens d'une requête et d'un lot à l'autre, et écrit son résultat à la place de sa requête.
+    * \param[in] requetes les recherches à faire
+    * \param[in] nbFils le nombre de fils d'exécution, 0 pour autant que de coeurs
+    * \exception logic_error si une origine ou une destination est absente du réseau
+    * \return std::vector<Chemin> le chemin de chaque requête, dans l'ordre des requêtes
+    */
+    std::vector<Chemin> ReseauInterurbain::rechercheCheminsLot(const std::vector<RequeteChemin>& requetes, unsigned nbFils) const
+    {
+        rafraichir();
+        std::vector<Chemin> chemins(requetes.size());
+        repartirLot(requetes.size(), nbFils, [&](size_t i, unsigned) {
+            chemins[i] = rechercheCheminDijkstra(requetes[i].origine, requetes[i].destination, requetes[i].dureeCout);
+        });
+        return chemins;
     }
 
+    /**
+    * \fn MatriceDistances matriceDistances(const std::vector<std::string>& origines, const std::vector<std::string>& destinations, bool durees, bool couts, unsigned nbFils) const
+    * \brief Fonction servant à calculer les durées et/ou les coûts minimaux entre toutes les paires origine-destination.
+    * Chaque critère demandé est calculé par la hiérarchie de contraction (par seaux) si elle est prête, sinon par un
+    * Dijkstra par origine qui s'arrête dès que toutes les destinations sont résolues.  Les origines sont alors réparties
+    * entre les fils d'exécution gardés d'un lot à l'autre (voir repartirLot), chacun avec ses propres tableaux de travail.
+    * \param[in] origines les villes de départ (une ligne par origine)
+    * \param[in] destinations les villes d'arrivée (une colonne par destination)
+    * \param[in] durees true pour calculer la matrice des durées
+    * \param[in] couts true pour calculer la matrice des coûts
+    * \param[in] nbFils le nombre de fils d'exécution, 0 pour autant que de coeurs
+    * \exception logic_error si une origine ou une destination est absente du réseau
+    * \return MatriceDistances les matrices demandées, ligne par origine
+    */
+    MatriceDistances ReseauInterurbain::matriceDistances(const std::vector<std::string>& origines, const std::vector<std::string>& destinations, bool durees, bool couts, unsigned nbFils) const
+    {
+        rafraichir();
+        auto resoudre = [this](const std::vector<std::string>& noms, const char* role) {
+            std::vector<size_t> sommets;
+            sommets.reserve(noms.size());
+            for (const auto& nom: noms) {
+                sommets.push_back(reseauFige.chercherSommet(nom));
+                if (sommets.back() == reseauFige.taille())
+                    throw std::logic_error(std::string("ReseauInterurbain::matriceDistances : ") + role + " " + nom + " est invalide");
+            }
+            return sommets;
+        };
+        auto sources = resoudre(origines, "l'origine");
+        auto cibles = resoudre(destinations, "la destination");
+
+        MatriceDistances matrice;
+        matrice.nbOrigines = sources.size();
+        matrice.nbDestinations = cibles.size();
+        if (sources.empty() || cibles.empty()) return matrice;
+
+        //Les destinations distinctes: la recherche d'une origine s'arrête quand elles sont toutes résolues
+        std::vector<bool> estCible(reseauFige.taille(), false);
+        size_t nbCibles = 0;
+        for (auto cible: cibles)
+            if (!estCible[cible]) {
+                estCible[cible] = true;
+                ++nbCibles;
+            }
+
+        auto calculer = [&](bool dureeCout) {
+            const auto& hierarchie = hierarchies[dureeCout ? 0 : 1];
+            if (hierarchie.taille() == reseauFige.taille()) return hierarchie.distances(sources, cibles, nbFils);
+
+            std::vector<float> resultat(sources.size() * cibles.size());
+            std::vector<std::vector<float> > ponderations(nombreFils(nbFils, sources.size()));
+            std::vector<std::vector<std::pair<float, size_t> > > tas(ponderations.size());
+            repartirLot(sources.size(), nbFils, [&](size_t i, unsigned fil) {
+                dijkstraCibles(sources[i], estCible, nbCibles, dureeCout, ponderations[fil], tas[fil]);
+                for (size_t j = 0; j < cibles.size(); ++j) resultat[i * cibles.size() + j] = ponderations[fil][cibles[j]];
+            });
+            return resultat;
+        };
+        if (durees) matrice.durees = calculer(true);
+        if (couts) matrice.couts = calculer(false);
+        return matrice;
+    }
 
     /**
    * \fn std::vector<std::vector<std::string> > algorithmeKosaraju()
-   * \brief Fonction servant à trouver et énumérer les composantes fortement connexes d'un graphe
+   * \brief Fonction servant à trouver et énumérer les composantes fortement connexes d'un graphe, avec le moteur choisi
+   * par choisirMoteurComposantes.  Avec TP2_INSTRUMENTATION, la durée de chaque phase est enregistrée (voir StatistiquesComposantes).
    * \return Un vecteur de vecteur de string représentant les composantes fortement connexes et leurs villes respectives
    */
 
     std::vector<std::vector<std::string> > ReseauInterurbain::algorithmeKosaraju()
     {
+        rafraichir();
+        if (moteurComposantes == MoteurComposantes::Kosaraju) return kosarajuRecursif() ;
+
+        TP2_INSTRUMENTER(
+            using Horloge = std::chrono::steady_clock;
+            StatistiquesComposantes statistiques;
+            auto debut = Horloge::now();
+        )
+        auto composantes = composantesFortementConnexes();
+        TP2_INSTRUMENTER(auto finTarjan = Horloge::now();)
+        auto noms = nommerComposantes(composantes);
+        TP2_INSTRUMENTER(
+            auto fin = Horloge::now();
+            statistiques.secondesPremierParcours = std::chrono::duration<double>(finTarjan - debut).count();
+            statistiques.secondesSecondParcours = std::chrono::duration<double>(fin - finTarjan).count();
+            statistiques.secondes = std::chrono::duration<double>(fin - debut).count();
+            statistiques.composantes = composantes.nombre;
+            instrumentation.enregistrerComposantes(statistiques);
+        )
+        return noms ;
+    }
+
+    //À compléter au besoin par d'autres méthodes
+
+    /**
+    * \fn void ajouterTrajet(const std::string& origine, const std::string& destination, float duree, float cout)
+    * \brief Fonction servant à ajouter un trajet au réseau.  Le graphe modifiable est reconstruit s'il le faut (voir
+    * degeler), l'instantané est périmé, et les composantes et les arbres suivis sont mis à jour (voir
+    * ComposantesDynamiques::ajouterArc et ArbresDynamiques::ajouterArc).
+    * \param[in] origine le nom de la ville de départ
+    * \param[in] destination le nom de la ville d'arrivée
+    * \param[in] duree la durée du trajet en heures
+    * \param[in] cout le coût du trajet en dollars
+    * \exception logic_error si origine et/ou destination absent du réseau
+    * \exception logic_error si le trajet existe déjà
+    */
+    void ReseauInterurbain::ajouterTrajet(const std::string& origine, const std::string& destination, float duree, float cout)
+    {
+        degeler();
+        auto source = unReseau.chercherSommet(origine);
+        auto cible = unReseau.chercherSommet(destination);
+        if (source == unReseau.taille()) throw std::logic_error("ReseauInterurbain::ajouterTrajet : le sommet origine est invalide");
+        if (cible == unReseau.taille()) throw std::logic_error("ReseauInterurbain::ajouterTrajet : le sommet destination est invalide");
+
+        unReseau.ajouterArc(source, cible, duree, cout);
+        if (suiviComposantes) composantesSuivies.ajouterArc(source, cible);
+        if (suiviArbres) arbresSuivis.ajouterArc(source, cible, duree, cout);
+        perimer();
+    }
+
+    /**
+    * \fn void enleverTrajet(const std::string& origine, const std::string& destination)
+    * \brief Fonction servant à retirer un trajet du réseau, comme ajouterTrajet.  Les composantes suivies ne sont
+    * recalculées que si le trajet était interne à une composante et que celle-ci se scinde.
+    * \param[in] origine le nom de la ville de départ
+    * \param[in] destination le nom de la ville d'arrivée
+    * \exception logic_error si origine et/ou destination absent du réseau
+    * \exception logic_error si le trajet n'existe pas
+    */
+    void ReseauInterurbain::enleverTrajet(const std::string& origine, const std::string& destination)
+    {
+        degeler();
+        auto source = unReseau.chercherSommet(origine);
+        auto cible = unReseau.chercherSommet(destination);
+        if (source == unReseau.taille()) throw std::logic_error("ReseauInterurbain::enleverTrajet : le sommet origine est invalide");
+        if (cible == unReseau.taille()) throw std::logic_error("ReseauInterurbain::enleverTrajet : le sommet destination est invalide");
+
+        unReseau.enleverArc(source, cible);
+        if (suiviComposantes) composantesSuivies.enleverArc(source, cible);
+        if (suiviArbres) arbresSuivis.enleverArc(source, cible);
+        perimer();
+    }
+
+    /**
+    * \fn void modifierPonderations(const std::string& origine, const std::string& destination, float duree, float cout)
+    * \brief Fonction servant à changer la durée et le coût d'un trajet sur place (voir Graphe::modifierPonderations).
+    * Les arbres suivis sont réparés (voir ArbresDynamiques::modifierPonderations).  Un instantané à jour n'est pas refait:
+    * ses pondérations sont changées sur place (voir GrapheCompact::modifierPonderations).  L'index d'atteignabilité et
+    * les composantes suivies, qui ne dépendent que des arcs, sont gardés; les autres prétraitements sont oubliés.
+    * \param[in] origine le nom de la ville de départ
+    * \param[in] destination le nom de la ville d'arrivée
+    * \param[in] duree la nouvelle durée du trajet en heures
+    * \param[in] cout le nouveau coût du trajet en dollars
+    * \exception logic_error si origine et/ou destination absent du réseau
+    * \exception logic_error si le trajet n'existe pas
+    */
+    void ReseauInterurbain::modifierPonderations(const std::string& origine, const std::string& destination, float duree, float cout)
+    {
+        degeler();
+        auto source = unReseau.chercherSommet(origine);
+        auto cible = unReseau.chercherSommet(destination);
+        if (source == unReseau.taille()) throw std::logic_error("ReseauInterurbain::modifierPonderations : le sommet origine est invalide");
+        if (cible == unReseau.taille()) throw std::logic_error("ReseauInterurbain::modifierPonderations : le sommet destination est invalide");
+
+        unReseau.modifierPonderations(source, cible, duree, cout);
+        if (suiviArbres) arbresSuivis.modifierPonderations(source, cible, duree, cout);
+        if (etatInstantane.aJour.load(std::memory_order_acquire)) {
+            oublierPretraitements(false);	// avant: les arbres en cache partagent les pondérations de l'instantané
+            reseauFige.modifierPonderations(source, cible, duree, cout);
+        }
+        else perimer(false);
+    }
+
+    /**
+    * \fn const ComposantesDynamiques& composantesDynamiques()
+    * \brief Fonction servant à obtenir les composantes fortement connexes suivies.  Au premier appel (ou après un
+    * chargement), elles sont calculées sur l'instantané, puis tenues à jour par ajouterTrajet et enleverTrajet.
+    * \return const ComposantesDynamiques& les composantes, indexées par numéro de ville
+    */
+    const ComposantesDynamiques& ReseauInterurbain::composantesDynamiques()
+    {
+        if (!suiviComposantes) {
+            rafraichir();
+            composantesSuivies = ComposantesDynamiques(reseauFige);
+            suiviComposantes = true;
+        }
+        return composantesSuivies;
+    }
+
+    /**
+    * \fn bool mutuellementAtteignables(const std::string& villeA, const std::string& villeB)
+    * \brief Fonction servant à savoir si deux villes sont dans la même composante fortement connexe, par les composantes
+    * suivies (voir composantesDynamiques)
+    * \param[in] villeA le nom de la première ville
+    * \param[in] villeB le nom de la seconde ville
+    * \exception logic_error si villeA et/ou villeB absent du réseau
+    * \return bool true si chaque ville est atteignable depuis l'autre
+    */
+    bool ReseauInterurbain::mutuellementAtteignables(const std::string& villeA, const std::string& villeB)
+    {
+        auto a = chercherVille(villeA);
+        auto b = chercherVille(villeB);
+        if (a == AUCUN_SOMMET) throw std::logic_error("ReseauInterurbain::mutuellementAtteignables : le sommet villeA est invalide");
+        if (b == AUCUN_SOMMET) throw std::logic_error("ReseauInterurbain::mutuellementAtteignables : le sommet villeB est invalide");
+        return composantesDynamiques().memeComposante(a, b);
+    }
+
+    /**
+    * \fn void suivreArbreChemins(const std::string& origine, bool dureeCout)
+    * \brief Fonction servant à suivre l'arbre des plus courts chemins d'une origine.  Au premier appel (ou après un
+    * chargement), les arcs de l'instantané sont copiés dans les arbres suivis; l'arbre est ensuite calculé une fois, puis
+    * réparé par chaque modification du réseau.
+    * \param[in] origine le nom de la ville d'origine
+    * \param[in] dureeCout le critère: la durée si true, le coût sinon
+    * \exception logic_error si origine est absente du réseau
+    */
+    void ReseauInterurbain::suivreArbreChemins(const std::string& origine, bool dureeCout)
+    {
+        auto source = chercherVille(origine);
+        if (source == AUCUN_SOMMET) throw std::logic_error("ReseauInterurbain::suivreArbreChemins : le sommet origine est invalide");
+        if (!suiviArbres) {
+            rafraichir();
+            arbresSuivis = ArbresDynamiques(reseauFige);
+            suiviArbres = true;
+        }
+        arbresSuivis.suivre(source, dureeCout);
+    }
+
+    /**
+    * \fn const ArbresDynamiques& arbresDynamiques() const
+    * \brief Donne les arbres suivis
+    * \return const ArbresDynamiques& les arbres, vides si aucun n'est suivi
+    */
+    const ArbresDynamiques& ReseauInterurbain::arbresDynamiques() const
+    {
+        return arbresSuivis;
+    }
+
+    /**
+   * \fn std::vector<std::vector<std::string> > kosarajuRecursif()
+   * \brief Algorithme de Kosaraju d'origine: un parcours en profondeur du graphe inverse donne l'ordre d'abandon, puis un
+   * second parcours du graphe dans cet ordre donne une composante par arbre.
+   * \return Un vecteur de vecteur de string représentant les composantes fortement connexes et leurs villes respectives
+   */
+    std::vector<std::vector<std::string> > ReseauInterurbain::kosarajuRecursif()
+    {
+        TP2_INSTRUMENTER(
+            using Horloge = std::chrono::steady_clock;
+            StatistiquesComposantes statistiques;
+            auto debut = Horloge::now();
+        )
         std::vector<std::vector<std::string> > composantes;
-        std::stack<std::string> pile = exploreRecursifGrapheDFS(unReseau.grapheInverse()) ;
+        auto inverse = reseauFige.inverse() ;
+        TP2_INSTRUMENTER(auto finTransposition = Horloge::now();)
+        std::stack<std::string> pile = explorerGrapheDFS(inverse) ;
+        TP2_INSTRUMENTER(auto finPremierParcours = Horloge::now();)
 
-        InfoDFS data(unReseau) ;
+        InfoDFS data(reseauFige) ;
         while (!pile.empty()) {
             std::string depart = pile.top() ;
             pile.pop() ;
 
-            if (!data.visites.at(unReseau.getNumeroSommet(depart))) {
-                auxExploreRecursifDFS(data, unReseau.getNumeroSommet(depart)) ;
+            if (!data.visites.at(reseauFige.chercherSommet(depart))) {
+                auxExploreRecursifDFS(data, reseauFige.chercherSommet(depart)) ;
                 composantes.push_back(transfererPileVersVecteur(data.abandonnes)) ;
             }
         }
 
+        TP2_INSTRUMENTER(
+            auto fin = Horloge::now();
+            statistiques.secondesTransposition = std::chrono::duration<double>(finTransposition - debut).count();
+            statistiques.secondesPremierParcours = std::chrono::duration<double>(finPremierParcours - finTransposition).count();
+            statistiques.secondesSecondParcours = std::chrono::duration<double>(fin - finPremierParcours).count();
+            statistiques.secondes = std::chrono::duration<double>(fin - debut).count();
+            statistiques.composantes = composantes.size();
+            instrumentation.enregistrerComposantes(statistiques);
+        )
         return composantes ;
     }
 
-    //À compléter au besoin par d'autres méthodes
+    /**
+    * \fn void choisirMoteurComposantes(MoteurComposantes nouveauMoteur, unsigned nbFils)
+    * \brief Fonction servant à choisir le moteur utilisé par algorithmeKosaraju
+    * \param[in] nouveauMoteur le moteur à utiliser
+    * \param[in] nbFils le nombre de fils d'exécution du moteur Parallele, 0 pour autant que de coeurs
+    */
+    void ReseauInterurbain::choisirMoteurComposantes(MoteurComposantes nouveauMoteur, unsigned nbFils) {
+        moteurComposantes = nouveauMoteur;
+        nbFilsComposantes = nbFils;
+    }
+
+    /**
+    * \fn void choisirMoteurArbres(MoteurArbres nouveauMoteur, unsigned nbFils)
+    * \brief Fonction servant à choisir le moteur utilisé par arbreChemins.  Le cache des arbres est vidé: les arbres déjà
+    * calculés ont les mêmes distances, mais pas toujours les mêmes prédécesseurs.
+    * \param[in] nouveauMoteur le moteur à utiliser
+    * \param[in] nbFils le nombre de fils d'exécution du moteur DeltaStepping, 0 pour autant que de coeurs
+    */
+    void ReseauInterurbain::choisirMoteurArbres(MoteurArbres nouveauMoteur, unsigned nbFils) {
+        moteurArbres = nouveauMoteur;
+        nbFilsArbres = nbFils;
+        cacheArbres.vider();
+    }
+
+    /**
+    * \fn MoteurArbres getMoteurArbres() const
+    * \brief Donne le moteur utilisé par arbreChemins
+    * \return MoteurArbres le moteur courant
+    */
+    MoteurArbres ReseauInterurbain::getMoteurArbres() const {
+        return moteurArbres;
+    }
+
+    /**
+    * \fn MoteurComposantes getMoteurComposantes() const
+    * \brief Donne le moteur utilisé par algorithmeKosaraju
+    * \return MoteurComposantes le moteur courant
+    */
+    MoteurComposantes ReseauInterurbain::getMoteurComposantes() const {
+        return moteurComposantes;
+    }
+
+    /**
+    * \fn Composantes composantesFortementConnexes() const
+    * \brief Fonction servant à trouver les composantes fortement connexes du réseau avec l'algorithme de Tarjan itératif,
+    * sur l'instantané compact, ou avec le moteur Parallele s'il est choisi.  Si les composantes sont suivies (voir
+    * composantesDynamiques), elles sont seulement renumérotées, en O(V).
+    * \return Composantes le numéro de composante de chaque ville, en ordre topologique inverse
+    */
+    Composantes ReseauInterurbain::composantesFortementConnexes() const {
+        if (suiviComposantes) return composantesSuivies.numeroter();
+        rafraichir();
+        if (moteurComposantes == MoteurComposantes::Parallele) return composantesParalleles(reseauFige, nbFilsComposantes);
+        return reseauFige.composantesFortementConnexes();
+    }
+
+    /**
+    * \fn std::vector<std::vector<std::string> > nommerComposantes(const Composantes& composantes) const
+    * \brief Fonction servant à donner les noms des villes de chaque composante.  Les composantes sont données par numéro,
+    * soit en ordre topologique inverse comme le faisait Kosaraju, et les villes d'une composante par numéro de sommet croissant.
+    * \param[in] composantes les composantes à nommer
+    * \return Un vecteur de vecteur de string représentant les composantes et leurs villes respectives
+    */
+    std::vector<std::vector<std::string> > ReseauInterurbain::nommerComposantes(const Composantes& composantes) const {
+        rafraichir();
+        std::vector<std::vector<std::string> > noms(composantes.nombre);
+
+        for (size_t sommet = 0; sommet < composantes.numeros.size(); ++sommet)
+            noms[composantes.numeros[sommet]].emplace_back(reseauFige.nom(sommet));
+
+        return noms;
+    }
+
+    /**
+    * \fn void choisirMoteur(MoteurRecherche nouveauMoteur)
+    * \brief Fonction servant à choisir le moteur utilisé par rechercheCheminDijkstra
+    * \param[in] nouveauMoteur le moteur à utiliser
+    */
+    void ReseauInterurbain::choisirMoteur(MoteurRecherche nouveauMoteur) {
+        if (nouveauMoteur != moteur) cacheResultats.vider();
+        moteur = nouveauMoteur;
+    }
+
+    /**
+    * \fn MoteurRecherche getMoteur() const
+    * \brief Donne le moteur utilisé par rechercheCheminDijkstra
+    * \return MoteurRecherche le moteur courant
+    */
+    MoteurRecherche ReseauInterurbain::getMoteur() const {
+        return moteur;
+    }
+
+    /**
+    * \fn void dijkstraLineaire(size_t source, EspaceRecherche& espace, bool dureeCout, StatistiquesRequete& statistiques) const
+    * \brief Fonction auxiliaire utilisée dans Dijkstra.  Version d'origine: le prochain sommet à résoudre est trouvé par un
+    * balayage linéaire des non-résolus et tout ce que la source atteint est résolu, peu importe la destination.  O(V²).
+    * Les voisins sont lus dans l'instantané compact, dans l'ordre des listes d'adjacence.
+    * Les tableaux sont ceux de espace, remis à zéro par estampilles: les non-résolus balayés sont les sommets déjà
+    * atteints, gardés en ordre de numéro pour briser les égalités comme le balayage de tous les sommets.
+    * \param[in] source le sommet de départ, dont la pondération est mise à 0
+    * \param[in,out] espace les tableaux de travail; au retour, le chemin se remonte par espace.predecesseurs depuis tout
+    * sommet atteint
+    * \param[in] dureeCout le booléen décidant si la pondération à utiliser est la durée ou le coût
+    * \param[out] statistiques les compteurs de la recherche (TP2_INSTRUMENTATION)
+    */
+    void ReseauInterurbain::dijkstraLineaire(size_t source, EspaceRecherche& espace, bool dureeCout, [[maybe_unused]] StatistiquesRequete& statistiques) const {
+        if (espace.preparer(reseauFige.taille())) {
+            TP2_INSTRUMENTER(++statistiques.allocations;)
+        }
+        espace.atteints[source] = espace.generation;
+        espace.ponderations[source] = 0;
+        espace.predecesseurs[source] = AUCUN_SOMMET;
+        espace.arcsPrecedents[source] = Ponderations();
+        std::vector<size_t> nonResolus{source};
+        TP2_INSTRUMENTER(++statistiques.allocations;)
+
+        while (!nonResolus.empty()) {
+
+            auto courant = localiserSommetMinimal(nonResolus, espace.ponderations);
+
+            nonResolus.erase(std::find(nonResolus.begin(), nonResolus.end(),courant));
+            TP2_INSTRUMENTER(++statistiques.sommetsResolus;)
+            for (auto arc = reseauFige.debutArcs(courant); arc < reseauFige.finArcs(courant); ++arc) {
+                TP2_INSTRUMENTER(++statistiques.arcsExamines;)
+                auto voisin = reseauFige.destination(arc);
+                if (!espace.atteint(voisin)) {
+                    espace.atteints[voisin] = espace.generation;
+                    espace.ponderations[voisin] = std::numeric_limits<float>::infinity();
+                    espace.predecesseurs[voisin] = AUCUN_SOMMET;
+                    nonResolus.insert(std::lower_bound(nonResolus.begin(), nonResolus.end(), voisin), voisin);
+                }
+                if (relaxer(voisin, courant, reseauFige.getPonderations(arc), espace.ponderations, espace.predecesseurs, espace.arcsPrecedents, dureeCout)) {
+                    TP2_INSTRUMENTER(++statistiques.relaxationsReussies;)
+                }
+            }
+        }
+    }
+
+    /**
+    * \fn void dijkstraBidirectionnel(size_t source, size_t cible, EspaceRecherche& avant, EspaceRecherche& arriere, bool dureeCout, StatistiquesRequete& statistiques) const
+    * \brief Fonction auxiliaire utilisée dans Dijkstra.  Deux recherches sont menées en alternance: vers l'avant depuis la
+    * source sur les arcs sortants de l'instantané, et vers l'arrière depuis la cible sur ses arcs entrants.  La direction
+    * dont le tas est le plus petit avance d'un sommet.  Chaque arc examiné dont l'extrémité est déjà atteinte par l'autre
+    * recherche propose un chemin; le meilleur est retenu, et la recherche s'arrête dès que la somme des minimums des deux
+    * tas atteint sa longueur, car aucun chemin plus court ne peut plus être trouvé.
+    * Le chemin vers l'arrière est ensuite greffé aux prédécesseurs de la recherche avant, pour que construireChemin le
+    * remonte comme un chemin de la recherche simple.  La longueur trouvée est la même que celle de dijkstraTas; si
+    * plusieurs chemins ont exactement la même longueur, les villes retenues peuvent différer.
+    *
+    * Les tableaux sont ceux de avant et arriere, remis à zéro par estampilles comme dans dijkstraTas: seuls les sommets
+    * atteints par l'une ou l'autre direction coûtent quelque chose.
+    * \param[in] source le sommet de départ
+    * \param[in] cible le sommet de destination
+    * \param[in,out] avant les tableaux de la recherche depuis la source; au retour, le chemin se remonte par
+    * avant.predecesseurs si la cible est atteinte
+    * \param[in,out] arriere les tableaux de la recherche depuis la cible (predecesseurs y donne le successeur de chaque sommet)
+    * \param[in] dureeCout le booléen décidant si la pondération à utiliser est la durée ou le coût
+    * \param[out] statistiques les compteurs de la recherche (TP2_INSTRUMENTATION)
+    */
+    void ReseauInterurbain::dijkstraBidirectionnel(size_t source, size_t cible, EspaceRecherche& avant, EspaceRecherche& arriere, bool dureeCout, [[maybe_unused]] StatistiquesRequete& statistiques) const {
+        using Entree = std::pair<float, size_t>;
+        const std::greater<Entree> priorite;
+        const float INFINI = std::numeric_limits<float>::infinity();
+
+        if (avant.preparer(reseauFige.taille())) {
+            TP2_INSTRUMENTER(++statistiques.allocations;)
+        }
+        if (arriere.preparer(reseauFige.taille())) {
+            TP2_INSTRUMENTER(++statistiques.allocations;)
+        }
+
+        auto atteindre = [&](EspaceRecherche& espace, size_t sommet, float ponderation, size_t predecesseur, const Ponderations& arc) {
+            espace.atteints[sommet] = espace.generation;
+            espace.ponderations[sommet] = ponderation;
+            espace.predecesseurs[sommet] = predecesseur;
+            espace.arcsPrecedents[sommet] = arc;
+            TP2_INSTRUMENTER(++statistiques.insertionsTas; statistiques.allocations += espace.tas.size() == espace.tas.capacity();)
+            espace.tas.emplace_back(ponderation, sommet);
+            std::push_heap(espace.tas.begin(), espace.tas.end(), priorite);
+        };
+
+        atteindre(avant, source, 0, AUCUN_SOMMET, Ponderations());
+        if (source == cible) return;
+        atteindre(arriere, cible, 0, AUCUN_SOMMET, Ponderations());
+
+        float meilleur = INFINI;
+        size_t rencontre = AUCUN_SOMMET;
+        auto proposer = [&](size_t sommet) {
+            if (!avant.atteint(sommet) || !arriere.atteint(sommet)) return;
+            if (avant.ponderations[sommet] + arriere.ponderations[sommet] < meilleur) {
+                meilleur = avant.ponderations[sommet] + arriere.ponderations[sommet];
+                rencontre = sommet;
+            }
+        };
+
+        while (!avant.tas.empty() && !arriere.tas.empty() && avant.tas.front().first + arriere.tas.front().first < meilleur) {
+            bool versAvant = avant.tas.size() <= arriere.tas.size();
+            auto& espace = versAvant ? avant : arriere;
+
+            std::pop_heap(espace.tas.begin(), espace.tas.end(), priorite);
+            auto courant = espace.tas.back().second;
+            espace.tas.pop_back();
+            TP2_INSTRUMENTER(++statistiques.retraitsTas;)
+
+            if (espace.resolu(courant)) continue;
+            espace.resolus[courant] = espace.generation;
+            TP2_INSTRUMENTER(++statistiques.sommetsResolus;)
+
+            auto debut = versAvant ? reseauFige.debutArcs(courant) : reseauFige.debutArcsEntrants(courant);
+            auto fin = versAvant ? reseauFige.finArcs(courant) : reseauFige.finArcsEntrants(courant);
+            for (auto arc = debut; arc < fin; ++arc) {
+                auto voisin = versAvant ? reseauFige.destination(arc) : reseauFige.source(arc);
+                if (espace.resolu(voisin)) continue;
+
+                TP2_INSTRUMENTER(++statistiques.arcsExamines;)
+                const auto& ponderationsArc = versAvant ? reseauFige.getPonderations(arc) : reseauFige.getPonderationsEntrant(arc);
+                float ponderation = espace.ponderations[courant] + (dureeCout ? ponderationsArc.duree : ponderationsArc.cout);
+                if (!espace.atteint(voisin) || ponderation < espace.ponderations[voisin]) {
+                    TP2_INSTRUMENTER(++statistiques.relaxationsReussies;)
+                    atteindre(espace, voisin, ponderation, courant, ponderationsArc);
+                    proposer(voisin);
+                }
+            }
+        }
+        if (rencontre == AUCUN_SOMMET) return;
+
+        //Greffe du chemin arrière (rencontre -> cible) au chemin avant (source -> rencontre).  Avec des pondérations nulles,
+        //le chemin arrière peut repasser par un sommet du chemin avant: on part alors du dernier de ces sommets.
+        const auto& successeurs = arriere.predecesseurs;
+        std::vector<size_t> cheminAvant;
+        for (auto sommet = rencontre; sommet != AUCUN_SOMMET; sommet = avant.predecesseurs[sommet]) {
+            cheminAvant.push_back(sommet);
+            if (sommet == source) break;
+        }
+        std::sort(cheminAvant.begin(), cheminAvant.end());
+
+        auto greffe = rencontre;
+        for (auto sommet = rencontre; sommet != cible; sommet = successeurs[sommet])
+            if (std::binary_search(cheminAvant.begin(), cheminAvant.end(), successeurs[sommet])) greffe = successeurs[sommet];
+
+        for (auto sommet = greffe; sommet != cible; sommet = successeurs[sommet]) {
+            auto suivant = successeurs[sommet];
+            const auto& arc = arriere.arcsPrecedents[sommet];
+            avant.atteints[suivant] = avant.generation;
+            avant.predecesseurs[suivant] = sommet;
+            avant.arcsPrecedents[suivant] = arc;
+            avant.ponderations[suivant] = avant.ponderations[sommet] + (dureeCout ? arc.duree : arc.cout);
+        }
+    }
+
+    /**
+    * \fn void dijkstraTas(size_t source, size_t cible, bool guide, EspaceRecherche& espace, bool dureeCout, StatistiquesRequete& statistiques) const
+    * \brief Fonction auxiliaire utilisée dans Dijkstra.  Les sommets sont résolus à partir d'une file de priorité (tas binaire
+    * sur un vecteur, par std::push_heap et std::pop_heap) avec suppression paresseuse: un sommet peut apparaître plusieurs fois
+    * dans le tas, seules les entrées dont il n'est pas encore résolu sont traitées.  La recherche s'arrête dès que la cible
+    * est résolue.  O((V + E) log V).  Les voisins sont lus dans l'instantané compact du réseau.
+    * Les égalités sont brisées par le plus petit numéro de sommet, comme dans localiserSommetMinimal.
+    *
+    * Guidée (moteur ALT), c'est une recherche A*: le tas est ordonné par la pondération depuis la source plus une borne
+    * inférieure de la pondération restante jusqu'à la cible, donnée par les repères.  Les sommets dont la borne est infinie
+    * ne peuvent pas atteindre la cible et ne sont jamais insérés.  Les bornes calculées en float peuvent dépasser la vraie
+    * distance d'un arrondi: elles sont réduites d'un facteur 1 - 1e-5, et un sommet déjà résolu dont la pondération
+    * s'améliore encore est rouvert.  La cible est résolue avec la même pondération que sans guide; si plusieurs chemins ont
+    * exactement la même longueur, les villes retenues peuvent différer.
+    *
+    * Les tableaux sont ceux de espace, remis à zéro par estampilles: seuls les sommets atteints coûtent quelque chose.
+    * \param[in] source le sommet de départ
+    * \param[in] cible le sommet de destination
+    * \param[in] guide true pour guider la recherche par les bornes des repères
+    * \param[in,out] espace les tableaux de travail; au retour, le chemin se remonte par espace.predecesseurs si la cible est atteinte
+    * \param[in] dureeCout le booléen décidant si la pondération à utiliser est la durée ou le coût
+    * \param[out] statistiques les compteurs de la recherche (TP2_INSTRUMENTATION)
+    */
+    void ReseauInterurbain::dijkstraTas(size_t source, size_t cible, bool guide, EspaceRecherche& espace, bool dureeCout, [[maybe_unused]] StatistiquesRequete& statistiques) const {
+        using Entree = std::pair<float, size_t>;
+        const std::greater<Entree> priorite;
+        const float INFINI = std::numeric_limits<float>::infinity();
+        const float REDUCTION = 1 - 1e-5f;
+
+        if (espace.preparer(reseauFige.taille())) {
+            TP2_INSTRUMENTER(++statistiques.allocations;)
+        }
+        auto& tas = espace.tas;
+
+        auto atteindre = [&](size_t sommet, float ponderation, size_t predecesseur, const Ponderations& arc) {
+            if (!espace.atteint(sommet)) {
+                espace.atteints[sommet] = espace.generation;
+                espace.bornes[sommet] = guide ? reperes.borne(sommet, cible, dureeCout) * REDUCTION : 0;
+            }
+            espace.ponderations[sommet] = ponderation;
+            espace.predecesseurs[sommet] = predecesseur;
+            espace.arcsPrecedents[sommet] = arc;
+            espace.resolus[sommet] = 0;
+            if (espace.bornes[sommet] == INFINI) return;
+            TP2_INSTRUMENTER(++statistiques.insertionsTas; statistiques.allocations += tas.size() == tas.capacity();)
+            tas.emplace_back(ponderation + espace.bornes[sommet], sommet);
+            std::push_heap(tas.begin(), tas.end(), priorite);
+        };
+
+        atteindre(source, 0, AUCUN_SOMMET, Ponderations());
+        while (!tas.empty()) {
+            std::pop_heap(tas.begin(), tas.end(), priorite);
+            auto courant = tas.back().second;
+            tas.pop_back();
+            TP2_INSTRUMENTER(++statistiques.retraitsTas;)
+
+            if (espace.resolu(courant)) continue;
+            espace.resolus[courant] = espace.generation;
+            TP2_INSTRUMENTER(++statistiques.sommetsResolus;)
+            if (courant == cible) break;
+
+            for (auto arc = reseauFige.debutArcs(courant); arc < reseauFige.finArcs(courant); ++arc) {
+                auto voisin = reseauFige.destination(arc);
+                if (!guide && espace.resolu(voisin)) continue;
+
+                TP2_INSTRUMENTER(++statistiques.arcsExamines;)
+                float ponderation = espace.ponderations[courant] + reseauFige.poids(arc, dureeCout);
+                if (!espace.atteint(voisin) || ponderation < espace.ponderations[voisin]) {
+                    TP2_INSTRUMENTER(++statistiques.relaxationsReussies;)
+                    atteindre(voisin, ponderation, courant, reseauFige.getPonderations(arc));
+                }
+            }
+        }
+    }
+
+    /**
+    * \fn bool EspaceRecherche::preparer(size_t taille)
+    * \brief Commence une nouvelle recherche: les tableaux sont agrandis au besoin, puis la génération avance.  Quand elle
+    * fait le tour (2^32 recherches), les estampilles sont remises à zéro.
+    * \param[in] taille le nombre de sommets du graphe
+    * \return true si les tableaux ont été agrandis
+    */
+    bool ReseauInterurbain::EspaceRecherche::preparer(size_t taille) {
+        bool agrandi = atteints.size() < taille;
+        if (agrandi) {
+            ponderations.resize(taille);
+            bornes.resize(taille);
+            predecesseurs.resize(taille);
+            arcsPrecedents.resize(taille);
+            atteints.assign(taille, 0);
+            resolus.assign(taille, 0);
+            generation = 0;
+        }
+        if (++generation == 0) {
+            std::fill(atteints.begin(), atteints.end(), 0);
+            std::fill(resolus.begin(), resolus.end(), 0);
+            generation = 1;
+        }
+        tas.clear();
+        return agrandi;
+    }
+
+    /**
+    * \fn void dijkstraCibles(size_t source, const std::vector<bool>& estCible, size_t nbCibles, bool dureeCout, std::vector<float>& ponderations, std::vector<std::pair<float, size_t> >& tas) const
+    * \brief Dijkstra à une source et plusieurs cibles (tas binaire, suppression paresseuse), qui s'arrête dès que les
+    * nbCibles cibles sont résolues.  Les tableaux sont fournis par l'appelant pour être réutilisés d'une source à l'autre.
+    * \param[in] source le sommet de départ
+    * \param[in] estCible true pour chaque sommet cible
+    * \param[in] nbCibles le nombre de cibles
+    * \param[in] dureeCout le critère
+    * \param[out] ponderations les distances depuis source, exactes pour les cibles, infinies pour les sommets non atteints
+    * \param[out] tas la file de priorité, réutilisée
+    */
+    void ReseauInterurbain::dijkstraCibles(size_t source, const std::vector<bool>& estCible, size_t nbCibles, bool dureeCout, std::vector<float>& ponderations, std::vector<std::pair<float, size_t> >& tas) const {
+        const std::greater<std::pair<float, size_t> > priorite;
+        ponderations.assign(reseauFige.taille(), std::numeric_limits<float>::infinity());
+        tas.clear();
+        ponderations[source] = 0;
+        tas.emplace_back(0.f, source);
+
+        while (!tas.empty() && nbCibles > 0) {
+            std::pop_heap(tas.begin(), tas.end(), priorite);
+            auto entree = tas.back();
+            tas.pop_back();
+            if (entree.first > ponderations[entree.second]) continue;
+            if (estCible[entree.second]) --nbCibles;
+
+            for (auto arc = reseauFige.debutArcs(entree.second); arc < reseauFige.finArcs(entree.second); ++arc) {
+                auto voisin = reseauFige.destination(arc);
+                float distance = entree.first + reseauFige.poids(arc, dureeCout);
+                if (distance < ponderations[voisin]) {
+                    ponderations[voisin] = distance;
+                    tas.emplace_back(distance, voisin);
+                    std::push_heap(tas.begin(), tas.end(), priorite);
+                }
+            }
+        }
+    }
+
+    /**
+    * \fn void preparerReperes(size_t nbReperes, unsigned nbFils)
+    * \brief Fonction servant à préparer le moteur ALT: choix des repères et calcul de leurs tables (voir Reperes::preparer)
+    * \param[in] nbReperes le nombre de repères
+    * \param[in] nbFils le nombre de fils d'exécution, 0 pour autant que de coeurs
+    */
+    void ReseauInterurbain::preparerReperes(size_t nbReperes, unsigned nbFils) {
+        rafraichir();
+        reperes = Reperes::preparer(reseauFige, nbReperes, nbFils);
+    }
+
+    /**
+    * \fn const Reperes& getReperes() const
+    * \brief Donne les repères courants
+    * \return const Reperes& les repères, vides s'ils n'ont pas été préparés
+    */
+    const Reperes& ReseauInterurbain::getReperes() const {
+        return reperes;
+    }
+
+    /**
+    * \fn void sauvegarderReperes(const std::string& fichier) const
+    * \brief Fonction servant à écrire les repères courants dans un fichier
+    * \param[in] fichier le chemin du fichier
+    * \exception logic_error si le fichier ne peut pas être écrit
+    */
+    void ReseauInterurbain::sauvegarderReperes(const std::string& fichier) const {
+        reperes.sauvegarder(fichier);
+    }
+
+    /**
+    * \fn void chargerReperes(const std::string& fichier)
+    * \brief Fonction servant à relire des repères.  Ils doivent avoir été calculés pour un réseau de mêmes trajets et de
+    * mêmes pondérations: l'empreinte de l'instantané (GrapheCompact::empreinte) est comparée à celle du fichier.
+    * \param[in] fichier le chemin du fichier
+    * \exception logic_error si le fichier est invalide ou ne correspond pas au réseau
+    */
+    void ReseauInterurbain::chargerReperes(const std::string& fichier) {
+        rafraichir();
+        auto relus = Reperes::charger(fichier);
+        if (relus.taille() != reseauFige.taille() || relus.getNombreArcs() != reseauFige.getNombreArcs()
+            || relus.getEmpreinte() != reseauFige.empreinte())
+            throw std::logic_error("ReseauInterurbain::chargerReperes : les repères ont été calculés pour un autre réseau");
+        reperes = std::move(relus);
+    }
+
+    /**
+    * \fn void preparerHierarchies()
+    * \brief Fonction servant à préparer le moteur Hierarchie: une hiérarchie de contraction par critère, la seconde
+    * construite dans un autre fil d'exécution
+    */
+    void ReseauInterurbain::preparerHierarchies() {
+        rafraichir();
+        std::thread fil([this]() { hierarchies[1] = HierarchieContraction(reseauFige, false); });
+        try {
+            hierarchies[0] = HierarchieContraction(reseauFige, true);
+        }
+        catch (...) {
+            fil.join();
+            throw;
+        }
+        fil.join();
+    }
+
+    /**
+    * \fn const HierarchieContraction& getHierarchie(bool dureeCout) const
+    * \brief Donne la hiérarchie d'un critère
+    * \param[in] dureeCout la durée si true, le coût sinon
+    * \return const HierarchieContraction& la hiérarchie, vide si elle n'a pas été préparée
+    */
+    const HierarchieContraction& ReseauInterurbain::getHierarchie(bool dureeCout) const {
+        return hierarchies[dureeCout ? 0 : 1];
+    }
+
+    /**
+    * \fn void oublierPretraitements(bool topologie)
+    * \brief Fonction auxiliaire servant à oublier les repères, les hiérarchies, l'index d'atteignabilité et les arbres en
+    * cache quand le réseau change
+    * \param[in] topologie false si seules des pondérations ont changé: l'index d'atteignabilité est alors gardé
+    */
+    void ReseauInterurbain::oublierPretraitements(bool topologie) {
+        reperes = Reperes();
+        if (topologie) std::atomic_store(&indexAtteignabilite, std::shared_ptr<const IndexAtteignabilite>());
+        cacheArbres.vider();
+        hierarchies[0] = HierarchieContraction();
+        hierarchies[1] = HierarchieContraction();
+    }
+
+    /**
+    * \fn void rafraichir() const
+    * \brief Fonction auxiliaire servant à refaire l'instantané s'il a été périmé par une modification du réseau.  Appelée
+    * au début de chaque fonction qui lit l'instantané; un seul fil le refait, les autres attendent sur le verrou.
+    */
+    void ReseauInterurbain::rafraichir() const {
+        if (etatInstantane.aJour.load(std::memory_order_acquire)) return;
+        std::lock_guard<std::mutex> garde(etatInstantane.verrou);
+        if (etatInstantane.aJour.load(std::memory_order_relaxed)) return;
+        reseauFige = unReseau.figer();
+        etatInstantane.aJour.store(true, std::memory_order_release);
+    }
+
+    /**
+    * \fn std::shared_ptr<const IndexAtteignabilite> indexer() const
+    * \brief Fonction auxiliaire servant à obtenir l'index d'atteignabilité de reseauFige, construit par le premier fil
+    * qui le demande (sous le verrou de l'instantané) puis partagé.  L'instantané doit être à jour (voir rafraichir).
+    * \return std::shared_ptr<const IndexAtteignabilite> l'index
+    */
+    std::shared_ptr<const IndexAtteignabilite> ReseauInterurbain::indexer() const {
+        auto index = std::atomic_load(&indexAtteignabilite);
+        if (index) return index;
+        std::lock_guard<std::mutex> garde(etatInstantane.verrou);
+        index = std::atomic_load(&indexAtteignabilite);
+        if (!index) {
+            index = std::make_shared<const IndexAtteignabilite>(reseauFige);
+            std::atomic_store(&indexAtteignabilite, index);
+        }
+        return index;
+    }
+
+    /**
+    * \fn void perimer(bool topologie)
+    * \brief Fonction auxiliaire servant à noter que unReseau a changé: l'instantané sera refait par la prochaine recherche
+    * et les prétraitements de l'ancien réseau sont oubliés.  Le cache des résultats n'est pas vidé, ses chemins sont
+    * estampillés par la version du réseau.
+    * \param[in] topologie false si seules des pondérations ont changé (voir oublierPretraitements)
+    */
+    void ReseauInterurbain::perimer(bool topologie) {
+        etatInstantane.aJour.store(false, std::memory_order_release);
+        oublierPretraitements(topologie);
+    }
+
+    /**
+    * \fn void arreterSuiviComposantes()
+    * \brief Fonction auxiliaire servant à abandonner les composantes suivies quand le réseau est remplacé
+    */
+    void ReseauInterurbain::arreterSuiviComposantes() {
+        composantesSuivies = ComposantesDynamiques();
+        suiviComposantes = false;
+    }
+
+    /**
+    * \fn void arreterSuiviArbres()
+    * \brief Fonction auxiliaire servant à abandonner les arbres suivis quand le réseau est remplacé
+    */
+    void ReseauInterurbain::arreterSuiviArbres() {
+        arbresSuivis = ArbresDynamiques();
+        suiviArbres = false;
+    }
+
+    /**
+    * \fn size_t chercherVille(const std::string& nom) const
+    * \brief Fonction auxiliaire servant à trouver le numéro d'une ville sans refaire l'instantané: les modifications
+    * passent par unReseau, et l'instantané est à jour tant que unReseau n'a pas été reconstruit
+    * \param[in] nom le nom de la ville
+    * \return size_t le numéro de la ville, ou AUCUN_SOMMET si elle est absente
+    */
+    size_t ReseauInterurbain::chercherVille(const std::string& nom) const {
+        auto numero = grapheAJour ? unReseau.chercherSommet(nom) : reseauFige.chercherSommet(nom);
+        return numero == (grapheAJour ? unReseau.taille() : reseauFige.taille()) ? AUCUN_SOMMET : numero;
+    }
 
     /**
     * \fn  size_t localiserSommetMinimal(std::vector<size_t>& nonResolus, std::vector<float>& ponderations) const
@@ -213,30 +1349,27 @@ namespace TP2
     }
 
     /**
-    * \fn  void relaxer(size_t voisin, size_t courant, std::vector<float>& ponderations, std::vector<std::string>& listeVilles, bool dureeCout) const
+    * \fn  bool relaxer(size_t voisin, size_t courant, const Ponderations& arc, std::vector<float>& ponderations, std::vector<size_t>& predecesseurs, std::vector<Ponderations>& arcsPrecedents, bool dureeCout) const
     * \brief Fonction auxiliaire utilisée dans Dijkstra.  Elle relaxe le noeud voisin à partir du noeud courant
     * \param[in] voisin le sommet voisin à relaxer
     * \param[in] courant le sommet courant
+    * \param[in] arc les pondérations de l'arc courant -> voisin
     * \param[in] ponderations le vecteur contenant les pondérations
-    * \param[in] listeVilles le vecteur contenant les villes précédant le voisin
+    * \param[in] predecesseurs le vecteur contenant le prédécesseur de chaque sommet
+    * \param[in] arcsPrecedents le vecteur contenant les pondérations de l'arc menant à chaque sommet depuis son prédécesseur
     * \param[in] dureeCout le booléen décidant si la pondération à utiliser est la distance ou le coût
+    * \return true si la pondération du voisin a été améliorée
     */
-    void ReseauInterurbain::relaxer(size_t voisin, size_t courant, std::vector<float>& ponderations, std::vector<std::string>& listeVilles, bool dureeCout) const{
-        float temp;
-
-        if(dureeCout)
-        {
-            temp = ponderations.at(courant) + unReseau.getPonderationsArc(courant, voisin).duree ;
-        }
-        else
-        {
-            temp = ponderations.at(courant) + unReseau.getPonderationsArc(courant, voisin).cout ;
-        }
+    bool ReseauInterurbain::relaxer(size_t voisin, size_t courant, const Ponderations& arc, std::vector<float>& ponderations, std::vector<size_t>& predecesseurs, std::vector<Ponderations>& arcsPrecedents, bool dureeCout) const{
+        float temp = ponderations.at(courant) + (dureeCout ? arc.duree : arc.cout);
 
         if (temp < ponderations.at(voisin)) {
             ponderations.at(voisin) = temp ;
-            listeVilles.at(voisin) = unReseau.getNomSommet(courant);
+            predecesseurs.at(voisin) = courant;
+            arcsPrecedents.at(voisin) = arc;
+            return true;
         }
+        return false;
     }
 
     /**
@@ -247,6 +1380,16 @@ namespace TP2
     * premier à sortir de la pile.
     */
     std::stack<std::string> ReseauInterurbain::exploreRecursifGrapheDFS(const Graphe &graphe) {
+        return explorerGrapheDFS(graphe.figer()) ;
+    }
+
+    /**
+    * \fn  std::stack<std::string> explorerGrapheDFS(const GrapheCompact &graphe)
+    * \brief Effectue une visite en profondeur d'un graphe compact
+    * \param[in] graphe Le graphe à visiter
+    * \return Une pile contenant les noeuds dans l'ordre où ils ont été abandonnés.
+    */
+    std::stack<std::string> ReseauInterurbain::explorerGrapheDFS(const GrapheCompact &graphe) {
         InfoDFS donneesDfs(graphe) ;
 
         for (size_t depart = 0; depart < graphe.taille(); ++depart)
@@ -258,18 +1401,20 @@ namespace TP2
     /**
     * \fn  void auxExploreRecursifDFS(InfoDFS& donneesDFS, size_t depart)
     * \brief Explore un graphe en profondeur à partir d'une sommet donné.
-    * \param[in] donneesDFS struct InfoDFS contenant le graphe à explorer, une pile qui recevra les noeuds abandonnées et un vecteur
-    * de bool indiquant quels noeuds ont été visités.  Voir Graphe_algorithme.h pour une description complète.
+    * \param[in] donneesDFS struct InfoDFS contenant le graphe compact à explorer, une pile qui recevra les noeuds abandonnées et un vecteur
+    * de bool indiquant quels noeuds ont été visités.
     * \param[in] depart Le numéro du sommet de départ à explorer.
     */
     void ReseauInterurbain::auxExploreRecursifDFS(InfoDFS& donneesDFS, size_t depart) {
         if (donneesDFS.visites.at(depart)) return ;
 
         donneesDFS.visites.at(depart) = true ;
-        for (const auto& voisin: donneesDFS.graphe.listerSommetsAdjacents(depart))
+        for (auto arc = donneesDFS.graphe.debutArcs(depart); arc < donneesDFS.graphe.finArcs(depart); ++arc) {
+            auto voisin = donneesDFS.graphe.destination(arc) ;
             if (!donneesDFS.visites.at(voisin)) auxExploreRecursifDFS(donneesDFS, voisin) ;
+        }
 
-        donneesDFS.abandonnes.push(unReseau.getNomSommet(depart)) ;
+        donneesDFS.abandonnes.emplace(reseauFige.nom(depart)) ;
 
     }
 
@@ -291,24 +1436,66 @@ namespace TP2
     }
 
     /**
-     * \fn td::vector<std::string> construireChemin(const std::string& source, const std::string& destination, std::vector<std::string> predecesseurs, Chemin& cheminTrouve) const
-     * \brief Construit le chemin entre deux villes à partir d'un vecteur de std::string contenant les prédécesseurs des sommets.
+    * \fn std::vector<std::vector<std::string> > triTopologiqueComposantes() const
+    * \brief Fonction servant à ordonner les composantes fortement connexes du réseau: le réseau est condensé (une ville
+    * par composante, graphe acyclique) puis le graphe condensé est trié topologiquement.  Toute ville d'une composante ne
+    * peut atteindre que des villes de sa composante ou des composantes suivantes.  Si le réseau provient d'un instantané,
+    * la condensation se fait sur une reconstruction temporaire du graphe.
+    * \return Un vecteur de vecteur de string représentant les composantes en ordre topologique et leurs villes respectives
+    */
+    std::vector<std::vector<std::string> > ReseauInterurbain::triTopologiqueComposantes() const {
+        rafraichir();
+        auto composantes = composantesFortementConnexes();
+        auto noms = nommerComposantes(composantes);
+
+        std::vector<std::vector<std::string> > ordre;
+        ordre.reserve(composantes.nombre);
+        auto condense = grapheAJour ? unReseau.condensation(composantes) : Graphe(reseauFige).condensation(composantes);
+        for (auto c: condense.triTopologique())
+            ordre.push_back(std::move(noms[c]));
+
+        return ordre;
+    }
+
+    /**
+    * \fn BilanInstrumentation getInstrumentation() const
+    * \brief Donne une copie cohérente des statistiques accumulées par les recherches depuis la dernière remise à zéro
+    * \return BilanInstrumentation les cumuls, les dernières mesures et les histogrammes de latence
+    */
+    BilanInstrumentation ReseauInterurbain::getInstrumentation() const {
+        return instrumentation.instantane();
+    }
+
+    /**
+    * \fn void reinitialiserInstrumentation()
+    * \brief Remet à zéro les statistiques des recherches
+    */
+    void ReseauInterurbain::reinitialiserInstrumentation() {
+        instrumentation.reinitialiser();
+    }
+
+    /**
+     * \fn void construireChemin(size_t source, size_t destination, const std::vector<size_t>& predecesseurs, const std::vector<Ponderations>& arcsPrecedents, bool dureeCout, Chemin& cheminTrouve) const
+     * \brief Construit le chemin entre deux villes en remontant le vecteur des prédécesseurs depuis la destination.  Le total
+     * est calculé à partir des pondérations retenues lors des relaxations, dans l'ordre du trajet, et les noms des villes ne
+     * sont résolus qu'une fois le trajet connu.
      * \param[in] source le sommet de départ du trajet. Sert à déterminer si le chemin est possible ou non
      * \param[in] destination le sommet de destination
-     * \param[in] predecesseurs le vecteur de std::string contenant les prédécesseurs
-     * \param[in] cheminTrouve la struct Chemin afin de mettre à jour son booléen réussi si le chemin a été trouvé
-     * \return std::vector<std::string> le vecteur contenant les villes du trajet
+     * \param[in] predecesseurs le vecteur contenant le prédécesseur de chaque sommet
+     * \param[in] arcsPrecedents le vecteur contenant les pondérations de l'arc menant à chaque sommet depuis son prédécesseur
+     * \param[in] dureeCout le booléen décidant si le total à calculer est la durée ou le coût
+     * \param[out] cheminTrouve la struct Chemin dont la liste des villes, le booléen réussi et le total sont mis à jour
      */
-    std::vector<std::string> ReseauInterurbain::construireChemin(const std::string& source, const std::string& destination, std::vector<std::string> predecesseurs, Chemin& cheminTrouve) const {
+    void ReseauInterurbain::construireChemin(size_t source, size_t destination, const std::vector<size_t>& predecesseurs, const std::vector<Ponderations>& arcsPrecedents, bool dureeCout, Chemin& cheminTrouve) const {
 
-        std::vector<std::string> trajet;
+        std::vector<size_t> trajet;
 
-        auto courant = unReseau.getNumeroSommet(destination);
-        while(predecesseurs[courant] != "")
+        auto courant = destination;
+        while(predecesseurs[courant] != AUCUN_SOMMET)
         {
-            trajet.push_back(unReseau.getNomSommet(courant));
-            courant = unReseau.getNumeroSommet(predecesseurs[courant]);
-            if (unReseau.getNomSommet(courant) == source)
+            trajet.push_back(courant);
+            courant = predecesseurs[courant];
+            if (courant == source)
             {
                 cheminTrouve.reussi = true;
                 trajet.push_back(source);
@@ -316,7 +1503,41 @@ namespace TP2
         }
 
         std::reverse(trajet.begin(), trajet.end());
-        return trajet;
+
+        cheminTrouve.listeVilles.clear();
+        if (!cheminTrouve.reussi) return;
+
+        cheminTrouve.listeVilles.reserve(trajet.size());
+        cheminTrouve.listeVilles.emplace_back(reseauFige.nom(trajet.front()));
+        for (size_t i = 1; i < trajet.size(); ++i) {
+            if (dureeCout) cheminTrouve.dureeTotale += arcsPrecedents[trajet[i]].duree;
+            else cheminTrouve.coutTotal += arcsPrecedents[trajet[i]].cout;
+            cheminTrouve.listeVilles.emplace_back(reseauFige.nom(trajet[i]));
+        }
+    }
+
+    /**
+     * \fn void construireCheminHierarchie(const std::vector<size_t>& trajet, bool dureeCout, Chemin& cheminTrouve) const
+     * \brief Construit le chemin à partir des sommets donnés par une hiérarchie de contraction.  Les raccourcis étant déjà
+     * dépliés, deux sommets consécutifs sont reliés par un trajet du réseau, dont la pondération est relue dans l'instantané.
+     * \param[in] trajet les sommets du chemin, vide si aucun chemin
+     * \param[in] dureeCout le booléen décidant si le total à calculer est la durée ou le coût
+     * \param[out] cheminTrouve la struct Chemin dont la liste des villes, le booléen réussi et le total sont mis à jour
+     */
+    void ReseauInterurbain::construireCheminHierarchie(const std::vector<size_t>& trajet, bool dureeCout, Chemin& cheminTrouve) const {
+        cheminTrouve.listeVilles.clear();
+        cheminTrouve.reussi = !trajet.empty();
+        if (!cheminTrouve.reussi) return;
+
+        cheminTrouve.listeVilles.reserve(trajet.size());
+        cheminTrouve.listeVilles.emplace_back(reseauFige.nom(trajet.front()));
+        for (size_t i = 1; i < trajet.size(); ++i) {
+            auto arc = reseauFige.debutArcs(trajet[i - 1]);
+            while (reseauFige.destination(arc) != trajet[i]) ++arc;
+            if (dureeCout) cheminTrouve.dureeTotale += reseauFige.getPonderations(arc).duree;
+            else cheminTrouve.coutTotal += reseauFige.getPonderations(arc).cout;
+            cheminTrouve.listeVilles.emplace_back(reseauFige.nom(trajet[i]));
+        }
     }
 
 }//Fin du namespace
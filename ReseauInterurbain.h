@@ -10,6 +10,18 @@
  */
 
 #include "Graphe.h"
+#include "GrapheCompact.h"
+#include "Instrumentation.h"
+#include "Reperes.h"
+#include "HierarchieContraction.h"
+#include "ArbreChemins.h"
+#include "CacheResultats.h"
+#include "FrontPareto.h"
+#include "ComposantesDynamiques.h"
+#include "IndexAtteignabilite.h"
+#include "ComposantesParalleles.h"
+#include "DeltaStepping.h"
+#include "ArbresDynamiques.h"
 #include <iostream>
 #include <string>
 #include <stdexcept>
@@ -17,6 +29,14 @@
 #include <vector>
 #include <list>
 #include <stack>
+#include <queue>
+#include <limits>
+#include <functional>
+#include <cstdint>
+#include <utility>
+#include <atomic>
+#include <memory>
+#include <mutex>
 //vous pouvez inclure d'autres librairies de la STL si vous pensez les utiliser
 
 
@@ -26,6 +46,8 @@
 namespace TP2
 {
 
+class EquipeFils;	// voir Parallele.h
+
 struct Chemin 
 {
    //listeVilles doit contenir la liste des villes formant le chemin
@@ -38,6 +60,81 @@ struct Chemin
    bool reussi;				// Un booléen qui vaut true si le chemin a été trouvé, false sinon
 };
 
+/**
+ * \struct RequeteChemin
+ * \brief Une recherche de chemin d'un lot (voir rechercheCheminsLot)
+ */
+struct RequeteChemin
+{
+   std::string origine;
+   std::string destination;
+   bool dureeCout = true;			// true: la durée comme pondération, false: le coût
+};
+
+/**
+ * \struct MatriceDistances
+ * \brief Les durées et les coûts des plus courts chemins de chaque origine à chaque destination.  Chaque tableau compte
+ *  nbOrigines lignes de nbDestinations cases, contiguës (ligne par origine); il est vide si ce critère n'a pas été
+ *  demandé.  Une destination non atteignable vaut l'infini, l'origine elle-même vaut 0.
+ */
+struct MatriceDistances
+{
+   size_t nbOrigines = 0;
+   size_t nbDestinations = 0;
+   std::vector<float> durees;		// Durée minimale de chaque trajet, en heures
+   std::vector<float> couts;		// Coût minimal de chaque trajet, en dollars (indépendant des durées)
+
+   float duree(size_t origine, size_t destination) const { return durees[origine * nbDestinations + destination]; }
+   float cout(size_t origine, size_t destination) const { return couts[origine * nbDestinations + destination]; }
+};
+
+/**
+ * \struct StatistiquesChargement
+ * \brief Le volume et le débit du dernier chargement d'un réseau
+ */
+struct StatistiquesChargement
+{
+   size_t lignes = 0;					// Le nombre de lignes lues
+   size_t octets = 0;					// La taille du fichier lu
+   double secondes = 0;				// La durée du chargement (lecture, analyse, construction du graphe)
+   double lignesParSeconde = 0;
+   double megaoctetsParSeconde = 0;	// Débit en Mo/s (10^6 octets)
+};
+
+/**
+ * \enum MoteurRecherche
+ * \brief Le moteur utilisé par rechercheCheminDijkstra pour résoudre les sommets
+ */
+enum class MoteurRecherche
+{
+   Tas,			// File de priorité (tas binaire) avec arrêt dès que la destination est résolue
+   Lineaire,		// Balayage linéaire des non-résolus, résout tout le graphe (version d'origine)
+   Bidirectionnel,	// Deux tas: vers l'avant depuis l'origine et vers l'arrière depuis la destination, jusqu'à leur rencontre
+   ALT,			// A* guidé par les bornes des repères (voir preparerReperes); Tas si aucun repère n'est prêt
+   Hierarchie		// Hiérarchie de contraction du critère (voir preparerHierarchies); Tas si elle n'est pas prête
+};
+
+/**
+ * \enum MoteurComposantes
+ * \brief Le moteur utilisé par algorithmeKosaraju pour trouver les composantes fortement connexes
+ */
+enum class MoteurComposantes
+{
+   Tarjan,		// Une seule passe itérative sur les numéros de sommets (GrapheCompact::composantesFortementConnexes)
+   Kosaraju,		// Deux parcours en profondeur récursifs, sur le graphe inverse puis sur le graphe (version d'origine)
+   Parallele		// Élagage puis avant-arrière sur plusieurs fils d'exécution (voir composantesParalleles)
+};
+
+/**
+ * \enum MoteurArbres
+ * \brief Le moteur utilisé par arbreChemins pour calculer les plus courts chemins d'une origine vers toutes les villes
+ */
+enum class MoteurArbres
+{
+   Dijkstra,		// Dijkstra complet sur un tas binaire, un seul fil d'exécution
+   DeltaStepping	// Seaux de largeur delta relâchés sur plusieurs fils d'exécution (voir deltaStepping); mêmes distances
+};
+
 class ReseauInterurbain{
 
 public:
@@ -64,50 +161,327 @@ public:
 	// fichierEntree n'est pas fermé par la fonction.
 	// Exception logic_error si fichierEntree n'est pas ouvert correctement.
 	void chargerReseau(std::ifstream & fichierEntree); 
+
+	// Retourne le volume et le débit du dernier chargement
+	StatistiquesChargement getStatistiquesChargement() const;
+
+	// Écrit le réseau (nom, villes, trajets) dans un instantané binaire (voir le format dans GrapheCompact.h)
+	// Exception logic_error si le fichier ne peut pas être écrit
+	void sauvegarderInstantane(const std::string& fichier) const;
+
+	// Charge un réseau depuis un instantané binaire écrit par sauvegarderInstantane. Le fichier est projeté en mémoire
+	// et les recherches le lisent sur place: le chargement ne copie rien, il ne fait qu'une passe de validation.
+	// Le graphe modifiable n'est reconstruit qu'au besoin (resize); d'ici là, operator<< affiche un réseau vide.
+	// Exception logic_error si le fichier ne peut pas être lu ou n'est pas un instantané valide
+	void chargerInstantane(const std::string& fichier);
                      
 	// Trouve le plus court chemin entre une ville source et une ville destination en utilisant l'algorithme de Dijkstra
 	// si dureeCout = true, on utilise la durée comme pondération au niveau des trajets
 	// si dureeCout = false, on utilise le coût (en $) comme pondération au niveau des trajets
+	// Si le cache des résultats est activé (voir dimensionnerCacheResultats), un chemin déjà trouvé sur la même version
+	// du réseau est servi sans nouvelle recherche. Si l'index d'atteignabilité est déjà construit (voir estAtteignable),
+	// une destination hors d'atteinte est rejetée sans recherche; la recherche ne construit pas l'index elle-même.
 	// Exception std::logic_error si origine et/ou destination absent du réseau
 	Chemin rechercheCheminDijkstra(const std::string& origine, const std::string& destination, bool dureeCout) const;
 
+	// Trouve, en une seule recherche, les trajets Pareto-optimaux (durée, coût) entre deux villes (voir FrontPareto):
+	// par durée croissante et coût décroissant, le premier est le plus rapide et le dernier le moins cher. Chaque chemin
+	// a ses deux totaux remplis. Au plus limiteEtiquettes étiquettes sont fixées par ville (0: aucune limite, front exact).
+	// Retourne un vecteur vide si destination n'est pas atteignable ou est l'origine.
+	// Exception std::logic_error si origine et/ou destination absent du réseau
+	std::vector<Chemin> rechercheCheminsPareto(const std::string& origine, const std::string& destination, size_t limiteEtiquettes = 0) const;
+
+	// Retourne true si destination est atteignable depuis origine (toujours vrai si origine == destination). L'index
+	// d'atteignabilité (voir IndexAtteignabilite) est construit à la première question, puis oublié dès que le réseau change.
+	// Exception std::logic_error si origine et/ou destination absent du réseau
+	bool estAtteignable(const std::string& origine, const std::string& destination) const;
+
+	// Répond à estAtteignable pour chaque paire (origine, destination), sur nbFils fils d'exécution (0: autant que de
+	// coeurs). Les réponses sont dans l'ordre des paires.
+	// Exception std::logic_error si une origine ou une destination est absente du réseau
+	std::vector<bool> sontAtteignables(const std::vector<std::pair<std::string, std::string> >& paires, unsigned nbFils = 0) const;
+
+	// Change le nombre de chemins gardés en cache par rechercheCheminDijkstra (0 par défaut: pas de cache). Les chemins
+	// les moins récemment demandés sont évincés; un chemin calculé sur une autre version du réseau n'est jamais servi.
+	void dimensionnerCacheResultats(size_t capacite);
+
+	// Retourne les compteurs du cache des résultats (succès, échecs, périmés, évictions), ou les remet à zéro
+	StatistiquesCacheResultats getStatistiquesCacheResultats() const;
+	void reinitialiserStatistiquesCacheResultats();
+
+	// Retourne l'arbre des plus courts chemins depuis origine pour la durée (dureeCout = true) ou le coût. Les arbres
+	// récemment demandés sont gardés en cache (voir dimensionnerCacheArbres): redemander le même arbre ne coûte rien.
+	// L'arbre est calculé par le moteur choisi par choisirMoteurArbres (Dijkstra par défaut), ou repris des arbres
+	// suivis (voir suivreArbreChemins) sans aucune recherche.
+	// Le cache est vidé dès que le réseau change; un arbre déjà obtenu reste valide pour l'ancien réseau.
+	// Exception std::logic_error si origine est absente du réseau
+	std::shared_ptr<const ArbreChemins> arbreChemins(const std::string& origine, bool dureeCout) const;
+
+	// Change le nombre d'arbres gardés en cache par arbreChemins (8 par défaut, 0 pour aucun)
+	void dimensionnerCacheArbres(size_t capacite);
+
+	// Choisit le moteur utilisé par arbreChemins (MoteurArbres::Dijkstra par défaut), et pour le moteur DeltaStepping son
+	// nombre de fils d'exécution (0: autant que de coeurs). Les arbres en cache sont oubliés.
+	void choisirMoteurArbres(MoteurArbres nouveauMoteur, unsigned nbFils = 0);
+
+	MoteurArbres getMoteurArbres() const;
+
+	// Exécute un lot de recherches de chemin (comme rechercheCheminDijkstra, avec le moteur courant) sur nbFils fils
+	// d'exécution (0: autant que de coeurs), par vol de travail. Les fils sont gardés d'un lot à l'autre, et chacun
+	// réutilise ses tableaux de travail d'une recherche et d'un lot à l'autre. Les chemins sont retournés dans l'ordre
+	// des requêtes.
+	// Exception std::logic_error si une origine ou une destination est absente du réseau
+	std::vector<Chemin> rechercheCheminsLot(const std::vector<RequeteChemin>& requetes, unsigned nbFils = 0) const;
+
+	// Calcule les matrices des durées (si durees) et des coûts (si couts) minimaux de chaque origine à chaque destination,
+	// par une recherche par origine (par seaux sur la hiérarchie du critère si elle est prête), réparties sur nbFils fils
+	// d'exécution (0: autant que de coeurs)
+	// Exception std::logic_error si une origine ou une destination est absente du réseau
+	MatriceDistances matriceDistances(const std::vector<std::string>& origines, const std::vector<std::string>& destinations,
+	                                  bool durees = true, bool couts = true, unsigned nbFils = 0) const;
+
 	// Trouve l’ensemble des composantes fortement connexes en utilisant l'algorithme de Kosaraju
 	// Retourne un vecteur de vecteurs de chaînes caractères. Chaque sous-vecteur représente une composante.
+	// Le calcul est délégué au moteur choisi par choisirMoteurComposantes (Tarjan par défaut).
 	std::vector<std::vector<std::string> > algorithmeKosaraju();
 
+	// Ajoute un trajet entre deux villes. Les recherches suivantes voient le réseau modifié: l'instantané est refait au
+	// besoin, une seule fois pour une suite de modifications. Les repères, les hiérarchies et les arbres en cache sont
+	// oubliés. Si les composantes sont suivies (voir composantesDynamiques), elles sont mises à jour sans recalcul, de
+	// même que les arbres suivis (voir suivreArbreChemins).
+	// Exception std::logic_error si origine et/ou destination absent du réseau
+	// Exception std::logic_error si le trajet existe déjà
+	void ajouterTrajet(const std::string& origine, const std::string& destination, float duree, float cout);
+
+	// Retire un trajet entre deux villes, comme ajouterTrajet
+	// Exception std::logic_error si origine et/ou destination absent du réseau
+	// Exception std::logic_error si le trajet n'existe pas
+	void enleverTrajet(const std::string& origine, const std::string& destination);
+
+	// Change la durée et le coût d'un trajet, sur place. La topologie ne change pas: l'index d'atteignabilité et les
+	// composantes sont gardés, et l'instantané n'est pas refait (ses pondérations sont changées sur place). Les arbres
+	// suivis sont réparés sur leur seul sous-arbre touché.
+	// Exception std::logic_error si origine et/ou destination absent du réseau
+	// Exception std::logic_error si le trajet n'existe pas
+	void modifierPonderations(const std::string& origine, const std::string& destination, float duree, float cout);
+
+	// Retourne les composantes fortement connexes tenues à jour par ajouterTrajet et enleverTrajet (voir
+	// ComposantesDynamiques). Elles sont calculées au premier appel, puis suivies jusqu'au prochain chargement ou resize;
+	// d'ici là, composantesFortementConnexes et algorithmeKosaraju (moteur Tarjan) les lisent au lieu de recalculer.
+	const ComposantesDynamiques& composantesDynamiques();
+
+	// Retourne true si chacune des deux villes est atteignable depuis l'autre, en O(1) une fois les composantes suivies
+	// Exception std::logic_error si villeA et/ou villeB absent du réseau
+	bool mutuellementAtteignables(const std::string& villeA, const std::string& villeB);
+
+	// Suit l'arbre des plus courts chemins de origine pour la durée (dureeCout = true) ou le coût (voir ArbresDynamiques):
+	// il est calculé une fois, puis réparé par ajouterTrajet, enleverTrajet et modifierPonderations au lieu d'être
+	// oublié, et arbreChemins le sert ensuite sans recherche. À réserver à quelques villes pivots: chaque arbre suivi
+	// coûte O(V) en mémoire et chaque modification les répare tous. Les arbres sont suivis jusqu'au prochain
+	// chargement ou resize.
+	// Exception std::logic_error si origine est absente du réseau
+	void suivreArbreChemins(const std::string& origine, bool dureeCout);
+
+	// Retourne les arbres suivis (aucun si suivreArbreChemins n'a pas été appelé)
+	const ArbresDynamiques& arbresDynamiques() const;
+
 	//Vous pouvez ajoutez d'autres méthodes publiques si vous sentez leur nécessité
 
     std::stack<std::string> exploreRecursifGrapheDFS(const Graphe &graphe);
 
+    // Choisit le moteur utilisé par rechercheCheminDijkstra (MoteurRecherche::Tas par défaut)
+    void choisirMoteur(MoteurRecherche nouveauMoteur);
+
+    MoteurRecherche getMoteur() const;
+
+    // Choisit le moteur utilisé par algorithmeKosaraju (MoteurComposantes::Tarjan par défaut), et pour le moteur
+    // Parallele son nombre de fils d'exécution (0: autant que de coeurs)
+    void choisirMoteurComposantes(MoteurComposantes nouveauMoteur, unsigned nbFils = 0);
+
+    MoteurComposantes getMoteurComposantes() const;
+
+    // Trouve les composantes fortement connexes sous forme de numéro de composante par ville (voir Composantes), avec
+    // le moteur Parallele s'il est choisi, Tarjan sinon. Tous les moteurs donnent les mêmes composantes, chacun dans
+    // un ordre topologique inverse qui lui est propre.
+    Composantes composantesFortementConnexes() const;
+
+    // Donne les noms des villes de chaque composante, en ordre topologique inverse des composantes
+    std::vector<std::vector<std::string> > nommerComposantes(const Composantes& composantes) const;
+
+    // Trie les composantes fortement connexes en ordre topologique, par un tri topologique du graphe condensé.
+    // Fonctionne donc aussi sur un réseau cyclique. Chaque sous-vecteur donne les villes d'une composante.
+    std::vector<std::vector<std::string> > triTopologiqueComposantes() const;
+
+    // Choisit nbReperes repères et calcule leurs tables de distances pour le moteur ALT, sur nbFils fils d'exécution
+    // (0: autant que de coeurs). Les repères sont oubliés dès que le réseau change.
+    void preparerReperes(size_t nbReperes = 16, unsigned nbFils = 0);
+
+    // Retourne les repères courants (aucun si preparerReperes ou chargerReperes n'a pas été appelé)
+    const Reperes& getReperes() const;
+
+    // Écrit les repères dans un fichier binaire
+    // Exception logic_error si le fichier ne peut pas être écrit
+    void sauvegarderReperes(const std::string& fichier) const;
+
+    // Relit des repères écrits par sauvegarderReperes
+    // Exception logic_error si le fichier est invalide ou a été calculé pour un autre réseau, ou pour d'autres pondérations
+    void chargerReperes(const std::string& fichier);
+
+    // Construit les hiérarchies de contraction des deux critères (durée et coût) pour le moteur Hierarchie, en parallèle.
+    // Les hiérarchies sont oubliées dès que le réseau change.
+    void preparerHierarchies();
+
+    // Retourne la hiérarchie de la durée (dureeCout = true) ou du coût, vide si elle n'a pas été préparée
+    const HierarchieContraction& getHierarchie(bool dureeCout) const;
+
+    // Retourne une copie des compteurs, durées par phase et histogrammes de latence accumulés par rechercheCheminDijkstra
+    // et algorithmeKosaraju. Le bilan reste vide si le programme n'est pas compilé avec TP2_INSTRUMENTATION.
+    BilanInstrumentation getInstrumentation() const;
+
+    // Remet l'instrumentation à zéro
+    void reinitialiserInstrumentation();
+
 private:
 
 	Graphe unReseau;			//Le type ReseauRoutier est composé d'un graphe
+	mutable GrapheCompact reseauFige;	//Instantané compact de unReseau, sur lequel se font les recherches (voir rafraichir)
+	bool grapheAJour;			// false si unReseau n'a pas été reconstruit depuis le dernier instantané chargé
 	std::string nomReseau;		// Le nom du reseau (exemple: Orleans Express)
+	MoteurRecherche moteur;		// Le moteur de recherche de chemin utilisé
+	MoteurComposantes moteurComposantes;	// Le moteur de recherche des composantes fortement connexes utilisé
+	unsigned nbFilsComposantes;	// Le nombre de fils du moteur Parallele (0: autant que de coeurs)
+	MoteurArbres moteurArbres;	// Le moteur des arbres de chemins utilisé
+	unsigned nbFilsArbres;		// Le nombre de fils du moteur DeltaStepping (0: autant que de coeurs)
+	StatistiquesChargement statistiquesChargement;	// Les statistiques du dernier chargement
+	mutable Instrumentation instrumentation;		// Les statistiques des recherches (si TP2_INSTRUMENTATION)
+	Reperes reperes;			// Les repères du moteur ALT, calculés sur reseauFige
+	HierarchieContraction hierarchies[2];	// Les hiérarchies du moteur Hierarchie (0: durée, 1: coût), calculées sur reseauFige
+	mutable CacheArbres cacheArbres;		// Les arbres de chemins récemment demandés, calculés sur reseauFige
+	mutable CacheResultats cacheResultats;	// Les chemins récemment trouvés, estampillés par la version de reseauFige
+	mutable std::shared_ptr<const IndexAtteignabilite> indexAtteignabilite;	// Construit au besoin sur reseauFige (voir indexer)
+	ComposantesDynamiques composantesSuivies;	// Les composantes tenues à jour par ajouterTrajet et enleverTrajet
+	bool suiviComposantes;		// true si composantesSuivies correspond à unReseau
+	ArbresDynamiques arbresSuivis;	// Les arbres de chemins réparés par ajouterTrajet, enleverTrajet et modifierPonderations
+	bool suiviArbres;			// true si arbresSuivis correspond à unReseau
+
+	/**
+	 * \struct EtatInstantane
+	 * \brief Indique si reseauFige correspond encore à unReseau.  Les modifications le périment; la première recherche
+	 *  suivante le refait sous le verrou (voir rafraichir).  Le verrou protège aussi la construction de l'index
+	 *  d'atteignabilité.  Une copie ne reprend que l'indicateur.
+	 */
+	struct EtatInstantane
+	{
+		std::atomic<bool> aJour{true};
+		std::mutex verrou;
+
+		EtatInstantane() = default;
+		EtatInstantane(const EtatInstantane& autre) : aJour(autre.aJour.load()) {}
+		EtatInstantane& operator=(const EtatInstantane& autre) { aJour = autre.aJour.load(); return *this; }
+	};
+	mutable EtatInstantane etatInstantane;
+
+	/**
+	 * \struct EquipeLots
+	 * \brief Les fils d'exécution des lots (rechercheCheminsLot, sontAtteignables, matriceDistances), créés au premier lot
+	 *  et gardés d'un lot à l'autre: les tableaux de travail thread_local de chaque fil survivent ainsi entre les lots.
+	 *  L'équipe est refaite si un lot demande un autre nombre de fils.  Le verrou ne laisse qu'un lot à la fois sur
+	 *  l'équipe; un lot lancé pendant un autre crée ses propres fils.  Une copie repart sans équipe.
+	 */
+	struct EquipeLots
+	{
+		std::unique_ptr<EquipeFils> equipe;
+		std::mutex verrou;
+
+		EquipeLots();
+		EquipeLots(const EquipeLots&) : EquipeLots() {}
+		EquipeLots& operator=(const EquipeLots&) { return *this; }
+		~EquipeLots();
+	};
+	mutable EquipeLots equipeLots;
 
 	// Vous pouvez définir des constantes ici. À vous de voir!
+	static constexpr size_t AUCUN_SOMMET = std::numeric_limits<size_t>::max();	// Prédécesseur d'un sommet non atteint
 
 	//Vous pouvez ajoutez d'autres méthodes privées si vous sentez leur nécessité
     /**
      * \struct infoDFS
-     * \brief Struct contenant un graphe, un stack de string représentant les sommets abandonnés et un vector de booleen représentant les sommets visités
+     * \brief Struct contenant un graphe compact, un stack de string représentant les sommets abandonnés et un vector de booleen représentant les sommets visités
      */
     using InfoDFS =  struct infoDFS {
-        Graphe graphe ;
+        const GrapheCompact& graphe ;
         std::stack<std::string> abandonnes ;
         std::vector<bool> visites ;
 
-        explicit infoDFS(const Graphe& g) : graphe(g), abandonnes(), visites(g.taille(), false) {}
+        explicit infoDFS(const GrapheCompact& g) : graphe(g), abandonnes(), visites(g.taille(), false) {}
     } ;
 
+    /**
+     * \struct EspaceRecherche
+     * \brief Les tableaux de travail de dijkstraLineaire, dijkstraTas et dijkstraBidirectionnel, gardés par chaque fil d'exécution d'une recherche à l'autre.  Une case
+     *  n'est valide que si son estampille vaut la génération courante: une nouvelle recherche n'incrémente que la
+     *  génération, au lieu de réinitialiser des tableaux en O(V).
+     */
+    struct EspaceRecherche
+    {
+        std::vector<float> ponderations;
+        std::vector<float> bornes;				// borne inférieure de la pondération restante jusqu'à la cible
+        std::vector<size_t> predecesseurs;
+        std::vector<Ponderations> arcsPrecedents;
+        std::vector<std::uint32_t> atteints;	// estampille des sommets atteints par la recherche courante
+        std::vector<std::uint32_t> resolus;		// estampille des sommets résolus par la recherche courante
+        std::vector<std::pair<float, size_t> > tas;
+        std::uint32_t generation = 0;
+
+        // Commence une nouvelle recherche sur un graphe de taille sommets; retourne true si les tableaux ont été agrandis
+        bool preparer(size_t taille);
+
+        bool atteint(size_t sommet) const { return atteints[sommet] == generation; }
+        bool resolu(size_t sommet) const { return resolus[sommet] == generation; }
+    };
+
+    void dijkstraLineaire(size_t source, EspaceRecherche& espace, bool dureeCout, StatistiquesRequete& statistiques) const;
+
+    void dijkstraTas(size_t source, size_t cible, bool guide, EspaceRecherche& espace, bool dureeCout, StatistiquesRequete& statistiques) const;
+
+    void dijkstraBidirectionnel(size_t source, size_t cible, EspaceRecherche& avant, EspaceRecherche& arriere, bool dureeCout, StatistiquesRequete& statistiques) const;
+
+    template <typename Travail>
+    void repartirLot(size_t nbTaches, unsigned nbFils, Travail travail) const;
+
+    void dijkstraCibles(size_t source, const std::vector<bool>& estCible, size_t nbCibles, bool dureeCout, std::vector<float>& ponderations, std::vector<std::pair<float, size_t> >& tas) const;
+
+    std::vector<std::vector<std::string> > kosarajuRecursif();
+
+    void degeler();
+
     size_t localiserSommetMinimal(std::vector<size_t>& nonResolus, std::vector<float>& ponderations) const;
 
-    void relaxer(size_t voisin, size_t courant, std::vector<float>& ponderations, std::vector<std::string>& listeVilles, bool dureeCout) const;
+    bool relaxer(size_t voisin, size_t courant, const Ponderations& arc, std::vector<float>& ponderations, std::vector<size_t>& predecesseurs, std::vector<Ponderations>& arcsPrecedents, bool dureeCout) const;
+
+    std::stack<std::string> explorerGrapheDFS(const GrapheCompact &graphe);
 
     void auxExploreRecursifDFS(InfoDFS& donneesDFS, size_t depart);
 
     std::vector<std::string> transfererPileVersVecteur(std::stack<std::string> &pile);
 
-    std::vector<std::string> construireChemin(const std::string& source, const std::string& destination, std::vector<std::string> predecesseurs, Chemin& cheminTrouve) const;
+    void construireChemin(size_t source, size_t destination, const std::vector<size_t>& predecesseurs, const std::vector<Ponderations>& arcsPrecedents, bool dureeCout, Chemin& cheminTrouve) const;
+
+    void construireCheminHierarchie(const std::vector<size_t>& trajet, bool dureeCout, Chemin& cheminTrouve) const;
+
+    void oublierPretraitements(bool topologie = true);
+
+    void rafraichir() const;
+
+    std::shared_ptr<const IndexAtteignabilite> indexer() const;
+
+    void perimer(bool topologie = true);
+
+    void arreterSuiviComposantes();
+
+    void arreterSuiviArbres();
+
+    size_t chercherVille(const std::string& nom) const;
 
 };
 